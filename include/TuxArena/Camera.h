@@ -0,0 +1,51 @@
+#ifndef TUXARENA_CAMERA_H
+#define TUXARENA_CAMERA_H
+
+#include "SDL2/SDL_rect.h" // For SDL_FRect
+#include "TuxArena/Entity.h" // For Vec2
+
+namespace TuxArena {
+
+// 2D view into the world: the world point at the center of the viewport, a zoom factor
+// and the viewport size in screen pixels. Used by the Renderer to transform world-space
+// draw calls and to cull everything outside the visible area.
+class Camera {
+public:
+    static constexpr float MIN_ZOOM = 0.25f;
+    static constexpr float MAX_ZOOM = 4.0f;
+
+    void setViewport(int width, int height);
+    int getViewportWidth() const { return m_viewportWidth; }
+    int getViewportHeight() const { return m_viewportHeight; }
+
+    void setPosition(const Vec2& center) { m_position = center; }
+    const Vec2& getPosition() const { return m_position; }
+
+    void setZoom(float zoom);
+    float getZoom() const { return m_zoom; }
+
+    // Keeps the view inside [0,worldWidth] x [0,worldHeight]; centers the world if it is smaller than the view
+    void clampToBounds(float worldWidth, float worldHeight);
+
+    Vec2 worldToScreen(const Vec2& world) const;
+    Vec2 screenToWorld(const Vec2& screen) const;
+    SDL_FRect worldToScreen(const SDL_FRect& world) const;
+
+    // World-space rectangle covered by the viewport
+    SDL_FRect getVisibleWorldRect() const;
+
+    // True if the world-space rectangle overlaps the viewport
+    bool isVisible(const SDL_FRect& worldRect) const;
+
+private:
+    Vec2 m_position = {0.0f, 0.0f};
+    float m_zoom = 1.0f;
+    int m_viewportWidth = 0;
+    int m_viewportHeight = 0;
+
+    Vec2 getTopLeft() const;
+};
+
+} // namespace TuxArena
+
+#endif // TUXARENA_CAMERA_H
@@ -2,7 +2,7 @@
 #define TUXARENA_CHARACTER_INFO_H
 
 #include <string>
-#include <SDL2/SDL.h> // For SDL_Texture
+#include "TuxArena/TextureHandle.h"
 
 namespace TuxArena
 {
@@ -11,7 +11,7 @@ namespace TuxArena
         std::string id; // Unique identifier, e.g., "tux", "gnu"
         std::string name; // Display name, e.g., "Tux", "GNU"
         std::string texturePath; // Path to the character's texture file
-        SDL_Texture* texture = nullptr; // Loaded texture
+        TextureHandle texture; // Loaded texture (acquired from the Renderer)
         float health = 100.0f;
         float speed = 200.0f;
         std::string specialAbility = "None"; // Placeholder for ability ID/name
@@ -6,13 +6,12 @@
 #include <map>
 #include <memory> // For std::unique_ptr
 #include <SDL2/SDL.h> // For SDL_Texture
+#include "TuxArena/CharacterInfo.h" // Include the new CharacterInfo struct
 
 namespace TuxArena
 {
     class Renderer; // Forward declaration
 
-    #include "TuxArena/CharacterInfo.h" // Include the new CharacterInfo struct
-
     struct CharacterInfo;
 
 class CharacterManager {
@@ -0,0 +1,64 @@
+#ifndef TUXARENA_COLLISIONGRID_H
+#define TUXARENA_COLLISIONGRID_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "TuxArena/Entity.h" // For Vec2
+
+namespace TuxArena {
+
+// Struct to hold collision shape information
+struct CollisionShape {
+    enum class Type {
+        Rectangle,
+        Ellipse,
+        Polygon,
+        Polyline
+    };
+    Type type;
+    float minX, minY, maxX, maxY; // Bounding box
+    std::vector<Vec2> points; // For polygons/polylines
+
+    // Constructor for convenience
+    CollisionShape(Type t, float x1, float y1, float x2, float y2) :
+        type(t), minX(x1), minY(y1), maxX(x2), maxY(y2) {}
+
+    // Point-in-shape test. Polylines have no interior and match within 'tolerance' of a segment.
+    bool contains(float x, float y, float tolerance = 0.0f) const;
+};
+
+// One byte per tile: non-zero means the tile blocks movement and projectiles.
+// Built by MapManager from "collision" tile layers and collision objects.
+class CollisionGrid {
+public:
+    void reset(unsigned widthTiles, unsigned heightTiles, unsigned tileWidth, unsigned tileHeight);
+    void clear();
+
+    bool isEmpty() const { return m_tiles.empty(); }
+    int getWidth() const { return m_width; }
+    int getHeight() const { return m_height; }
+    unsigned getTileWidth() const { return m_tileWidth; }
+    unsigned getTileHeight() const { return m_tileHeight; }
+
+    // Tiles outside the map are reported as solid so the map edge acts as a wall.
+    bool isSolid(int tileX, int tileY) const {
+        if (tileX < 0 || tileY < 0 || tileX >= m_width || tileY >= m_height) return true;
+        return m_tiles[static_cast<size_t>(tileY) * m_width + tileX] != 0;
+    }
+    bool isSolidAt(float x, float y) const;
+    void setSolid(int tileX, int tileY, bool solid);
+
+    const uint8_t* data() const { return m_tiles.data(); }
+
+private:
+    std::vector<uint8_t> m_tiles;
+    int m_width = 0;
+    int m_height = 0;
+    unsigned m_tileWidth = 0;
+    unsigned m_tileHeight = 0;
+};
+
+} // namespace TuxArena
+
+#endif // TUXARENA_COLLISIONGRID_H
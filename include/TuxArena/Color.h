@@ -0,0 +1,15 @@
+#ifndef TUXARENA_COLOR_H
+#define TUXARENA_COLOR_H
+
+#include <cstdint>
+
+namespace TuxArena {
+
+// RGBA, 8 bits per channel
+struct Color {
+    uint8_t r, g, b, a;
+};
+
+} // namespace TuxArena
+
+#endif // TUXARENA_COLOR_H
@@ -13,9 +13,15 @@ const double CONNECTION_TIMEOUT_SECONDS = 5.0; // 5 seconds timeout for client c
 const int DEFAULT_SERVER_PORT = 12345;
 const int MAX_PLAYERS = 8;
 
+// Map Rotation Constants
+const double ROUND_DURATION_SECONDS = 600.0;  // Length of a round before the server rotates maps
+const double INTERMISSION_SECONDS = 5.0;      // Pause after a map swap so clients can finish loading
+
 // Renderer Constants
 const int DEFAULT_WINDOW_WIDTH = 1024;
 const int DEFAULT_WINDOW_HEIGHT = 768;
+const float MINIMAP_SIZE = 192.0f;              // Screen pixels, longest side
+const double MINIMAP_MARKER_INTERVAL = 0.1;     // Minimap markers follow entities at 10 Hz
 
 // Projectile Constants
 const float BULLET_WIDTH = 8.0f;
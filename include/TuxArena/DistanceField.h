@@ -0,0 +1,96 @@
+#ifndef TUXARENA_DISTANCEFIELD_H
+#define TUXARENA_DISTANCEFIELD_H
+
+#include <cstdint>
+#include <vector>
+#include "TuxArena/Entity.h" // For Vec2
+
+namespace TuxArena {
+
+class CollisionGrid;
+struct CollisionShape;
+
+// Quantized signed distance field of the static map geometry.
+// Distances are in pixels: positive in free space, negative inside walls.
+// Stored at sub-tile resolution as int16 (1/DISTANCE_SCALE pixel units) and
+// clamped to MAX_DISTANCE_TEXELS, so circle queries cost one bilinear fetch.
+class DistanceField {
+public:
+    static constexpr int DEFAULT_TEXELS_PER_TILE = 4;
+    static constexpr int MAX_DISTANCE_TEXELS = 32;
+    static constexpr float DISTANCE_SCALE = 8.0f;
+    static constexpr int DEFAULT_REBUILD_TEXEL_BUDGET = 32768; // Texels transformed per rebuildDirty() call
+
+    /**
+     * @brief Rasterizes the collision grid and collision shapes of the map and computes the field.
+     * @param grid Collision grid of the loaded map; also gives the map size.
+     * @param shapes Collision shapes of the map.
+     * @param texelsPerTile Sub-tile resolution (texels along the shorter tile edge).
+     * @return True if a field was built.
+     */
+    bool build(const CollisionGrid& grid, const std::vector<CollisionShape>& shapes,
+               int texelsPerTile = DEFAULT_TEXELS_PER_TILE);
+    void clear();
+
+    bool isBuilt() const { return !m_distances.empty(); }
+    float getTexelSize() const { return m_texelSize; }
+
+    // Bilinearly filtered distance in pixels. Points outside the map are inside the wall.
+    float sampleDistance(float x, float y) const;
+
+    // Unit direction of increasing distance (the wall normal near a surface), or {0,0} in flat regions.
+    Vec2 sampleGradient(float x, float y) const;
+
+    // Distance and gradient from the same four texels. Returns false if the field is not built.
+    bool sample(float x, float y, float* outDistance, Vec2* outGradient) const;
+
+    /**
+     * @brief Pushes a circle out of the geometry along the field gradient.
+     * Only the penetrating component is removed, so movement along a wall slides.
+     * @param center Circle center, adjusted in place.
+     * @param radius Circle radius in pixels.
+     * @return True if the circle was touching the geometry.
+     */
+    bool resolveCircle(Vec2& center, float radius, int maxIterations = 3) const;
+
+    // True if a circle of the given radius fits at the position (bot clearance checks).
+    bool hasClearance(float x, float y, float radius) const { return sampleDistance(x, y) >= radius; }
+
+    /**
+     * @brief Re-rasterizes the texels covering a pixel rectangle after the map changed and
+     * queues them for rebuildDirty(). Distances stay stale until then.
+     */
+    void invalidateRegion(const CollisionGrid& grid, const std::vector<CollisionShape>& shapes,
+                          float minX, float minY, float maxX, float maxY);
+
+    /**
+     * @brief Recomputes queued regions until roughly 'texelBudget' texels were transformed.
+     * At least one region is processed per call so edits never starve.
+     * @return Number of texels transformed.
+     */
+    int rebuildDirty(int texelBudget = DEFAULT_REBUILD_TEXEL_BUDGET);
+    bool hasDirtyRegions() const { return !m_dirtyRegions.empty(); }
+
+private:
+    int m_width = 0;  // Texels, including the one-texel solid border
+    int m_height = 0;
+    float m_texelSize = 0.0f;
+    float m_invTexelSize = 0.0f;
+
+    std::vector<uint8_t> m_occupancy;  // 1 = solid texel
+    std::vector<int16_t> m_distances;  // Quantized signed distance per texel
+
+    // Texel rectangle [x0,x1) x [y0,y1) awaiting computeRegion()
+    struct DirtyRegion {
+        int x0, y0, x1, y1;
+    };
+    std::vector<DirtyRegion> m_dirtyRegions;
+
+    void rasterize(const CollisionGrid& grid, const std::vector<CollisionShape>& shapes, int x0, int y0, int x1, int y1);
+    void computeRegion(int x0, int y0, int x1, int y1);
+    int regionCost(const DirtyRegion& region) const;
+};
+
+} // namespace TuxArena
+
+#endif // TUXARENA_DISTANCEFIELD_H
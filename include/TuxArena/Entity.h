@@ -35,6 +35,8 @@ class NetworkClient;
 class NetworkServer;
 class ModManager;
 class ParticleManager;
+class Profiler;
+class Camera;
 // class PhysicsWorld; // If using a dedicated physics engine
 // class BitStream; // Forward declare bitstream class if used for networking
 
@@ -67,6 +69,8 @@ enum class EntityType {
         NetworkServer* networkServer;
         ParticleManager* particleManager;
         Renderer* renderer;
+        Profiler* profiler = nullptr; // Stage timings for the perf overlay, null on the server
+        const Camera* camera = nullptr; // View the mouse cursor is in, null on the server
         std::string playerTexturePath;
         std::string playerCharacterId;
     };
@@ -23,6 +23,7 @@ public:
 
     bool initialize(MapManager* mapManager);
     void shutdown();
+    void setMapManager(MapManager* mapManager) { m_mapManager = mapManager; } // Rebinds after a map swap
 
     Entity* createEntity(EntityType type,
                          const Vec2& position,
@@ -38,7 +39,7 @@ public:
 
     void update(const EntityContext& context);
     void render(Renderer& renderer);
-    void renderDebug(Renderer& renderer); // For debugging purposes
+    void renderDebug(Renderer& renderer); // Entity and particle counts for the perf overlay (ImGui)
 
     std::vector<Entity*> getActiveEntities() const;
     void clearAllEntities();
@@ -0,0 +1,51 @@
+#ifndef TUXARENA_FOGOFWAR_H
+#define TUXARENA_FOGOFWAR_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "TuxArena/Entity.h" // For Vec2
+
+namespace TuxArena {
+
+class CollisionGrid;
+
+// Tile visibility around the local player for the fog-of-war mode. Solid tiles of the collision
+// grid block sight; the walls bounding the visible area are themselves visible.
+// Uses recursive shadowcasting over the eight octants, and only recomputes when the player enters
+// another tile, the grid is a different map or tile edits were applied (editCount changed), so a
+// player standing still costs nothing.
+class FogOfWar {
+public:
+    static constexpr int DEFAULT_RADIUS = 16; // Tiles
+
+    void setRadius(int radiusTiles);
+    void invalidate() { m_grid = nullptr; } // Forces a recompute on the next update()
+
+    // Returns true when the mask was recomputed
+    bool update(const CollisionGrid& grid, const Vec2& position, size_t editCount);
+
+    // One byte per tile, row-major, non-zero where visible
+    const std::vector<uint8_t>& getMask() const { return m_mask; }
+    int getWidth() const { return m_width; }
+    int getHeight() const { return m_height; }
+    uint32_t getRevision() const { return m_revision; } // Changes with every recompute, 0 = never computed
+    bool isVisible(int tileX, int tileY) const;
+
+private:
+    const CollisionGrid* m_grid = nullptr;
+    int m_radius = DEFAULT_RADIUS;
+    int m_width = 0;
+    int m_height = 0;
+    int m_originX = -1; // Tile the mask was computed from
+    int m_originY = -1;
+    size_t m_editCount = 0;
+    uint32_t m_revision = 0;
+    std::vector<uint8_t> m_mask;
+
+    void castOctant(int row, float startSlope, float endSlope, int xx, int xy, int yx, int yy);
+};
+
+} // namespace TuxArena
+
+#endif // TUXARENA_FOGOFWAR_H
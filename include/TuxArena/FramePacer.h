@@ -0,0 +1,73 @@
+#ifndef TUXARENA_FRAMEPACER_H
+#define TUXARENA_FRAMEPACER_H
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+
+namespace TuxArena {
+
+// Frame timing over the last FramePacer::STATS_WINDOW frames, in milliseconds
+struct FrameStats {
+    double meanFrameMs = 0.0;
+    double stdDevFrameMs = 0.0; // Pacing jitter
+    double maxFrameMs = 0.0;
+    double workMs = 0.0;        // Input + update + frame recording, averaged
+    double inputLatencyMs = 0.0; // Input sampling to frame submission, averaged
+    size_t frameCount = 0;       // Frames in the window
+};
+
+/**
+ * @brief Caps the client loop at a target rate and schedules each frame's start.
+ *
+ * waitForFrameStart() sleeps until the next frame should begin: the OS sleep (nanosleep on Linux)
+ * covers most of the wait and a short spin covers the rest, with the spin length adapted to the
+ * measured oversleep. With late input sampling the start is pushed back by the predicted work time,
+ * so input is polled as close as possible to the frame's deadline instead of right after the
+ * previous one. Without a target rate (uncapped) the pacer only measures.
+ */
+class FramePacer {
+public:
+    using Clock = std::chrono::steady_clock;
+    static constexpr size_t STATS_WINDOW = 120;
+
+    void setTargetFps(double fps); // <= 0 disables the cap
+    double getTargetFps() const { return m_targetFps; }
+    void setLateInputSampling(bool enabled) { m_lateInputSampling = enabled; }
+    bool isLateInputSampling() const { return m_lateInputSampling; }
+
+    void waitForFrameStart(); // Call before polling input
+    void endFrame();          // Call once the frame is submitted
+
+    const FrameStats& getStats() const { return m_stats; }
+    double getLastWorkMs() const { return m_lastWorkMs; } // Unsmoothed, for per-frame load control
+
+private:
+    double m_targetFps = 0.0;
+    Clock::duration m_interval = Clock::duration::zero();
+    bool m_lateInputSampling = true;
+
+    Clock::time_point m_deadline;     // When the current frame should be submitted
+    Clock::time_point m_frameStart;   // Input sampling time of the current frame
+    Clock::time_point m_lastFrameEnd;
+    bool m_started = false;
+
+    double m_lastWorkMs = 0.0;
+    double m_smoothedWorkMs = 0.0;
+    double m_predictedWorkMs = 0.0;   // Smoothed work time with headroom for spikes
+    double m_spinMs = 1.0;            // Spin-wait before deadlines, follows measured oversleep
+
+    std::array<double, STATS_WINDOW> m_frameTimes{};
+    std::array<double, STATS_WINDOW> m_workTimes{};
+    std::array<double, STATS_WINDOW> m_latencies{};
+    size_t m_sampleCount = 0;
+    size_t m_nextSample = 0;
+    FrameStats m_stats;
+
+    void sleepUntil(Clock::time_point wakeTime);
+    void updateStats();
+};
+
+} // namespace TuxArena
+
+#endif // TUXARENA_FRAMEPACER_H
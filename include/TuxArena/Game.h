@@ -7,6 +7,12 @@
 #include <SDL2/SDL_stdinc.h> // For Uint64
 #include "TuxArena/Constants.h"
 #include "TuxArena/Entity.h" // Include Entity.h for EntityContext definition
+#include "TuxArena/Camera.h"
+#include "TuxArena/FogOfWar.h"
+#include "TuxArena/FramePacer.h"
+#include "TuxArena/PerfOverlay.h"
+#include "TuxArena/Profiler.h"
+#include "TuxArena/SpriteBatch.h" // For PointSprite
 #include "TuxArena/CharacterManager.h"
 #include "TuxArena/UIManager.h" // Include UIManager header
 
@@ -22,6 +28,9 @@ namespace TuxArena {
     class NetworkServer;
     class EntityManager;
     class MapManager;
+    class MapRotation;
+    class RenderThread;
+    struct RenderSnapshot;
     class ModManager;
     class CharacterManager;
     class UIManager; // Forward declaration for UIManager
@@ -43,6 +52,20 @@ struct AppConfig {
     int windowWidth = DEFAULT_WINDOW_WIDTH;
     int windowHeight = DEFAULT_WINDOW_HEIGHT;
     bool vsyncEnabled = true;
+    // Draw on a dedicated thread, one frame behind the simulation. SDL's render API is only supported
+    // on the main thread; X11/Wayland GL contexts tolerate a context owned by another thread, while
+    // Windows (D3D) and macOS (Cocoa/Metal) do not, so elsewhere it is opt-in (--render-thread).
+#ifdef __linux__
+    bool renderThreadEnabled = true;
+#else
+    bool renderThreadEnabled = false;
+#endif
+    int targetFps = 0;               // Client frame cap while playing: 0 = display refresh rate, < 0 = uncapped
+    int menuFps = 30;                // Client frame cap outside gameplay
+    bool lateInputSampling = true;   // Start frames as late as the predicted work allows, to cut input latency
+    bool fogOfWar = false;           // Only reveal tiles the local player can see
+    int textureBudgetMB = 256;       // Texture cache ceiling; unreferenced textures are evicted past it
+    uint64_t randomSeed = 0;         // Simulation random seed, 0 = picked from the clock at startup
     int serverMaxPlayers = MAX_PLAYERS;
     std::string playerName = "Player"; // Default player name
     std::string playerTexturePath = ""; // Path to selected character texture
@@ -110,14 +133,32 @@ namespace TuxArena {
         std::unique_ptr<CharacterManager> m_characterManager;
         std::unique_ptr<WeaponManager> m_weaponManager;
     std::unique_ptr<AssetManager> m_assetManager;
+    std::unique_ptr<MapRotation> m_mapRotation; // Background map preloading (server rotation, client prefetch)
         std::unique_ptr<UIManager> m_uiManager; // New UIManager member
+    std::unique_ptr<RenderThread> m_renderThread; // Null when drawing on the main thread
+    std::unique_ptr<RenderSnapshot> m_renderSnapshot; // Frame recording used without a render thread
 
 
     // --- Timing ---
     Uint64 m_lastFrameTime = 0;     // Performance counter timestamp of the previous frame
     Uint64 m_perfFrequency = 0;     // Performance counter frequency
+    FramePacer m_framePacer;        // Client frame cap and timing statistics
+    double m_playingFps = 0.0;      // Resolved AppConfig::targetFps
+    Profiler m_profiler;            // Client stage timings
+    PerfOverlay m_perfOverlay;      // Toggled with F3
     double m_connectionAttemptTime = 0.0; // Time when client connection was initiated
 
+    // --- Rounds (Server) ---
+    double m_roundTimeRemaining = ROUND_DURATION_SECONDS;
+    double m_intermissionTimeRemaining = 0.0; // > 0 while between rounds
+
+    // --- View (Client) ---
+    Camera m_camera; // Follows the local player; world draws are transformed and culled through it
+    bool m_mapPrebakePending = false; // Map changed; chunks are baked with the next recorded frame
+    FogOfWar m_fogOfWar;              // Used with AppConfig::fogOfWar
+    std::vector<PointSprite> m_minimapMarkers; // Players and pickups, world space
+    double m_minimapMarkerTime = -1.0;         // When the markers were last gathered, seconds
+
     // Entity Context (passed to entities during update)
     EntityContext m_currentContext; // Added missing member
 
@@ -126,6 +167,8 @@ namespace TuxArena {
     void update(double deltaTime);
     void render();
     void renderNonPlayingState();
+    void updateCamera();
+    void updateMinimapMarkers();
     void networkUpdateReceive(double currentTime);
     void networkUpdateSend(double currentTime, double& lastSendTime);
     void updateGameState();
@@ -137,6 +180,13 @@ namespace TuxArena {
     void connectToServer();
     void findAvailableMaps();
 
+    // Map Rotation
+    bool changeMap(const std::string& mapPath); // Publishes a loaded map and rebinds dependent systems
+    void updateMapRotation(double deltaTime);
+    void startRound();
+    void configureNetworkClient(); // Call after creating m_networkClient
+    std::string resolveMapPath(const std::string& mapName) const;
+
     // UI State
     char m_serverIpBuffer[256];
     std::vector<std::string> m_availableMaps;
@@ -0,0 +1,64 @@
+#ifndef TUXARENA_GLYPHCACHE_H
+#define TUXARENA_GLYPHCACHE_H
+
+#include <SDL2/SDL.h>
+#include <SDL2/SDL_ttf.h>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace TuxArena {
+
+// Glyph atlas for one (font, size). Glyphs are rasterized white on first use into PAGE_SIZE texture
+// pages and tinted per draw through vertex colors. Laid out strings are cached, so drawing the same
+// HUD text again costs a hash lookup plus a few batched quads instead of a TTF render and texture upload.
+// At most MAX_PAGES pages are allocated; glyphs that do not fit after that are skipped.
+class GlyphCache {
+public:
+    static constexpr int PAGE_SIZE = 512;
+    static constexpr size_t MAX_PAGES = 4; // 4 MiB; only very large sizes need more than one
+    static constexpr size_t MAX_CACHED_LAYOUTS = 256; // The layout cache is reset when it grows past this
+
+    struct Glyph {
+        SDL_Texture* page = nullptr;
+        SDL_Rect rect = {0, 0, 0, 0}; // Line-height tall glyph image inside the page
+        int advance = 0;
+    };
+
+    // One glyph quad of a laid out string, relative to the text origin (top-left)
+    struct Quad {
+        SDL_Texture* page;
+        SDL_Rect srcRect;
+        SDL_FRect dstRect;
+    };
+
+    GlyphCache(SDL_Renderer* renderer, TTF_Font* font);
+    ~GlyphCache();
+    GlyphCache(const GlyphCache&) = delete;
+    GlyphCache& operator=(const GlyphCache&) = delete;
+
+    const Glyph* getGlyph(Uint16 character);
+    const std::vector<Quad>& layout(const std::string& text);
+
+    size_t getPageCount() const { return m_pages.size(); }
+
+private:
+    SDL_Renderer* m_renderer;
+    TTF_Font* m_font; // Owned by the Renderer's font cache
+
+    std::vector<SDL_Texture*> m_pages;
+    int m_shelfX = 0;      // Next free position on the current shelf of the last page
+    int m_shelfY = 0;
+    int m_shelfHeight = 0;
+    bool m_full = false;   // MAX_PAGES reached, warned once
+
+    std::unordered_map<Uint16, Glyph> m_glyphs;
+    std::unordered_map<std::string, std::vector<Quad>> m_layouts;
+
+    bool addPage();
+    bool rasterize(Uint16 character, Glyph& glyph);
+};
+
+} // namespace TuxArena
+
+#endif // TUXARENA_GLYPHCACHE_H
@@ -5,6 +5,9 @@
 #include <iostream>
 #include <chrono>
 #include <iomanip>
+#include <ctime>
+#include <mutex>
+#include <sstream>
 
 // Define this to 0 to disable INFO logs
 #define LOG_INFO_ENABLED 1
@@ -43,24 +46,37 @@ public:
     }
 
 private:
+    // Logging happens from the main thread, the map preload thread and the render thread: each line
+    // is formatted first and written under the lock, so lines never interleave
     static void log(Level level, const std::string& message) {
         auto now = std::chrono::system_clock::now();
         auto in_time_t = std::chrono::system_clock::to_time_t(now);
+        std::tm localTime{};
+#ifdef _WIN32
+        localtime_s(&localTime, &in_time_t);
+#else
+        localtime_r(&in_time_t, &localTime); // std::localtime returns a shared static buffer
+#endif
 
-        std::cout << "[" << std::put_time(std::localtime(&in_time_t), "%Y-%m-%d %H:%M:%S") << "] ";
+        std::ostringstream line;
+        line << "[" << std::put_time(&localTime, "%Y-%m-%d %H:%M:%S") << "] ";
 
         switch (level) {
             case Level::INFO:
-                std::cout << "[INFO] ";
+                line << "[INFO] ";
                 break;
             case Level::WARNING:
-                std::cout << "[WARNING] ";
+                line << "[WARNING] ";
                 break;
             case Level::ERROR:
-                std::cout << "[ERROR] ";
+                line << "[ERROR] ";
                 break;
         }
-        std::cout << message << std::endl;
+        line << message << '\n';
+
+        static std::mutex mutex;
+        std::lock_guard<std::mutex> lock(mutex);
+        std::cout << line.str() << std::flush;
     }
 };
 
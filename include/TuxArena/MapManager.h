@@ -11,6 +11,9 @@
 #include "tmxlite/LayerGroup.hpp"
 #include "SDL2/SDL_rect.h" // For SDL_Rect
 #include "TuxArena/Entity.h" // For Vec2
+#include "TuxArena/CollisionGrid.h"
+#include "TuxArena/DistanceField.h"
+#include "TuxArena/Raycaster.h"
 
 namespace TuxArena {
 
@@ -35,23 +38,6 @@ struct TilesetInfo {
     std::string imagePath; // Absolute path to the tileset image
 };
 
-// Struct to hold collision shape information
-struct CollisionShape {
-    enum class Type {
-        Rectangle,
-        Ellipse,
-        Polygon,
-        Polyline
-    };
-    Type type;
-    float minX, minY, maxX, maxY; // Bounding box
-    std::vector<Vec2> points; // For polygons/polylines
-
-    // Constructor for convenience
-    CollisionShape(Type t, float x1, float y1, float x2, float y2) :
-        type(t), minX(x1), minY(y1), maxX(x2), maxY(y2) {}
-};
-
 // Struct to hold spawn point information
 struct SpawnPoint {
     float x, y;
@@ -59,6 +45,16 @@ struct SpawnPoint {
     std::string type;
 };
 
+// A single tile change (e.g. a wall being destroyed). Recorded by MapManager and
+// replicated to clients as TILE_DELTA messages.
+struct TileEdit {
+    uint16_t tileX = 0;
+    uint16_t tileY = 0;
+    uint16_t layer = 0; // Index into MapManager::getRawLayers()
+    uint8_t solid = 0;  // New collision state of the tile
+    uint32_t gid = 0;   // New tile GID on that layer, 0 clears it
+};
+
 class MapManager {
 public:
     MapManager();
@@ -80,11 +76,39 @@ public:
     // Accessors for map data (for rendering and collision)
     const std::vector<tmx::Layer::Ptr>& getRawLayers() const;
     const TilesetInfo* findTilesetForGid(unsigned gid) const;
+    const std::map<unsigned, TilesetInfo>& getTilesets() const { return m_tilesets; } // Keyed by first GID
     SDL_Rect getSourceRectForGid(unsigned gid, const TilesetInfo& tilesetInfo) const;
 
     const std::vector<CollisionShape>& getCollisionShapes() const { return m_collisionShapes; }
     const std::vector<SpawnPoint>& getSpawnPoints() const { return m_spawnPoints; }
 
+    // Derived collision data, rebuilt on every load
+    const CollisionGrid& getCollisionGrid() const { return m_collisionGrid; }
+    const DistanceField& getDistanceField() const { return m_distanceField; }
+    const Raycaster& getRaycaster() const { return m_raycaster; }
+
+    // --- Tile Editing (destructible tiles) ---
+    // Tile GID of a top-level tile layer, including edits. 0 means empty.
+    uint32_t getTileGid(size_t layerIndex, unsigned tileX, unsigned tileY) const;
+    const std::vector<std::vector<uint32_t>>& getTileGidLayers() const { return m_tileGids; } // Indexed like getRawLayers()
+
+    /**
+     * @brief Applies and records a tile edit. The tile GID, collision bitmap and ray super-tiles
+     * update immediately; the distance field region is queued for updateDerivedData().
+     * @return False if the edit is out of range.
+     */
+    bool applyTileEdit(const TileEdit& edit);
+
+    // Clears the tile on the first "destructible" layer at the position. Returns true if one was removed.
+    bool breakTile(int tileX, int tileY);
+    bool isDestructible(int tileX, int tileY) const;
+
+    // Every edit since the map was loaded. Consumers (network replication, caches) keep their own cursor.
+    const std::vector<TileEdit>& getTileEdits() const { return m_tileEdits; }
+
+    // Incrementally rebuilds data invalidated by tile edits, bounded per call. Call once per tick.
+    void updateDerivedData(int texelBudget = DistanceField::DEFAULT_REBUILD_TEXEL_BUDGET);
+
 private:
     bool m_isMapLoaded = false;
     std::string m_mapName;
@@ -103,6 +127,16 @@ private:
     std::vector<CollisionShape> m_collisionShapes;
     std::vector<SpawnPoint> m_spawnPoints;
 
+    CollisionGrid m_collisionGrid;
+    DistanceField m_distanceField;
+    Raycaster m_raycaster; // Holds a pointer to m_collisionGrid
+
+    // Editable copy of the top-level tile layer GIDs (same indexing as getRawLayers(), empty for other layers)
+    std::vector<std::vector<uint32_t>> m_tileGids;
+    std::vector<size_t> m_destructibleLayers;
+    std::vector<uint8_t> m_staticSolid; // Collision from non-destructible sources, restored when a tile breaks
+    std::vector<TileEdit> m_tileEdits;
+
     // Fallback map data
     bool m_useFallbackMap = false;
     void createFallbackMap();
@@ -110,6 +144,9 @@ private:
     // Helper to process layers recursively
     void processLayer(const tmx::Layer& layer);
     void processObjectLayer(const tmx::ObjectGroup& group);
+    void buildCollisionData();
+    void markCollisionTiles(const tmx::Layer& layer);
+    void buildTileLayers();
 };
 
 } // namespace TuxArena
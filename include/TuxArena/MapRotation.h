@@ -0,0 +1,73 @@
+#ifndef TUXARENA_MAPROTATION_H
+#define TUXARENA_MAPROTATION_H
+
+#include <future>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace TuxArena {
+
+class MapManager;
+
+// Ordered list of maps played by a server, with a background loader so the next map is
+// parsed (and its collision data built) while the current round is still running.
+// Loaded maps are handed over as a whole MapManager, so switching is a single pointer swap.
+// Clients use the same loader to prefetch the map announced by NEXT_MAP_HINT.
+class MapRotation {
+public:
+    MapRotation() = default;
+    ~MapRotation();
+
+    MapRotation(const MapRotation&) = delete;
+    MapRotation& operator=(const MapRotation&) = delete;
+
+    void setMaps(const std::vector<std::string>& mapPaths);
+    const std::vector<std::string>& getMaps() const { return m_maps; }
+    bool isEmpty() const { return m_maps.empty(); }
+
+    // Map currently being played (adds it to the rotation if it is not listed)
+    void setCurrentMap(const std::string& mapPath);
+    std::string getCurrentMap() const;
+    std::string getNextMap() const;
+    void advance();
+
+    /**
+     * @brief Starts loading a map on a background thread. Does nothing if that map is
+     * already pending, and waits out (then discards) a different pending load.
+     */
+    void preload(const std::string& mapPath);
+    void preloadNext() { preload(getNextMap()); }
+
+    bool isPreloading() const { return m_pending.valid(); }
+    bool isPreloadReady() const;
+    const std::string& getPreloadingMap() const { return m_pendingPath; }
+
+    /**
+     * @brief Takes ownership of a loaded map. Uses the preloaded map if it matches (waiting
+     * for it if it is still loading), otherwise loads synchronously.
+     * @return The loaded map, or nullptr if loading failed.
+     */
+    std::unique_ptr<MapManager> acquire(const std::string& mapPath);
+
+    // Hands over a map that is no longer in use. It is destroyed on the next loader thread
+    // instead of stalling the frame that swaps maps.
+    void retire(std::unique_ptr<MapManager> map);
+
+    // Waits for any pending load and discards it
+    void cancel();
+
+private:
+    std::vector<std::string> m_maps;
+    size_t m_currentIndex = 0;
+
+    std::string m_pendingPath;
+    std::future<std::unique_ptr<MapManager>> m_pending;
+    std::unique_ptr<MapManager> m_retired;
+
+    static std::unique_ptr<MapManager> loadMap(const std::string& mapPath);
+};
+
+} // namespace TuxArena
+
+#endif // TUXARENA_MAPROTATION_H
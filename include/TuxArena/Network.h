@@ -9,13 +9,23 @@ namespace Network {
 
 // Protocol Constants
 const uint32_t PROTOCOL_ID = 0x54584101; // 'TXA' + 0x01 (TuxArena Protocol ID)
-const uint16_t PROTOCOL_VERSION = 1;     // Current protocol version
+const uint16_t PROTOCOL_VERSION = 2;     // Current protocol version (2: acknowledged TILE_DELTA)
 
 // Network Configuration
 const int MAX_PACKET_SIZE = 512; // Maximum size of a UDP packet in bytes
 const double CONNECTION_TIMEOUT = 5.0; // Seconds before a connection is considered timed out
 const double CLIENT_CONNECT_RETRY_INTERVAL = 1.0; // Seconds between connection request retries
 
+// TILE_DELTA layout: [MessageType, uint16 map serial, uint32 first edit index, uint16 count,
+//                     count x (uint16 x, uint16 y, uint16 layer, uint8 solid, uint32 gid)]
+// Edits are numbered from 0 per map; the serial changes with every map change. Clients answer with
+// TILE_ACK [MessageType, uint16 map serial, uint32 edits applied], also every TILE_RESEND_INTERVAL,
+// and the server resends everything past the acknowledged count until it is acknowledged.
+const int TILE_DELTA_HEADER_SIZE = 1 + 2 + 4 + 2;
+const int TILE_DELTA_EDIT_SIZE = 2 + 2 + 2 + 1 + 4;
+const int TILE_ACK_SIZE = 1 + 2 + 4;
+const double TILE_RESEND_INTERVAL = 0.25; // Seconds
+
 // Message Types (from client to server and server to client)
 enum class MessageType : uint8_t {
     // Connection Management
@@ -31,9 +41,12 @@ enum class MessageType : uint8_t {
     SPAWN_ENTITY = 11,    // Server tells client to spawn an entity
     DESTROY_ENTITY = 12,   // Server tells client to destroy an entity
     SET_MAP = 13,         // Server tells client to load a specific map
+    NEXT_MAP_HINT = 14,   // Server announces the next map in the rotation so clients can preload it
+    TILE_DELTA = 15,      // Batch of tile edits (destroyed walls etc.)
 
     // Client Input (Client to Server)
     INPUT = 20,           // Client sends input state
+    TILE_ACK = 21,        // Number of tile edits the client has applied (see TILE_DELTA)
 
     // Chat/Messaging
     CHAT_MESSAGE = 30,    // Text chat message
@@ -2,7 +2,9 @@
 #define TUXARENA_NETWORKCLIENT_H
 
 #include <string>
+#include <array>
 #include <cstdint>
+#include <functional> // For std::function
 #include <SDL2/SDL_net.h>
 
 namespace TuxArena {
@@ -12,6 +14,7 @@ class EntityManager;
 class InputManager;
 class MapManager;
 class ModManager;
+class MapRotation;
 
 enum class ConnectionState {
     DISCONNECTED,
@@ -23,8 +26,19 @@ enum class ConnectionState {
     DISCONNECTING
 };
 
+// Connection quality as seen by the client, measured with its own pings
+struct NetworkStats {
+    double rttMs = 0.0;       // Smoothed round trip of answered pings
+    double lossPercent = 0.0; // Unanswered pings among the last NetworkClient::PING_WINDOW
+    double receiveKBps = 0.0; // Over the last second
+    double sendKBps = 0.0;
+};
+
 class NetworkClient {
 public:
+    static constexpr double PING_INTERVAL = 0.5; // Seconds
+    static constexpr size_t PING_WINDOW = 16;
+
     NetworkClient();
     ~NetworkClient();
 
@@ -42,6 +56,13 @@ public:
     ConnectionState getConnectionState() const { return m_connectionState; }
     std::string getStatusString() const;
     bool isConnected() const;
+    const NetworkStats& getNetworkStats() const { return m_stats; }
+
+    // Map rotation support. The rotation prefetches maps announced by NEXT_MAP_HINT; the
+    // change handler is called on SET_MAP to publish the new map (falls back to loadMap if unset).
+    void setMapManager(MapManager* mapManager) { m_mapManager = mapManager; }
+    void setMapRotation(MapRotation* mapRotation) { m_mapRotation = mapRotation; }
+    void setMapChangeHandler(std::function<bool(const std::string&)> handler) { m_mapChangeHandler = std::move(handler); }
 
 private:
     bool m_isInitialized = false;
@@ -52,6 +73,8 @@ private:
     // Pointers to game systems (not owned by NetworkClient)
     EntityManager* m_entityManager = nullptr;
         MapManager* m_mapManager = nullptr;
+    MapRotation* m_mapRotation = nullptr;
+    std::function<bool(const std::string&)> m_mapChangeHandler;
 
     // Network specific members
     UDPsocket m_clientSocket = nullptr;
@@ -62,6 +85,25 @@ private:
     double m_lastServerPacketTime = 0.0;
     uint32_t m_inputSequenceNumber = 0;
 
+    // Tile edits of the current map applied so far, acknowledged with TILE_ACK (see Network.h)
+    uint16_t m_tileMapSerial = 0; // 0 until the first TILE_DELTA
+    uint32_t m_tileEditsApplied = 0;
+    double m_lastTileAckTime = 0.0;
+
+    // Ping slots indexed by sequence % PING_WINDOW; the server echoes PING back as PONG
+    struct PingSlot {
+        uint32_t sequence = 0;
+        double sentTime = 0.0; // 0 = unused
+        bool answered = false;
+    };
+    std::array<PingSlot, PING_WINDOW> m_pings{};
+    uint32_t m_nextPingSequence = 0;
+    double m_lastPingTime = 0.0;
+    size_t m_bytesReceived = 0; // Since m_bandwidthWindowStart
+    size_t m_bytesSent = 0;
+    double m_bandwidthWindowStart = 0.0;
+    NetworkStats m_stats;
+
     // Private helper methods
     void handlePacket(UDPpacket* packet);
     void handleWelcome(UDPpacket* packet);
@@ -70,9 +112,15 @@ private:
     void handleSpawnEntity(UDPpacket* packet);
     void handleDestroyEntity(UDPpacket* packet);
     void handlePing(UDPpacket* packet);
+    void handlePong(UDPpacket* packet);
     void handleSetMap(UDPpacket* packet);
+    void handleNextMapHint(UDPpacket* packet);
+    void handleTileDelta(UDPpacket* packet);
+    void sendTileAck(double currentTime);
+    std::string readMapName(UDPpacket* packet) const;
     void applyStateSnapshot(const uint8_t* buffer, int length, double serverTimestamp);
     bool sendPacketToServer(const uint8_t* data, int len);
+    void updateNetworkStats(double currentTime);
 };
 
 } // namespace TuxArena
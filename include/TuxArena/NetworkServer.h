@@ -10,6 +10,8 @@
 #include <functional> // For std::hash
 #include <unordered_map> // For std::unordered_map
 #include <SDL2/SDL_net.h> // Include SDL_net.h for UDPsocket and IPaddress definitions
+#include "TuxArena/Entity.h" // For Vec2
+#include "TuxArena/Network.h" // For Network::MessageType
 
 namespace TuxArena {
 
@@ -25,6 +27,9 @@ struct ClientInfo {
     double lastPacketTime = 0.0; // For timeout checks
     uint32_t lastInputSequence = 0;
     Entity* playerEntity = nullptr; // Pointer to the player entity controlled by this client
+    size_t tileEditsAcked = 0;      // Tile edits of the current map the client confirmed
+    size_t tileEditsSent = 0;       // Tile edits sent at least once
+    double lastTileEditSendTime = 0.0; // Last send starting at tileEditsAcked, for the resend interval
 };
 
 class NetworkServer {
@@ -42,6 +47,11 @@ public:
 
     const std::map<uint32_t, ClientInfo>& getClients() const { return m_clients; }
 
+    // Map rotation: publishes a new map to all clients and respawns their players on it
+    void changeMap(MapManager* mapManager);
+    // Tells clients which map comes next so they can load it in the background
+    void setNextMapHint(const std::string& mapName);
+
     private:
     bool m_isInitialized = false;
     UDPsocket m_serverSocket = nullptr;
@@ -55,7 +65,10 @@ public:
     // Pointers to game systems (not owned by NetworkServer)
     EntityManager* m_entityManager = nullptr;
     MapManager* m_mapManager = nullptr;
-    
+
+    std::string m_nextMapName; // Announced to clients via NEXT_MAP_HINT
+    size_t m_nextSpawnIndex = 0;
+    uint16_t m_mapSerial = 1; // Tags TILE_DELTA/TILE_ACK with the map they belong to; never 0
 
     // Custom hash and equality for IPaddress to use as map key
     struct AddressHasher {
@@ -75,9 +88,15 @@ public:
     void handleClientInput(UDPpacket* packet, ClientInfo& client);
     void handleClientDisconnect(UDPpacket* packet, ClientInfo& client);
     void handleClientPong(UDPpacket* packet, ClientInfo& client);
+    void handleClientPing(UDPpacket* packet, ClientInfo& client);
+    void handleTileAck(UDPpacket* packet, ClientInfo& client);
 
     bool sendPacket(const IPaddress& dest, const uint8_t* data, int len);
     void broadcastPacket(const uint8_t* data, int len, const IPaddress* excludeClientAddress = nullptr);
+    void sendMapMessage(const IPaddress& dest, Network::MessageType type, const std::string& mapName);
+    void sendSpawnEntity(const IPaddress& dest, Entity* entity);
+    void sendTileEdits(const IPaddress& dest, size_t first, size_t last);
+    Vec2 pickSpawnPosition();
 
     ClientInfo* findOrAddClient(const IPaddress& address);
     void removeClient(uint32_t clientId);
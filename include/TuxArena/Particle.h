@@ -1,30 +1,129 @@
 #ifndef TUXARENA_PARTICLE_H
 #define TUXARENA_PARTICLE_H
 
-#include "TuxArena/Entity.h" // For Vec2 and Color
-#include "TuxArena/Renderer.h"
-#include <glm/glm.hpp>
+#include "TuxArena/Color.h"
+#include "TuxArena/ParticleKernels.h"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
 
 namespace TuxArena
 {
 
-    enum class ParticleType
+    enum class ParticleType : uint8_t
     {
         Blood,
         BulletTrail
     };
 
-    struct Particle
+    // What a particle starts with; the pool keeps it split over its arrays
+    struct ParticleSpawn
     {
-        glm::vec2 position;
-        glm::vec2 velocity;
-        Color color;
+        float x, y;
+        float velocityX, velocityY;
         float lifetime;
-        float initialLifetime;
         float size;
+        float drag;  // Fraction of velocity lost per second
+        float fade;  // 1 fades alpha out over the lifetime, 0 keeps it at 255
+        Color color; // Alpha unused, see ParticlePool::alpha
         ParticleType type;
     };
 
+    /**
+     * Fixed-capacity structure-of-arrays particle storage. All arrays are allocated for capacity()
+     * particles up front, and the live particles are the first size() elements, so the update is a
+     * linear pass over contiguous floats (see ParticleKernels.h) and emission never reallocates.
+     * removeDead() fills each dead slot from the tail (swap-and-pop), so removal costs O(deaths); the
+     * order of the particles is not kept, and nothing depends on it (effects are sorted by texture).
+     */
+    struct ParticlePool
+    {
+        std::vector<float> x, y;
+        std::vector<float> velocityX, velocityY;
+        std::vector<float> life;
+        std::vector<float> inverseLifetime; // 1 / initial lifetime, for the fade
+        std::vector<float> size;
+        std::vector<float> drag;
+        std::vector<float> fade;
+        std::vector<uint8_t> alpha;
+        std::vector<Color> color;
+        std::vector<ParticleType> type;
+
+        explicit ParticlePool(size_t capacity)
+            : x(capacity), y(capacity), velocityX(capacity), velocityY(capacity), life(capacity),
+              inverseLifetime(capacity), size(capacity), drag(capacity), fade(capacity), alpha(capacity),
+              color(capacity), type(capacity), m_capacity(capacity)
+        {
+        }
+
+        size_t getSize() const { return m_size; }
+        size_t getCapacity() const { return m_capacity; }
+        bool isFull() const { return m_size == m_capacity; }
+
+        // Returns false when the pool is full
+        bool add(const ParticleSpawn& spawn)
+        {
+            if (m_size == m_capacity || spawn.lifetime <= 0.0f) return false;
+            size_t i = m_size++;
+            x[i] = spawn.x;
+            y[i] = spawn.y;
+            velocityX[i] = spawn.velocityX;
+            velocityY[i] = spawn.velocityY;
+            life[i] = spawn.lifetime;
+            inverseLifetime[i] = 1.0f / spawn.lifetime;
+            size[i] = spawn.size;
+            drag[i] = spawn.drag;
+            fade[i] = spawn.fade;
+            alpha[i] = 255;
+            color[i] = spawn.color;
+            type[i] = spawn.type;
+            return true;
+        }
+
+        // Calls onDeath(index) for every particle with life <= 0, before it is overwritten, then drops them
+        template <typename OnDeath>
+        void removeDead(OnDeath onDeath)
+        {
+            size_t i = findDeadParticle(life.data(), 0, m_size);
+            while (i < m_size)
+            {
+                onDeath(i);
+                --m_size;
+                moveParticle(m_size, i); // The moved particle may be dead too, so the search starts at i again
+                i = findDeadParticle(life.data(), i, m_size);
+            }
+        }
+
+        ParticleArrays getArrays()
+        {
+            return {x.data(), y.data(), velocityX.data(), velocityY.data(), life.data(),
+                    inverseLifetime.data(), drag.data(), fade.data(), alpha.data()};
+        }
+
+        void clear() { m_size = 0; }
+
+    private:
+        size_t m_size = 0;
+        size_t m_capacity;
+
+        void moveParticle(size_t from, size_t to)
+        {
+            if (from == to) return;
+            x[to] = x[from];
+            y[to] = y[from];
+            velocityX[to] = velocityX[from];
+            velocityY[to] = velocityY[from];
+            life[to] = life[from];
+            inverseLifetime[to] = inverseLifetime[from];
+            size[to] = size[from];
+            drag[to] = drag[from];
+            fade[to] = fade[from];
+            alpha[to] = alpha[from];
+            color[to] = color[from];
+            type[to] = type[from];
+        }
+    };
+
 } // namespace TuxArena
 
 #endif // TUXARENA_PARTICLE_H
@@ -0,0 +1,43 @@
+#ifndef TUXARENA_PARTICLEKERNELS_H
+#define TUXARENA_PARTICLEKERNELS_H
+
+#include <cstddef>
+#include <cstdint>
+
+namespace TuxArena
+{
+
+    // Particle arrays the kernels work on (see ParticlePool)
+    struct ParticleArrays
+    {
+        float* x;
+        float* y;
+        float* velocityX;
+        float* velocityY;
+        float* life;
+        const float* inverseLifetime;
+        const float* drag;
+        const float* fade;
+        uint8_t* alpha;
+    };
+
+    // Particle update kernels. The implementation is picked once at first use: AVX2 (8 particles per
+    // instruction) or SSE2 (4) on x86 CPUs that have them, a scalar loop elsewhere. All of them give the
+    // same results as the scalar loop.
+
+    // For particles [0, count): life -= dt, position += velocity * dt, velocity *= max(0, 1 - drag * dt),
+    // alpha = 255 * (1 - fade * (1 - life / initial life)), clamped to [0, 255]
+    void integrateParticles(const ParticleArrays& particles, size_t count, float deltaTime);
+
+    // Index of the first particle in [begin, end) with life <= 0, or end
+    size_t findDeadParticle(const float* life, size_t begin, size_t end);
+
+    const char* getParticleKernelName(); // "AVX2", "SSE2" or "scalar"
+
+    // Replaces the automatic choice, for tests and benchmarks. Returns false if this build or CPU
+    // cannot run the named kernel. Not thread-safe: call before any particle update.
+    bool selectParticleKernel(const char* name);
+
+} // namespace TuxArena
+
+#endif // TUXARENA_PARTICLEKERNELS_H
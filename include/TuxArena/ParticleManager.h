@@ -1,24 +1,64 @@
 #ifndef TUXARENA_PARTICLEMANAGER_H
 #define TUXARENA_PARTICLEMANAGER_H
 
+#include <cstddef>
 #include <vector>
 #include "TuxArena/Particle.h"
+#include "TuxArena/SpriteBatch.h" // For PointSprite
 
 namespace TuxArena
 {
     class Renderer;
 
+    // How much of an effect survives under load: High keeps quality x its emission, Low keeps quality^2
+    // and may only fill half of the budget
+    enum class ParticlePriority
+    {
+        Low,
+        High
+    };
+
+    /**
+     * Particle effects under a global budget that follows frame time. reportFrameTime() lowers a
+     * quality factor while smoothed frame time is over the target and raises it slowly again when
+     * there is headroom; quality scales the particle budget, the emitted counts and the lifetimes,
+     * so a large firefight thins out its effects instead of hitching.
+     */
     class ParticleManager
     {
     public:
+        static constexpr size_t MAX_PARTICLES = 16384; // Budget at full quality
+        static constexpr float MIN_QUALITY = 0.1f;
+        static constexpr size_t MAX_PENDING_DECALS = 4096; // Dropped beyond this when nothing renders (server)
+        static constexpr size_t BLOOD_RANDOM_VALUES = 7; // Direction, speed, color (3), lifetime, size
+
         void update(float deltaTime);
         void render(Renderer& renderer);
 
         void emitBlood(float x, float y, int count);
         void emitBulletTrail(float x, float y, float dirX, float dirY);
+        // Stamps a permanent mark into the renderer's decal layer at the next render()
+        void addDecal(float x, float y, float radius, const Color& color);
+
+        // Call once per frame with the frame's work time and the time it should fit in
+        void reportFrameTime(float frameMs, float targetMs);
+        float getQuality() const { return m_quality; }
+        size_t getBudget() const;
+        size_t getParticleCount() const { return m_pool.getSize(); }
+        size_t getParticleCount(ParticleType type) const; // Counts on every call, for debug displays
 
     private:
-        std::vector<Particle> m_particles;
+        float priorityShare(ParticlePriority priority) const;
+        bool hasRoom(ParticlePriority priority) const;
+        float scaledLifetime(float lifetime) const;
+
+        ParticlePool m_pool{MAX_PARTICLES}; // Allocated for the full budget up front
+        float m_quality = 1.0f;
+        float m_smoothedFrameMs = 0.0f;
+        float m_trailCredit = 0.0f; // Fractional trail emissions carried over, so thinning is even
+        std::vector<PointSprite> m_sprites; // Per-frame render buffer, reused to avoid allocations
+        std::vector<PointSprite> m_pendingDecals; // Settled blood and impacts, handed to the renderer in render()
+        std::vector<float> m_randomValues; // Per-burst random numbers, reused like m_sprites
     };
 
 } // namespace TuxArena
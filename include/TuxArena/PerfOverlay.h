@@ -0,0 +1,37 @@
+#ifndef TUXARENA_PERFOVERLAY_H
+#define TUXARENA_PERFOVERLAY_H
+
+#include "TuxArena/FramePacer.h"
+#include "TuxArena/Profiler.h"
+
+namespace TuxArena {
+
+class EntityManager;
+class NetworkClient;
+class Renderer;
+class RenderThread;
+
+/**
+ * @brief In-game performance overlay (F3): frame and tick time graphs, per-stage timings, entity and
+ * particle counts, draw calls, texture memory and network stats.
+ *
+ * build() runs a whole ImGui frame on the main thread while a frame is recorded; the caller then
+ * hands the result to Renderer::recordOverlay(). Nothing is built or copied while the overlay is
+ * hidden, which leaves the Profiler scopes as the only cost.
+ */
+class PerfOverlay {
+public:
+    void toggle() { m_visible = !m_visible; }
+    bool isVisible() const { return m_visible; }
+
+    // renderThread is null when frames are drawn on the main thread
+    void build(const Profiler& profiler, const FrameStats& frameStats, Renderer& renderer, RenderThread* renderThread,
+               EntityManager* entityManager, const NetworkClient* networkClient);
+
+private:
+    bool m_visible = false;
+};
+
+} // namespace TuxArena
+
+#endif // TUXARENA_PERFOVERLAY_H
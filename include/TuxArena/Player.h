@@ -3,6 +3,7 @@
 
 #include "TuxArena/Entity.h"
 #include "TuxArena/Weapon.h"
+#include "TuxArena/TextureHandle.h"
 #include <string>
 #include <vector>
 #include <memory>
@@ -65,7 +66,7 @@ private:
     Weapon* getCurrentWeapon() const;
 
     // Rendering
-    SDL_Texture* m_playerTexture = nullptr; // Cached texture pointer
+    TextureHandle m_playerTexture; // Acquired in initialize(), released in onDestroy()
     std::string m_texturePath = "assets/characters/tux.png"; // Default texture path
 
     // --- Private Helper Methods ---
@@ -0,0 +1,69 @@
+#ifndef TUXARENA_PROFILER_H
+#define TUXARENA_PROFILER_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+namespace TuxArena {
+
+// Client loop stages measured by the Profiler. Collision and Particles run inside Simulation.
+enum class ProfileStage : uint8_t {
+    Input,
+    NetworkReceive,
+    Simulation,
+    Collision,
+    Particles,
+    Render,  // Frame recording on the main thread
+    Present, // Replay and buffer swap (render thread when one is running)
+    Count
+};
+
+/**
+ * @brief Per-frame stage timings with a short history, for the perf overlay.
+ *
+ * Stages add their time through a Scope (two performance counter reads); endFrame() moves the
+ * accumulated times into the history. Reading and averaging only happen when the overlay draws.
+ * Passed to entities through EntityContext::profiler; a null profiler turns scopes into no-ops.
+ */
+class Profiler {
+public:
+    static constexpr size_t HISTORY = 240; // Frames
+    static constexpr size_t STAGE_COUNT = static_cast<size_t>(ProfileStage::Count);
+
+    class Scope {
+    public:
+        Scope(Profiler* profiler, ProfileStage stage);
+        ~Scope();
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+
+    private:
+        Profiler* m_profiler;
+        ProfileStage m_stage;
+        uint64_t m_start = 0;
+    };
+
+    void add(ProfileStage stage, double ms) { m_current[static_cast<size_t>(stage)] += ms; }
+    void endFrame(double frameMs); // Frame interval, start to start
+
+    static const char* getStageName(ProfileStage stage);
+    // Oldest sample first at getHistoryOffset() (ImGui::PlotLines values_offset)
+    const std::array<float, HISTORY>& getFrameTimes() const { return m_frameTimes; }
+    const std::array<float, HISTORY>& getStageTimes(ProfileStage stage) const { return m_stageTimes[static_cast<size_t>(stage)]; }
+    size_t getHistoryOffset() const { return m_nextSample; }
+    size_t getSampleCount() const { return m_sampleCount; }
+    float getStageMean(ProfileStage stage) const;
+    float getStageMax(ProfileStage stage) const;
+
+private:
+    std::array<double, STAGE_COUNT> m_current{};
+    std::array<float, HISTORY> m_frameTimes{};
+    std::array<std::array<float, HISTORY>, STAGE_COUNT> m_stageTimes{};
+    size_t m_nextSample = 0;
+    size_t m_sampleCount = 0;
+};
+
+} // namespace TuxArena
+
+#endif // TUXARENA_PROFILER_H
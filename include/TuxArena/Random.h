@@ -0,0 +1,72 @@
+#ifndef TUXARENA_RANDOM_H
+#define TUXARENA_RANDOM_H
+
+#include <cstddef>
+#include <cstdint>
+
+namespace TuxArena {
+
+// Independent random streams, so effects drawing more or fewer numbers (particle quality, a
+// client with effects off) never shifts the gameplay sequence
+enum class RandomStream : uint8_t {
+    Gameplay, // Weapon spread and anything else that changes the simulation
+    Effects,  // Particles and other visuals
+    Count
+};
+
+/**
+ * @brief Small seedable PRNG: PCG32 (XSH-RR) for single values, plus an 8-lane xoshiro128+ for
+ * bulk floats.
+ *
+ * Not thread-safe; each thread uses its own instances (see getRandom()). The same seed and stream
+ * give the same sequence on every platform and compiler, unlike rand().
+ */
+class Random {
+public:
+    explicit Random(uint64_t seed = 0x853c49e6748fea9bull, uint64_t stream = 0) { reseed(seed, stream); }
+
+    // Restarts the sequence; different streams with the same seed do not overlap
+    void reseed(uint64_t seed, uint64_t stream = 0);
+
+    uint32_t next() {
+        uint64_t old = m_state;
+        m_state = old * 6364136223846793005ull + m_increment;
+        uint32_t xorShifted = static_cast<uint32_t>(((old >> 18u) ^ old) >> 27u);
+        uint32_t rotation = static_cast<uint32_t>(old >> 59u);
+        return (xorShifted >> rotation) | (xorShifted << ((32u - rotation) & 31u));
+    }
+
+    // Uniform in [0, bound), without the modulo bias of next() % bound
+    uint32_t nextBelow(uint32_t bound);
+    // Uniform in [0, 1), 24 bits
+    float nextFloat() { return static_cast<float>(next() >> 8) * (1.0f / 16777216.0f); }
+    float range(float min, float max) { return min + (max - min) * nextFloat(); }
+    // Uniform in [min, max], inclusive
+    int range(int min, int max) { return min + static_cast<int>(nextBelow(static_cast<uint32_t>(max - min) + 1u)); }
+
+    // Fills out with uniform floats in [min, max), eight at a time from the bulk lanes. Much cheaper
+    // per value than nextFloat() for particle bursts; does not advance the next() sequence.
+    void fillFloats(float* out, size_t count, float min, float max);
+
+private:
+    static constexpr size_t LANES = 8;
+
+    uint64_t m_state = 0;
+    uint64_t m_increment = 1; // Selects the stream, always odd
+    uint32_t m_lanes[4][LANES] = {}; // xoshiro128+ state, word-major so each step is one vector op per word
+};
+
+// Seed of every stream on every thread. The first thread to call this (the simulation thread) gets
+// the same sequences for the same seed; calls from other threads change the seed but never share
+// its streams. Call before the simulation starts. The seed is local to the process: clients and
+// the server seed independently, so it reproduces one process's sequences, not a networked match.
+void setRandomSeed(uint64_t seed);
+uint64_t getRandomSeed();
+
+// The calling thread's generator for a stream, reseeded after setRandomSeed(). Worker threads get
+// their own sequences, so no locking is needed anywhere.
+Random& getRandom(RandomStream stream);
+
+} // namespace TuxArena
+
+#endif // TUXARENA_RANDOM_H
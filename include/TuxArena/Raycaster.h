@@ -0,0 +1,69 @@
+#ifndef TUXARENA_RAYCASTER_H
+#define TUXARENA_RAYCASTER_H
+
+#include <cstdint>
+#include <vector>
+#include "TuxArena/Entity.h" // For Vec2
+
+namespace TuxArena {
+
+class CollisionGrid;
+
+// Result of a ray query against the collision grid
+struct RayHit {
+    bool hit = false;
+    float distance = 0.0f;   // Pixels travelled along the ray (maxDistance on a miss)
+    Vec2 point = {0.0f, 0.0f};
+    Vec2 normal = {0.0f, 0.0f}; // Face normal of the tile that was hit
+    int tileX = -1;
+    int tileY = -1;
+};
+
+// Ray queries over the tile collision grid (hitscan, line of sight, swept projectiles).
+// Uses an Amanatides-Woo DDA per tile, and a coarse occupancy level of SUPER_TILE_SIZE x
+// SUPER_TILE_SIZE tiles so rays cross empty regions in a single step.
+class Raycaster {
+public:
+    static constexpr int SUPER_TILE_SHIFT = 3;
+    static constexpr int SUPER_TILE_SIZE = 1 << SUPER_TILE_SHIFT; // 8x8 tiles
+
+    void build(const CollisionGrid& grid);
+    void clear();
+    bool isBuilt() const { return m_grid != nullptr; }
+
+    // Recounts the super-tile containing the tile. Call after changing a tile in the grid.
+    void updateTile(int tileX, int tileY);
+
+    /**
+     * @brief Casts a single ray. Origins outside the map or inside a solid tile hit at distance 0.
+     * @param origin Start point in pixels.
+     * @param direction Ray direction (does not need to be normalized).
+     * @param maxDistance Maximum travel in pixels.
+     */
+    RayHit castRay(const Vec2& origin, const Vec2& direction, float maxDistance) const;
+
+    bool hasLineOfSight(const Vec2& from, const Vec2& to) const;
+
+    // Batch queries sharing one origin (e.g. shotgun pellets, bot perception)
+    void castRays(const Vec2& origin, const Vec2* directions, int count, float maxDistance, RayHit* outHits) const;
+    void castRayFan(const Vec2& origin, float centerAngleDegrees, float spreadDegrees, int count, float maxDistance, RayHit* outHits) const;
+
+private:
+    const CollisionGrid* m_grid = nullptr;
+    int m_superWidth = 0;
+    int m_superHeight = 0;
+    std::vector<uint8_t> m_superCounts; // Solid tiles per super-tile, 0 = empty
+
+    // Origin in tile units, precomputed once per batch
+    struct Origin {
+        float tileX = 0.0f;
+        float tileY = 0.0f;
+        Vec2 pixels = {0.0f, 0.0f};
+    };
+    Origin makeOrigin(const Vec2& origin) const;
+    RayHit traverse(const Origin& origin, float dirX, float dirY, float maxDistance) const;
+};
+
+} // namespace TuxArena
+
+#endif // TUXARENA_RAYCASTER_H
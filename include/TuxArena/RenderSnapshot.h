@@ -0,0 +1,127 @@
+#ifndef TUXARENA_RENDERSNAPSHOT_H
+#define TUXARENA_RENDERSNAPSHOT_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include <SDL2/SDL.h>
+#include "TuxArena/Renderer.h" // For Color, Camera, PointSprite, TextureHandle, MapLayer
+#include "TuxArena/RenderSort.h"
+
+struct ImDrawList;
+
+namespace TuxArena {
+
+enum class RenderCommandType : uint8_t {
+    Texture,       // texture or handle, srcRect/dstRect/angle/center/flip
+    Rect,          // dstRect, color, filled
+    Line,          // x1/y1 to x2/y2, color
+    Circle,        // x1/y1 center, radius, color, filled
+    Text,          // stringIndex, fontIndex, x1/y1, fontSize, color
+    PointSprites,  // first/count into RenderSnapshot::pointSprites
+    Map,           // mapLayer of RenderSnapshot::map
+    PrebakeMap,    // bake every chunk of RenderSnapshot::map
+    Decals,        // visible decal chunks
+    Minimap,       // RenderSnapshot::map fitted into dstRect, markers at first/count of pointSprites
+    FogMask        // fog texture over dstRect, mask revision in first (RenderSnapshot::fogMask when it changed)
+};
+
+// One recorded Renderer call. Pointer arguments of the original call are copied by value.
+struct RenderCommand {
+    RenderCommandType type = RenderCommandType::Rect;
+    RenderLayer layer = RenderLayer::World;
+    bool filled = false;
+    bool hasSrcRect = false;
+    bool hasCenter = false;
+    SDL_RendererFlip flip = SDL_FLIP_NONE;
+    MapLayer mapLayer = MapLayer::Background;
+    uint32_t depth = 0;     // Sort depth within the layer (see makeRenderSortKey)
+    Color color = {255, 255, 255, 255};
+    SDL_Texture* texture = nullptr; // Unmanaged texture (chunk, cached pointer)
+    TextureHandle handle;           // Resolved when the command is replayed
+    SDL_Rect srcRect = {0, 0, 0, 0};
+    SDL_FRect dstRect = {0.0f, 0.0f, 0.0f, 0.0f};
+    SDL_FPoint center = {0.0f, 0.0f};
+    double angle = 0.0;
+    float x1 = 0.0f, y1 = 0.0f, x2 = 0.0f, y2 = 0.0f;
+    float radius = 0.0f;
+    int fontSize = 0;
+    int cameraIndex = -1;   // Camera in effect when recorded, -1 for screen space
+    uint32_t stringIndex = 0;
+    uint32_t fontIndex = 0;
+    uint32_t first = 0;
+    uint32_t count = 0;
+};
+
+// ImGui output of the frame (perf overlay). ImGui rebuilds its draw data on the next NewFrame(), so
+// Renderer::recordOverlay() copies the lists; their buffers are reused from frame to frame.
+struct OverlayDrawData {
+    std::vector<ImDrawList*> lists; // Owned
+    size_t listCount = 0;           // Lists in use this frame, 0 when no overlay is shown
+    float displayPos[2] = {0.0f, 0.0f};
+    float displaySize[2] = {0.0f, 0.0f};
+    float framebufferScale[2] = {1.0f, 1.0f};
+
+    OverlayDrawData() = default;
+    ~OverlayDrawData();
+    OverlayDrawData(const OverlayDrawData&) = delete;
+    OverlayDrawData& operator=(const OverlayDrawData&) = delete;
+};
+
+/**
+ * @brief Everything one frame draws, recorded on the simulation thread by Renderer::beginRecording()
+ * and replayed by Renderer::replay() (on the render thread when one is running).
+ *
+ * The snapshot owns copies of all per-frame data, so the simulation may keep mutating entities,
+ * particles and tiles while the previous snapshot is being drawn. Only the loaded map's immutable
+ * parts (tilesets, layer layout) are read through the map pointer at replay time.
+ */
+struct RenderSnapshot {
+    std::vector<RenderCommand> commands;
+    std::vector<Camera> cameras;
+    std::vector<std::string> strings;
+    std::vector<std::string> fonts;
+    std::vector<PointSprite> pointSprites;
+    std::vector<PointSprite> decals; // Stamped into the decal chunks before the frame is drawn
+    int activeCamera = -1; // Camera for the next recorded command, and for visibility queries
+    RenderLayer activeLayer = RenderLayer::World;
+
+    // Map data. The renderer keeps its own tile GIDs, updated from these.
+    const MapManager* map = nullptr;
+    bool mapCaptured = false;    // Tile state of this frame is already recorded
+    bool mapReset = false;       // mapTileGids replaces the renderer's copy
+    std::vector<std::vector<uint32_t>> mapTileGids;
+    std::vector<TileEdit> tileEdits; // Applied after a reset, in order
+
+    // Fog of war mask, copied only in the frame its revision changes; the renderer keeps the last upload
+    std::vector<uint8_t> fogMask;
+    int fogWidth = 0;
+    int fogHeight = 0;
+
+    OverlayDrawData overlay; // Drawn over everything, after the sorted commands
+
+    void clear() {
+        commands.clear();
+        cameras.clear();
+        strings.clear();
+        fonts.clear();
+        pointSprites.clear();
+        decals.clear();
+        activeCamera = -1;
+        activeLayer = RenderLayer::World;
+        map = nullptr;
+        mapCaptured = false;
+        mapReset = false;
+        mapTileGids.clear();
+        tileEdits.clear();
+        fogMask.clear();
+        fogWidth = 0;
+        fogHeight = 0;
+        overlay.listCount = 0;
+    }
+};
+
+} // namespace TuxArena
+
+#endif // TUXARENA_RENDERSNAPSHOT_H
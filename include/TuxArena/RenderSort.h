@@ -0,0 +1,43 @@
+#ifndef TUXARENA_RENDERSORT_H
+#define TUXARENA_RENDERSORT_H
+
+#include <cstdint>
+#include <vector>
+
+namespace TuxArena {
+
+// Draw layers, back to front. Commands are sorted by layer first; within a layer the order depends
+// on the layer: submission order, y-sorted (lower on screen draws later) or grouped by texture.
+enum class RenderLayer : uint8_t {
+    MapBackground, // Submission order
+    World,         // Y-sorted by the bottom edge of each draw
+    Effects,       // Particles and other blended effects: grouped by texture
+    MapForeground, // Submission order
+    Hud            // Submission order
+};
+
+// 64-bit sort key, most significant first: layer (4 bits), depth (24), blend mode (4), texture (16).
+// The low 16 bits are zero, so the radix sort skips them.
+constexpr int RENDER_SORT_DEPTH_BITS = 24;
+constexpr int RENDER_SORT_TEXTURE_BITS = 16;
+inline uint64_t makeRenderSortKey(RenderLayer layer, uint32_t depth, uint32_t blend, uint32_t texture) {
+    return (static_cast<uint64_t>(layer) << 60) |
+           (static_cast<uint64_t>(depth & ((1u << RENDER_SORT_DEPTH_BITS) - 1)) << 36) |
+           (static_cast<uint64_t>(blend & 0xF) << 32) |
+           (static_cast<uint64_t>(texture & ((1u << RENDER_SORT_TEXTURE_BITS) - 1)) << 16);
+}
+
+// Depth for y-sorted layers: world y at quarter-pixel resolution, offset so negative positions sort first
+uint32_t renderSortDepthFromY(float y);
+
+/**
+ * @brief Stable LSD radix sort (8-bit digits). Sorts keys in place; order receives the original
+ * index of each sorted key. Digits that are equal across all keys are skipped, so unused key bits
+ * cost nothing. The scratch buffers are kept by the caller to avoid per-frame allocations.
+ */
+void radixSortByKey(std::vector<uint64_t>& keys, std::vector<uint32_t>& order,
+                    std::vector<uint64_t>& keyScratch, std::vector<uint32_t>& orderScratch);
+
+} // namespace TuxArena
+
+#endif // TUXARENA_RENDERSORT_H
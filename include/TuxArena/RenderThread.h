@@ -0,0 +1,62 @@
+#ifndef TUXARENA_RENDERTHREAD_H
+#define TUXARENA_RENDERTHREAD_H
+
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "TuxArena/RenderSnapshot.h"
+
+namespace TuxArena {
+
+// Draws recorded frames on a dedicated thread, one frame behind the simulation.
+// Two snapshots alternate: the simulation records into the back buffer while the render thread
+// replays the other one. The render thread owns the GL context and every SDL renderer call from
+// start() to stop(); the window and event polling stay on the main thread.
+class RenderThread {
+public:
+    explicit RenderThread(Renderer& renderer);
+    ~RenderThread();
+
+    RenderThread(const RenderThread&) = delete;
+    RenderThread& operator=(const RenderThread&) = delete;
+
+    bool start();
+    void stop(); // Draws the pending frame, then hands the renderer back to the calling thread
+    bool isRunning() const { return m_thread.joinable(); }
+
+    // Snapshot to record the next frame into. Waits while the render thread still reads it.
+    RenderSnapshot& acquireBackBuffer();
+    // Publishes the back buffer. Waits if the previous frame has not been picked up yet,
+    // so no frame (and none of its tile edits) is ever dropped.
+    void submit();
+    // Waits until every submitted frame is drawn. Call before freeing anything a snapshot points at (maps).
+    void synchronize();
+    // Stats of the last drawn frame (Renderer::getReplayStats() is only safe on the render thread)
+    Renderer::ReplayStats getReplayStats();
+    // With history enabled, the stats of every drawn frame are kept until taken, in draw order (benchmarks)
+    void setReplayHistoryEnabled(bool enabled);
+    std::vector<Renderer::ReplayStats> takeReplayHistory();
+
+private:
+    Renderer& m_renderer;
+    std::thread m_thread;
+    std::mutex m_mutex;
+    std::condition_variable m_condition;
+
+    RenderSnapshot m_snapshots[2];
+    int m_backIndex = 0;       // Written by the simulation
+    int m_pendingIndex = -1;   // Submitted, not yet picked up
+    int m_drawingIndex = -1;   // Being replayed
+    bool m_stopRequested = false;
+    Renderer::ReplayStats m_replayStats; // Copied after each replay, guarded by m_mutex
+    bool m_keepReplayHistory = false;
+    std::vector<Renderer::ReplayStats> m_replayHistory;
+
+    void threadMain();
+};
+
+} // namespace TuxArena
+
+#endif // TUXARENA_RENDERTHREAD_H
@@ -2,7 +2,14 @@
 #define TUXARENA_RENDERER_H
 
 #include <string>
+#include <list>
 #include <map>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+#include <atomic>
+#include <mutex>
+#include <thread>
 
 #include <SDL2/SDL.h>
 #include <SDL2/SDL_image.h>
@@ -10,17 +17,26 @@
 #include <SDL2/SDL_render.h> // For SDL_FPoint
 #include <SDL_opengl.h> // For GLuint
 #include "TuxArena/MapManager.h" // For MapLayer
+#include "TuxArena/Camera.h"
+#include "TuxArena/Color.h"
+#include "TuxArena/SpriteBatch.h"
+#include "TuxArena/TextureAtlas.h"
+#include "TuxArena/TextureDiskCache.h"
+#include "TuxArena/GlyphCache.h"
+#include "TuxArena/TextureHandle.h"
 
-namespace TuxArena {
+struct ImGuiContext;
 
-// Struct for colors
-struct Color {
-    uint8_t r, g, b, a;
-};
+namespace TuxArena {
 
 #include "TuxArena/AssetManager.h"
 
 class AssetManager;
+struct RenderSnapshot;
+struct RenderCommand;
+struct OverlayDrawData;
+enum class RenderCommandType : uint8_t;
+enum class RenderLayer : uint8_t;
 
 class Renderer {
 public:
@@ -28,24 +44,146 @@ public:
     ~Renderer();
 
     bool initialize(const std::string& title, int width, int height, bool vsync);
+    // No window, GL or ImGui: SDL's software renderer draws into an offscreen surface.
+    // Works with the dummy video driver, for benchmarks on machines without a GPU or display.
+    bool initializeHeadless(int width, int height);
+    SDL_Surface* getHeadlessSurface() const { return m_headlessSurface; } // Last presented frame
     void shutdown();
 
+    // Texture cache accounting, 4 bytes per texel
+    struct TextureCacheStats {
+        size_t bytes = 0;        // Own textures plus atlas pages
+        size_t atlasBytes = 0;   // Atlas pages alone, allocated whole
+        size_t budget = 0;
+        size_t textures = 0;
+        size_t unreferenced = 0; // Kept for reuse, evicted first
+        size_t evictions = 0;    // Since initialization
+        size_t evictedBytes = 0;
+    };
+
+    // Timing of the last replay(), for benchmarks and the perf overlay
+    struct ReplayStats {
+        double prepareMs = 0.0; // Deferred texture work, tile edits, sort keys and sort
+        double drawMs = 0.0;    // Command execution, including chunk baking
+        double presentMs = 0.0; // Final flush and buffer swap
+        size_t commandCount = 0;
+        size_t drawCalls = 0;
+        size_t triangles = 0;
+        size_t textureBytes = 0; // Estimated, only measured for frames with an overlay
+        TextureCacheStats textureCache;
+    };
+    const ReplayStats& getReplayStats() const { return m_replayStats; }
+
     void clear();
     void present();
 
-    // Texture management
+    // Recording. Between beginRecording() and endRecording() the drawing, camera and map functions
+    // called on this thread append to the snapshot instead of drawing. replay() then clears, draws the
+    // snapshot and presents; it must run on the thread that owns the SDL renderer (see bindToCurrentThread()).
+    void beginRecording(RenderSnapshot& snapshot);
+    void endRecording();
+    void replay(RenderSnapshot& snapshot); // Consumes the snapshot's map data
+    // Layer of the following draws while recording. Each frame is sorted by a 64-bit key (layer, depth,
+    // blend mode, texture) before submission, so world draws are y-sorted and effects grouped by texture.
+    void setDrawLayer(RenderLayer layer);
+    // Copies the draw data of the last ImGui::Render() into the snapshot being recorded. The render
+    // thread draws it over the frame, so ImGui frames can be built on the simulation thread.
+    void recordOverlay();
+    bool hasImGui() const { return m_imguiInitialized; }
+    // The only ImGui context; UIManager and the perf overlay build their frames in it
+    ImGuiContext* getImGuiContext() const { return m_imguiContext; }
+
+    // Moves the GL context and renderer ownership to the calling thread. Texture loads and releases
+    // requested from other threads are queued and carried out by the owner at the next replay().
+    void bindToCurrentThread();
+    void unbindFromCurrentThread();
+    bool isRenderThread() const { return std::this_thread::get_id() == m_renderThreadId.load(); }
+
+    // Safe from any thread: baked map chunks are dropped before the next replay (render targets lost)
+    void notifyRenderTargetsReset() { m_renderTargetsReset = true; }
+
+    // Texture management. Textures are cached by path. Small images only live in the texture atlas and
+    // are drawn from their atlas page, so different sprites batch together; larger ones get their own texture.
+    // loadTexture() returns a standalone texture (created on demand for atlased images) that is pinned
+    // (never evicted) until shutdown; per-frame code should hold a TextureHandle instead.
     SDL_Texture* loadTexture(const std::string& filePath);
+    const TextureAtlas& getTextureAtlas() const { return m_textureAtlas; }
+
+    // Reference-counted handles. acquireTexture() loads (or reuses) the texture and adds a reference.
+    // When the last reference is released the texture stays cached, unreferenced, for a later acquire;
+    // unreferenced textures are evicted least recently released first while the cache is over its budget.
+    // Placeholders for missing files are destroyed on release, so a file added later is picked up.
+    // Both are safe from any thread; off the render thread the load and release are deferred to the next replay().
+    TextureHandle acquireTexture(const std::string& filePath);
+    void releaseTexture(TextureHandle handle);
+    SDL_Texture* getTexture(TextureHandle handle) const; // Own texture or atlas page; nullptr for invalid or stale handles
+    // Texture holding the image and the image's rectangle in it, in 0-1 texture coordinates (for ImGui::Image)
+    bool getTextureImage(TextureHandle handle, SDL_Texture*& texture, SDL_FRect& uvRect) const;
     void destroyTexture(SDL_Texture* texture);
 
+    // Tint (alpha included) and blend mode of a handle's draws, kept until its last release. Use these
+    // instead of SDL_SetTextureColorMod/BlendMode, which would affect every image on an atlas page.
+    void setTextureColorMod(TextureHandle handle, const Color& color);
+    void setTextureBlendMode(TextureHandle handle, SDL_BlendMode blendMode);
+
+    // Referenced and pinned textures are never evicted, so they alone may exceed the budget.
+    // Call before the render thread starts.
+    static constexpr size_t DEFAULT_TEXTURE_BUDGET = 256u * 1024u * 1024u;
+    void setTextureBudget(size_t bytes);
+    TextureCacheStats getTextureCacheStats() const; // Render thread
+
     // Drawing functions
     void drawTexture(SDL_Texture* texture, const SDL_Rect* srcRect, const SDL_FRect* dstRect, double angle = 0.0, const SDL_FPoint* center = nullptr, SDL_RendererFlip flip = SDL_FLIP_NONE);
+    void drawTexture(TextureHandle texture, const SDL_Rect* srcRect, const SDL_FRect* dstRect, double angle = 0.0, const SDL_FPoint* center = nullptr, SDL_RendererFlip flip = SDL_FLIP_NONE);
     void drawRect(const SDL_FRect* rect, const Color& color, bool filled = false);
     void drawLine(float x1, float y1, float x2, float y2, const Color& color);
     void drawCircle(float x, float y, float radius, const Color& color, bool filled = false);
     void drawText(const std::string& text, float x, float y, const std::string& fontPath, int fontSize, const Color& color);
+    // World-space particles as soft-edged round sprites, all in one batch
+    void drawPointSprites(const PointSprite* sprites, size_t count);
+
+    // Draw calls are queued in a SpriteBatch and submitted per texture run. flush() forces submission;
+    // present() and render target switches flush automatically.
+    void flush() { m_spriteBatch.flush(); }
+    const SpriteBatch& getSpriteBatch() const { return m_spriteBatch; }
 
-    // Map rendering
+    // Map rendering. Tile layers are baked into MAP_CHUNK_SIZE render-target textures and only the
+    // chunks inside the visible world rect are drawn. Chunks touched by tile edits are re-baked.
+    static constexpr int MAP_CHUNK_SIZE = 512; // Pixels
     void renderMap(const MapManager& mapManager, MapLayer layer);
+    void prebakeMap(const MapManager& mapManager); // Bakes every chunk now instead of on first draw. Call after a map loads.
+    void invalidateMapCache(); // Drops all baked chunks (map unloaded, or render targets lost)
+
+    // Decals: blood and impact marks stamped once into DECAL_CHUNK_SIZE render targets that are drawn
+    // above the map background, so lasting marks cost nothing per frame beyond the visible chunks.
+    // At most MAX_DECAL_CHUNKS chunks exist (the least recently stamped is dropped first), and a chunk
+    // fades out once it has gone DECAL_FADE_DELAY seconds without new stamps.
+    static constexpr int DECAL_CHUNK_SIZE = 512; // Pixels
+    static constexpr size_t MAX_DECAL_CHUNKS = 32;
+    static constexpr double DECAL_FADE_DELAY = 45.0;
+    static constexpr double DECAL_FADE_TIME = 5.0;
+    void addDecals(const PointSprite* decals, size_t count); // World space, baked at the next replay
+    void renderDecals();
+    void clearDecals();
+
+    // Minimap: the map's baked chunks downsampled once into a texture of at most MINIMAP_MAX_SIZE pixels
+    // (re-made at most every MINIMAP_REBAKE_INTERVAL_MS after tile edits) and drawn, with its markers, as a
+    // handful of batched quads. Fitted into screenRect, top-left aligned. Markers are in world space with
+    // their radius in minimap pixels.
+    static constexpr int MINIMAP_MAX_SIZE = 256;
+    static constexpr Uint32 MINIMAP_REBAKE_INTERVAL_MS = 1000;
+    void renderMinimap(const MapManager& mapManager, const SDL_FRect& screenRect, const PointSprite* markers, size_t markerCount);
+
+    // Fog of war: a one-byte-per-tile visibility mask (see FogOfWar), uploaded to a small streaming texture
+    // only when its revision changes and stretched over worldRect, above the map foreground, in one quad.
+    void renderFogMask(const uint8_t* mask, int width, int height, uint32_t revision, const SDL_FRect& worldRect);
+
+    // Camera. While set, drawTexture/drawRect/drawLine/drawCircle take world coordinates;
+    // drawText always draws in screen space (HUD). Pass nullptr for screen space.
+    void setCamera(const Camera* camera);
+    const Camera* getCamera() const;
+    SDL_FRect getVisibleWorldRect() const;
+    bool isVisible(const SDL_FRect& worldRect) const;
 
     // Getters
     SDL_Window* getSDLWindow() const { return m_sdlWindow; }
@@ -55,18 +193,159 @@ public:
     GLuint getOpenGLTextureID(SDL_Texture* texture);
 
 private:
+    AssetManager* m_assetManager = nullptr; // Resolves font paths; null in tools
     SDL_Window* m_sdlWindow = nullptr;
     SDL_Renderer* m_sdlRenderer = nullptr;
+    SDL_Surface* m_headlessSurface = nullptr; // Render target of the headless software renderer
+    bool m_imguiInitialized = false;
+    ImGuiContext* m_imguiContext = nullptr;
+    ReplayStats m_replayStats;
     int m_windowWidth = 0;
     int m_windowHeight = 0;
     bool m_isInitialized = false; // Added missing member
     Color m_clearColor = {20, 20, 30, 255}; // Darker shade for gothic theme
+    const Camera* m_camera = nullptr; // Not owned
+    std::atomic<std::thread::id> m_renderThreadId; // Thread allowed to make SDL renderer calls
+    SDL_GLContext m_glContext = nullptr; // Context of m_sdlRenderer, null for non-GL backends
+    std::atomic<bool> m_renderTargetsReset{false};
+    SpriteBatch m_spriteBatch;
+
+    // Replay sort buffers, reused every frame
+    std::vector<uint64_t> m_sortKeys;
+    std::vector<uint32_t> m_sortOrder;
+    std::vector<uint64_t> m_sortKeyScratch;
+    std::vector<uint32_t> m_sortOrderScratch;
+    // What a texture draw uses: a texture, the image's rectangle in it (empty = whole texture), tint and
+    // blend mode (INVALID = the texture's own)
+    struct TextureView {
+        SDL_Texture* texture = nullptr;
+        SDL_Rect region = {0, 0, 0, 0};
+        SDL_Color colorMod = {255, 255, 255, 255};
+        SDL_BlendMode blendMode = SDL_BLENDMODE_INVALID;
+    };
+    std::vector<TextureView> m_resolvedTextures;
+    std::unordered_map<SDL_Texture*, uint32_t> m_sortTextureIds; // Per-frame ids for the key's texture field
+    SDL_Texture* m_softCircleTexture = nullptr; // White disc with an anti-aliased edge, for point sprites
 
     // Cache for loaded textures and fonts
-    std::map<std::string, SDL_Texture*> m_textureCache;
+    struct CachedTexture {
+        SDL_Texture* texture = nullptr; // Own texture; for atlased images only once loadTexture() asked for one
+        bool atlased = false;           // Image lives in m_textureAtlas under the cache key
+        TextureAtlas::Region region;    // Its atlas location, when atlased
+        size_t bytes = 0;
+        bool placeholder = false;  // Generated for a file that failed to load
+        bool pinned = false;       // Returned by loadTexture(): never evicted
+        bool unreferenced = false; // Listed in m_unusedTextures
+        std::list<std::string>::iterator unusedPosition;
+    };
+    std::unordered_map<std::string, CachedTexture> m_textureCache;
+    std::unordered_map<SDL_Texture*, std::string> m_texturePaths; // Own textures -> key, for destroyTexture()
+    std::list<std::string> m_unusedTextures; // Unreferenced cache entries, most recently released first
+    size_t m_textureCacheBytes = 0; // Own textures; atlased images only cost their share of a page
+    size_t m_textureBudget = DEFAULT_TEXTURE_BUDGET;
+    size_t m_textureEvictions = 0;
+    size_t m_textureEvictedBytes = 0;
+
+    // Handle table: slots are indexed by TextureHandle::index and reused through the free list.
+    // m_textureMutex guards the table and the deferred work lists; everything else is render-thread only.
+    struct TextureSlot {
+        TextureView view; // Set once loaded; blend mode BLEND unless changed
+        uint32_t generation = 0;
+        uint32_t refCount = 0;
+        std::string path;
+    };
+    std::vector<TextureSlot> m_textureSlots;
+    std::vector<uint32_t> m_freeTextureSlots;
+    std::unordered_map<std::string, uint32_t> m_textureSlotByPath; // Only consulted at load time
+    std::vector<TextureHandle> m_pendingTextureLoads;    // Acquired off the render thread
+    std::vector<std::string> m_pendingTextureReleases;   // Released off the render thread
+    mutable std::mutex m_textureMutex;
+    std::unordered_map<const TilesetInfo*, TextureHandle> m_tilesetTextures; // Tilesets of m_chunkMap
+    TextureAtlas m_textureAtlas;
+    TextureDiskCache m_textureDiskCache; // Decoded images of loadTexture(), render-thread only
     std::map<std::pair<std::string, int>, TTF_Font*> m_fontCache;
+    std::unordered_map<std::string, std::map<int, std::unique_ptr<GlyphCache>>> m_glyphCaches; // Font path -> size -> glyphs
+
+    // Baked map chunks
+    struct MapChunk {
+        SDL_Texture* texture = nullptr; // Null while the chunk has no tiles
+        bool dirty = true;
+    };
+    struct MapChunkLayer {
+        std::vector<size_t> layerIndices; // Raw tile layers drawn for this MapLayer, in draw order
+        std::vector<MapChunk> chunks;     // m_chunksX * m_chunksY, row-major
+    };
+    const MapManager* m_chunkMap = nullptr; // Map the chunks were baked from
+    unsigned m_chunkTilesX = 0; // Tiles per chunk
+    unsigned m_chunkTilesY = 0;
+    unsigned m_chunksX = 0;
+    unsigned m_chunksY = 0;
+    bool m_chunkBakingFailed = false; // Render targets unavailable: draw tiles directly
+    // Replaces the blend mode of handle draws while chunks are baked, see getChunkBakeBlendMode()
+    SDL_BlendMode m_blendModeOverride = SDL_BLENDMODE_INVALID;
+    std::map<MapLayer, MapChunkLayer> m_mapChunks;
+    // Tile GIDs the chunks are baked from, kept in step with the map through the snapshots
+    const MapManager* m_tileGidsMap = nullptr;
+    std::vector<std::vector<uint32_t>> m_tileGids;
+    // Recording side (simulation thread): map whose tile state the renderer has been sent
+    const MapManager* m_recordedMap = nullptr;
+    size_t m_recordedEditCursor = 0; // Position in MapManager::getTileEdits()
+
+    // Decal chunks by (chunk x, chunk y), see makeDecalChunkKey()
+    struct DecalChunk {
+        SDL_Texture* texture = nullptr;
+        double lastStampTime = 0.0;
+    };
+    std::unordered_map<uint64_t, DecalChunk> m_decalChunks;
+    double m_decalTime = 0.0; // Replay time, seconds
+
+    SDL_Texture* m_minimapTexture = nullptr;
+    const MapManager* m_minimapMap = nullptr; // Map the minimap was baked from
+    bool m_minimapDirty = false;              // Tile edits since the last bake
+    Uint32 m_minimapBakeTicks = 0;
+    std::vector<PointSprite> m_minimapMarkers; // Screen-space copy, reused
+
+    SDL_Texture* m_fogTexture = nullptr; // Mask size, one texel per tile
+    int m_fogTextureWidth = 0;
+    int m_fogTextureHeight = 0;
+    uint32_t m_fogTextureRevision = 0;   // Mask revision in m_fogTexture
+    uint32_t m_recordedFogRevision = 0;  // Mask revision last copied into a snapshot
+    std::vector<uint32_t> m_fogPixels;   // Upload buffer, reused
+    bool m_decalsFailed = false; // Render targets unavailable: decals are dropped
+
+    RenderSnapshot* recordingSnapshot() const; // Snapshot being recorded on this thread, if any
+    RenderCommand& recordCommand(RenderSnapshot& snapshot, RenderCommandType type, float sortY);
+    void recordMapState(RenderSnapshot& snapshot, const MapManager& mapManager, bool reset);
+    void bindTileGids(const MapManager& mapManager);
+    void applyTileEdits(const std::vector<TileEdit>& edits);
+    void processPendingTextureWork();
+    CachedTexture* retainTexture(const std::string& filePath); // Cached or loaded, and taken off the unused list
+    void unreferenceTexture(const std::string& filePath);
+    void eraseCachedTexture(std::unordered_map<std::string, CachedTexture>::iterator it);
+    void setSlotTexture(TextureSlot& slot, const CachedTexture* entry);
+    TextureView resolveTexture(TextureHandle handle) const; // Empty view for invalid or stale handles
+    void drawTextureView(const TextureView& view, const SDL_Rect* srcRect, const SDL_FRect* dstRect, double angle,
+                         const SDL_FPoint* center, SDL_RendererFlip flip);
+    void enforceTextureBudget();
+    size_t getTextureCacheBytes() const { return m_textureCacheBytes + m_textureAtlas.getPageBytes(); }
+    void drawOverlay(const OverlayDrawData& overlay);
+    void bakeDecals(const std::vector<PointSprite>& decals);
+    void bakeMinimap(const MapManager& mapManager);
+    void uploadFogMask(const uint8_t* mask, int width, int height);
+    void expireDecalChunks();
+    size_t measureTextureMemory();
+    uint32_t getTileGid(size_t layerIndex, unsigned tileX, unsigned tileY) const;
+
+    void bindTilesetTextures(const MapManager& mapManager);
+    MapChunkLayer& getChunkLayer(const MapManager& mapManager, MapLayer layer);
+    bool bakeChunk(const MapManager& mapManager, const MapChunkLayer& chunkLayer, unsigned chunkX, unsigned chunkY, MapChunk& chunk);
+    void drawTiles(const MapManager& mapManager, size_t layerIndex, unsigned x0, unsigned y0, unsigned x1, unsigned y1, float offsetX, float offsetY);
+    static bool isLayerDrawnAs(const std::string& layerName, MapLayer layer);
 
+    bool initializeLibraries(); // SDL_image and SDL_ttf
     TTF_Font* getFont(const std::string& fontPath, int fontSize);
+    SDL_Texture* getSoftCircleTexture();
+    GlyphCache* getGlyphCache(const std::string& fontPath, int fontSize);
     SDL_Texture* generatePlaceholderTexture(int width, int height, const std::string& assetName);
 };
 
@@ -0,0 +1,74 @@
+#ifndef TUXARENA_SPRITEBATCH_H
+#define TUXARENA_SPRITEBATCH_H
+
+#include <SDL2/SDL.h>
+#include <cstddef>
+#include <vector>
+
+namespace TuxArena {
+
+// Axis-aligned sprite centered on (x, y), drawn with the whole texture tinted by color
+struct PointSprite {
+    float x, y;
+    float radius; // Half the quad size
+    SDL_Color color;
+};
+
+// Accumulates textured quads, colored quads and lines as triangles and submits them with one
+// SDL_RenderGeometry call per texture run. A batch is flushed when the texture or blend mode changes,
+// when the caller needs SDL state to be current (render target switch, immediate draws) and at frame end.
+// A blend mode other than SDL_BLENDMODE_INVALID is set on the texture at submission, so images sharing
+// an atlas page can be drawn with different modes; INVALID keeps the texture's own.
+// Coordinates are in screen (render target) pixels; the Renderer applies the camera beforehand.
+class SpriteBatch {
+public:
+    static constexpr size_t MAX_BATCH_VERTICES = 65536; // Flush threshold, keeps index values small
+
+    void setRenderer(SDL_Renderer* renderer) { m_renderer = renderer; }
+
+    void drawTexture(SDL_Texture* texture, const SDL_Rect* srcRect, const SDL_FRect& dstRect,
+                     double angle = 0.0, const SDL_FPoint* center = nullptr, SDL_RendererFlip flip = SDL_FLIP_NONE,
+                     SDL_Color tint = {255, 255, 255, 255}, SDL_BlendMode blendMode = SDL_BLENDMODE_INVALID);
+    void fillRect(const SDL_FRect& rect, SDL_Color color);
+    void drawRect(const SDL_FRect& rect, SDL_Color color); // 1px outline
+    void drawLine(float x1, float y1, float x2, float y2, SDL_Color color); // 1px wide
+    void fillCircle(float x, float y, float radius, SDL_Color color);
+    void drawCircle(float x, float y, float radius, SDL_Color color); // 1px outline
+
+    // Many sprites of one texture written straight into the vertex buffer. Positions are mapped
+    // with screen = (p - origin) * scale, so callers can pass world-space arrays with a camera transform.
+    void drawPointSprites(SDL_Texture* texture, const PointSprite* sprites, size_t count,
+                          SDL_FPoint origin = {0.0f, 0.0f}, float scale = 1.0f,
+                          SDL_BlendMode blendMode = SDL_BLENDMODE_INVALID);
+
+    // Submits everything queued so far
+    void flush();
+
+    // Statistics since the last resetStats() (typically once per frame)
+    size_t getDrawCallCount() const { return m_drawCalls; }
+    size_t getTriangleCount() const { return m_triangles; }
+    void resetStats() { m_drawCalls = 0; m_triangles = 0; }
+
+private:
+    SDL_Renderer* m_renderer = nullptr;
+    SDL_Texture* m_texture = nullptr; // Texture of the queued triangles (nullptr = untextured)
+    SDL_BlendMode m_blendMode = SDL_BLENDMODE_INVALID; // Set on m_texture at flush, unless INVALID
+    float m_textureWidth = 1.0f;      // Cached size of m_texture for UV computation
+    float m_textureHeight = 1.0f;
+    std::vector<SDL_Vertex> m_vertices;
+    std::vector<int> m_indices;
+
+    size_t m_drawCalls = 0;
+    size_t m_triangles = 0;
+    bool m_loggedError = false;
+
+    void setTexture(SDL_Texture* texture, SDL_BlendMode blendMode = SDL_BLENDMODE_INVALID);
+    void reserve(size_t vertexCount);
+    // Quad corners in order top-left, top-right, bottom-right, bottom-left
+    void pushQuad(const SDL_FPoint corners[4], const SDL_FPoint uvs[4], SDL_Color color);
+    static int circleSegments(float radius);
+};
+
+} // namespace TuxArena
+
+#endif // TUXARENA_SPRITEBATCH_H
@@ -0,0 +1,67 @@
+#ifndef TUXARENA_TEXTUREATLAS_H
+#define TUXARENA_TEXTUREATLAS_H
+
+#include <SDL2/SDL.h>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace TuxArena {
+
+// Packs small images into a few large texture pages at load time (skyline bottom-left packing) so
+// sprites from different assets share a texture and batch together. Each image is surrounded by
+// PADDING pixels copied from its own edge, so linear filtering never samples a neighbour.
+// remove() returns an image's cell to its page's free list, which add() tries before the skyline;
+// a page left without images is destroyed, so the atlas does not grow across map changes.
+class TextureAtlas {
+public:
+    static constexpr int PAGE_SIZE = 2048;      // Supported by every SDL2 backend
+    static constexpr int PADDING = 2;           // Extruded border around each image
+    static constexpr int MAX_IMAGE_SIZE = 1024; // Larger images keep their own texture
+
+    struct Region {
+        SDL_Texture* page = nullptr;
+        SDL_Rect rect = {0, 0, 0, 0}; // Image pixels inside the page, padding excluded
+    };
+
+    TextureAtlas() = default;
+    ~TextureAtlas();
+    TextureAtlas(const TextureAtlas&) = delete;
+    TextureAtlas& operator=(const TextureAtlas&) = delete;
+
+    void setRenderer(SDL_Renderer* renderer) { m_renderer = renderer; }
+
+    // Packs and uploads the surface under key. Returns nullptr if the image is too large or a page
+    // cannot be created; the caller then keeps a standalone texture. Adding an existing key returns its region.
+    const Region* add(const std::string& key, SDL_Surface* surface);
+    const Region* find(const std::string& key) const;
+    // Frees the key's cell. Draws already queued from its page must be flushed first if the page may go.
+    void remove(const std::string& key);
+
+    size_t getPageCount() const { return m_pages.size(); }
+    size_t getPageBytes() const { return m_pages.size() * static_cast<size_t>(PAGE_SIZE) * PAGE_SIZE * 4; }
+    void clear(); // Destroys all pages and regions
+
+private:
+    struct SkylineNode {
+        int x, y, width;
+    };
+    struct Page {
+        SDL_Texture* texture = nullptr;
+        std::vector<SkylineNode> skyline;
+        std::vector<SDL_Rect> freeCells; // Cells of removed images (padding included)
+        size_t imageCount = 0;
+    };
+
+    SDL_Renderer* m_renderer = nullptr;
+    std::vector<Page> m_pages;
+    std::unordered_map<std::string, Region> m_regions;
+
+    static bool pack(Page& page, int width, int height, SDL_Point& position);
+    static bool reuseFreeCell(Page& page, int width, int height, SDL_Point& position);
+    bool createPage();
+};
+
+} // namespace TuxArena
+
+#endif // TUXARENA_TEXTUREATLAS_H
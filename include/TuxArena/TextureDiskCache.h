@@ -0,0 +1,64 @@
+#ifndef TUXARENA_TEXTUREDISKCACHE_H
+#define TUXARENA_TEXTUREDISKCACHE_H
+
+#include <SDL2/SDL.h>
+#include <cstdint>
+#include <string>
+
+namespace TuxArena {
+
+// On-disk cache of decoded images, so PNGs are only inflated the first time they are seen.
+// Each source image maps to one file in the cache directory, named after a hash of its path, that
+// holds a small header (source size and modification time, path hash) and the raw RGBA32 pixels.
+// A hit is one read straight into a new surface; an entry whose source changed since it was
+// written is decoded again and replaced, so editing a PNG needs no manual cache clearing.
+// The directory is kept under MAX_BYTES by deleting the least recently used entries (hits refresh
+// an entry's modification time), which also clears out entries of images that no longer exist.
+class TextureDiskCache {
+public:
+    static constexpr uint64_t DEFAULT_MAX_BYTES = 256ull * 1024 * 1024;
+
+    // An empty directory means "textures" in the user's SDL_GetPrefPath() directory, which is
+    // writable wherever the game is installed or started from
+    explicit TextureDiskCache(std::string directory = std::string());
+
+    // Decoded RGBA32 surface for the image (caller frees), or nullptr when the image cannot be loaded
+    SDL_Surface* load(const std::string& sourcePath);
+
+    void setEnabled(bool enabled) { m_enabled = enabled; }
+    void setMaxBytes(uint64_t bytes) { m_maxBytes = bytes; }
+    bool isEnabled() const { return m_enabled; }
+    size_t getHitCount() const { return m_hits; }
+    size_t getMissCount() const { return m_misses; }
+
+private:
+    struct Header {
+        char magic[4];
+        uint32_t version;
+        uint32_t width;
+        uint32_t height;
+        uint64_t pathHash;
+        uint64_t sourceSize;
+        int64_t sourceModified; // Filesystem clock ticks
+    };
+    static constexpr uint32_t FORMAT_VERSION = 1;
+
+    std::string m_directory;
+    bool m_enabled = true;
+    bool m_directoryResolved = false;
+    bool m_directoryReady = false;
+    uint64_t m_maxBytes = DEFAULT_MAX_BYTES;
+    uint64_t m_directoryBytes = 0; // Entries on disk, measured by the first write, then kept up to date
+    size_t m_hits = 0;
+    size_t m_misses = 0;
+
+    bool resolveDirectory();
+    std::string getEntryPath(uint64_t pathHash) const;
+    void prune(uint64_t targetBytes);
+    SDL_Surface* readEntry(const std::string& entryPath, const Header& expected);
+    void writeEntry(const std::string& entryPath, const Header& header, SDL_Surface* surface);
+};
+
+} // namespace TuxArena
+
+#endif // TUXARENA_TEXTUREDISKCACHE_H
@@ -0,0 +1,23 @@
+#ifndef TUXARENA_TEXTUREHANDLE_H
+#define TUXARENA_TEXTUREHANDLE_H
+
+#include <cstdint>
+
+namespace TuxArena {
+
+// Reference to a texture owned by the Renderer, resolved once at load time with
+// Renderer::acquireTexture() and looked up in O(1) on the draw path. A released slot is
+// reused with a new generation, so a stale handle resolves to nullptr instead of another texture.
+struct TextureHandle {
+    uint32_t index = 0;      // Slot in the Renderer's texture table
+    uint32_t generation = 0; // 0 = invalid handle
+
+    bool isValid() const { return generation != 0; }
+    explicit operator bool() const { return isValid(); }
+    bool operator==(const TextureHandle& other) const { return index == other.index && generation == other.generation; }
+    bool operator!=(const TextureHandle& other) const { return !(*this == other); }
+};
+
+} // namespace TuxArena
+
+#endif // TUXARENA_TEXTUREHANDLE_H
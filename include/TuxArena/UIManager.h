@@ -7,6 +7,7 @@
 // Forward declarations
 typedef struct SDL_Window SDL_Window;
 typedef struct SDL_Renderer SDL_Renderer;
+struct ImGuiContext;
 
 namespace TuxArena {
 
@@ -38,8 +39,9 @@ public:
     UIManager(Game* game);
     ~UIManager();
 
-    // Initialize ImGui context (should be called once at app startup)
-    bool initialize(SDL_Window* window, SDL_Renderer* renderer);
+    // Sets up the UI in the renderer's ImGui context (Renderer::getImGuiContext()), which owns the
+    // backends; should be called once at app startup
+    bool initialize(SDL_Window* window, SDL_Renderer* renderer, ImGuiContext* context);
     void shutdown();
 
     void render(GameState currentState);
@@ -65,6 +67,7 @@ private:
     Game* m_game;
     SDL_Window* m_sdlWindow = nullptr;
     SDL_Renderer* m_sdlRenderer = nullptr;
+    ImGuiContext* m_imguiContext = nullptr; // Owned by the Renderer
     UIEventData m_lastUIEvent; // Stores the last event triggered by UI
 
     std::string m_networkStatus; // Status string from NetworkClient/Server
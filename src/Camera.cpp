@@ -0,0 +1,64 @@
+// src/Camera.cpp
+#include "TuxArena/Camera.h"
+
+#include <algorithm> // For std::min, std::max
+
+namespace TuxArena {
+
+void Camera::setViewport(int width, int height) {
+    m_viewportWidth = std::max(0, width);
+    m_viewportHeight = std::max(0, height);
+}
+
+void Camera::setZoom(float zoom) {
+    m_zoom = std::max(MIN_ZOOM, std::min(MAX_ZOOM, zoom));
+}
+
+void Camera::clampToBounds(float worldWidth, float worldHeight) {
+    float halfWidth = static_cast<float>(m_viewportWidth) * 0.5f / m_zoom;
+    float halfHeight = static_cast<float>(m_viewportHeight) * 0.5f / m_zoom;
+
+    if (worldWidth <= halfWidth * 2.0f) {
+        m_position.x = worldWidth * 0.5f;
+    } else {
+        m_position.x = std::max(halfWidth, std::min(worldWidth - halfWidth, m_position.x));
+    }
+    if (worldHeight <= halfHeight * 2.0f) {
+        m_position.y = worldHeight * 0.5f;
+    } else {
+        m_position.y = std::max(halfHeight, std::min(worldHeight - halfHeight, m_position.y));
+    }
+}
+
+Vec2 Camera::getTopLeft() const {
+    return {m_position.x - static_cast<float>(m_viewportWidth) * 0.5f / m_zoom,
+            m_position.y - static_cast<float>(m_viewportHeight) * 0.5f / m_zoom};
+}
+
+Vec2 Camera::worldToScreen(const Vec2& world) const {
+    Vec2 topLeft = getTopLeft();
+    return {(world.x - topLeft.x) * m_zoom, (world.y - topLeft.y) * m_zoom};
+}
+
+Vec2 Camera::screenToWorld(const Vec2& screen) const {
+    Vec2 topLeft = getTopLeft();
+    return {screen.x / m_zoom + topLeft.x, screen.y / m_zoom + topLeft.y};
+}
+
+SDL_FRect Camera::worldToScreen(const SDL_FRect& world) const {
+    Vec2 topLeft = getTopLeft();
+    return {(world.x - topLeft.x) * m_zoom, (world.y - topLeft.y) * m_zoom, world.w * m_zoom, world.h * m_zoom};
+}
+
+SDL_FRect Camera::getVisibleWorldRect() const {
+    Vec2 topLeft = getTopLeft();
+    return {topLeft.x, topLeft.y, static_cast<float>(m_viewportWidth) / m_zoom, static_cast<float>(m_viewportHeight) / m_zoom};
+}
+
+bool Camera::isVisible(const SDL_FRect& worldRect) const {
+    SDL_FRect view = getVisibleWorldRect();
+    return worldRect.x < view.x + view.w && worldRect.x + worldRect.w > view.x &&
+           worldRect.y < view.y + view.h && worldRect.y + worldRect.h > view.y;
+}
+
+} // namespace TuxArena
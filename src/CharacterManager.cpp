@@ -54,10 +54,8 @@ namespace TuxArena
     {
         Log::Info("CharacterManager: Shutting down...");
         for (auto& charInfo : m_availableCharacters) {
-            if (charInfo.texture) {
-                m_renderer->destroyTexture(charInfo.texture);
-                charInfo.texture = nullptr;
-            }
+            m_renderer->releaseTexture(charInfo.texture);
+            charInfo.texture = {};
         }
         m_availableCharacters.clear();
         m_characterIdToIndex.clear();
@@ -113,8 +111,11 @@ namespace TuxArena
             ImGui::PushID(charInfo.id.c_str());
 
             // Display character image
-            if (charInfo.texture) {
-                ImGui::Image(static_cast<ImTextureID>(renderer.getOpenGLTextureID(charInfo.texture)), ImVec2(buttonSize, buttonSize));
+            SDL_Texture* image = nullptr;
+            SDL_FRect uv; // Atlased portraits are a region of a shared page
+            if (charInfo.texture && renderer.getTextureImage(charInfo.texture, image, uv)) {
+                ImGui::Image(static_cast<ImTextureID>(renderer.getOpenGLTextureID(image)), ImVec2(buttonSize, buttonSize),
+                             ImVec2(uv.x, uv.y), ImVec2(uv.x + uv.w, uv.y + uv.h));
             } else {
                 ImGui::Dummy(ImVec2(buttonSize, buttonSize)); // Placeholder if texture not loaded
                 ImGui::Text("No Image");
@@ -167,10 +168,8 @@ namespace TuxArena
             Log::Warning("Character with ID '" + charInfo.id + "' already exists. Overwriting.");
             // Find existing entry and update it
             size_t index = m_characterIdToIndex[charInfo.id];
-            // Destroy old texture if it exists
-            if (m_availableCharacters[index].texture) {
-                m_renderer->destroyTexture(m_availableCharacters[index].texture);
-            }
+            // Release the old texture reference
+            m_renderer->releaseTexture(m_availableCharacters[index].texture);
             m_availableCharacters[index] = charInfo;
         } else {
             m_availableCharacters.push_back(charInfo);
@@ -202,7 +201,7 @@ namespace TuxArena
                         charInfo.id = fileName;
                         charInfo.name = fileName;
                         charInfo.texturePath = filePath;
-                        charInfo.texture = m_renderer->loadTexture(filePath);
+                        charInfo.texture = m_renderer->acquireTexture(filePath);
 
                         if (charInfo.texture) {
                             addCharacterDefinition(charInfo);
@@ -224,9 +223,9 @@ namespace TuxArena
                 if (!charInfo.texturePath.empty()) {
                     std::filesystem::path texPath = charInfo.texturePath;
                     if (texPath.is_relative()) {
-                        charInfo.texture = m_renderer->loadTexture(ASSETS_DIR + charInfo.texturePath);
+                        charInfo.texture = m_renderer->acquireTexture(ASSETS_DIR + charInfo.texturePath);
                     } else {
-                        charInfo.texture = m_renderer->loadTexture(charInfo.texturePath);
+                        charInfo.texture = m_renderer->acquireTexture(charInfo.texturePath);
                     }
                 }
 
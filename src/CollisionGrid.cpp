@@ -0,0 +1,86 @@
+// src/CollisionGrid.cpp
+#include "TuxArena/CollisionGrid.h"
+
+#include <algorithm> // For std::min, std::max
+#include <cmath>     // For std::floor
+
+namespace TuxArena {
+
+void CollisionGrid::reset(unsigned widthTiles, unsigned heightTiles, unsigned tileWidth, unsigned tileHeight) {
+    m_width = static_cast<int>(widthTiles);
+    m_height = static_cast<int>(heightTiles);
+    m_tileWidth = tileWidth;
+    m_tileHeight = tileHeight;
+    m_tiles.assign(static_cast<size_t>(widthTiles) * heightTiles, 0);
+}
+
+void CollisionGrid::clear() {
+    m_tiles.clear();
+    m_width = 0;
+    m_height = 0;
+    m_tileWidth = 0;
+    m_tileHeight = 0;
+}
+
+bool CollisionGrid::isSolidAt(float x, float y) const {
+    if (m_tileWidth == 0 || m_tileHeight == 0) return false;
+    int tileX = static_cast<int>(std::floor(x / m_tileWidth));
+    int tileY = static_cast<int>(std::floor(y / m_tileHeight));
+    return isSolid(tileX, tileY);
+}
+
+void CollisionGrid::setSolid(int tileX, int tileY, bool solid) {
+    if (tileX < 0 || tileY < 0 || tileX >= m_width || tileY >= m_height) return;
+    m_tiles[static_cast<size_t>(tileY) * m_width + tileX] = solid ? 1 : 0;
+}
+
+bool CollisionShape::contains(float x, float y, float tolerance) const {
+    if (x < minX - tolerance || x > maxX + tolerance || y < minY - tolerance || y > maxY + tolerance) {
+        return false;
+    }
+
+    switch (type) {
+        case Type::Rectangle:
+            return true; // Inside the (tolerance-expanded) bounding box
+
+        case Type::Ellipse: {
+            float rx = (maxX - minX) * 0.5f + tolerance;
+            float ry = (maxY - minY) * 0.5f + tolerance;
+            if (rx <= 0.0f || ry <= 0.0f) return false;
+            float nx = (x - (minX + maxX) * 0.5f) / rx;
+            float ny = (y - (minY + maxY) * 0.5f) / ry;
+            return nx * nx + ny * ny <= 1.0f;
+        }
+
+        case Type::Polygon: {
+            // Even-odd crossing test
+            bool inside = false;
+            for (size_t i = 0, j = points.size() - 1; i < points.size(); j = i++) {
+                const Vec2& a = points[i];
+                const Vec2& b = points[j];
+                if (((a.y > y) != (b.y > y)) && (x < (b.x - a.x) * (y - a.y) / (b.y - a.y) + a.x)) {
+                    inside = !inside;
+                }
+            }
+            return inside;
+        }
+
+        case Type::Polyline: {
+            float toleranceSq = tolerance * tolerance;
+            for (size_t i = 1; i < points.size(); ++i) {
+                const Vec2& a = points[i - 1];
+                const Vec2& b = points[i];
+                float abx = b.x - a.x, aby = b.y - a.y;
+                float lengthSq = abx * abx + aby * aby;
+                float t = lengthSq > 0.0f ? ((x - a.x) * abx + (y - a.y) * aby) / lengthSq : 0.0f;
+                t = std::max(0.0f, std::min(1.0f, t));
+                float dx = a.x + abx * t - x, dy = a.y + aby * t - y;
+                if (dx * dx + dy * dy <= toleranceSq) return true;
+            }
+            return false;
+        }
+    }
+    return false;
+}
+
+} // namespace TuxArena
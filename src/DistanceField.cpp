@@ -0,0 +1,277 @@
+// src/DistanceField.cpp
+#include "TuxArena/DistanceField.h"
+#include "TuxArena/CollisionGrid.h"
+#include "TuxArena/Log.h"
+
+#include <algorithm> // For std::min, std::max
+#include <cmath>     // For std::sqrt, std::floor, std::ceil, std::lround
+
+namespace TuxArena {
+
+namespace {
+
+constexpr float EDT_INF = 1e20f;
+
+// Felzenszwalb-Huttenlocher 1D squared Euclidean distance transform.
+// f: input costs (0 at features, EDT_INF elsewhere), d: output, v/z: scratch (n and n+1 entries).
+void distanceTransform1D(const float* f, int n, float* d, int* v, float* z) {
+    int k = 0;
+    v[0] = 0;
+    z[0] = -EDT_INF;
+    z[1] = EDT_INF;
+    for (int q = 1; q < n; ++q) {
+        float s = ((f[q] + static_cast<float>(q * q)) - (f[v[k]] + static_cast<float>(v[k] * v[k]))) / static_cast<float>(2 * q - 2 * v[k]);
+        while (s <= z[k]) {
+            --k;
+            s = ((f[q] + static_cast<float>(q * q)) - (f[v[k]] + static_cast<float>(v[k] * v[k]))) / static_cast<float>(2 * q - 2 * v[k]);
+        }
+        ++k;
+        v[k] = q;
+        z[k] = s;
+        z[k + 1] = EDT_INF;
+    }
+    k = 0;
+    for (int q = 0; q < n; ++q) {
+        while (z[k + 1] < static_cast<float>(q)) ++k;
+        float dq = static_cast<float>(q - v[k]);
+        d[q] = dq * dq + f[v[k]];
+    }
+}
+
+// 2D squared distance transform of a w*h grid, in place (columns, then rows).
+void distanceTransform2D(std::vector<float>& grid, int w, int h) {
+    int n = std::max(w, h);
+    std::vector<float> f(n), d(n), z(n + 1);
+    std::vector<int> v(n);
+
+    for (int x = 0; x < w; ++x) {
+        for (int y = 0; y < h; ++y) f[y] = grid[static_cast<size_t>(y) * w + x];
+        distanceTransform1D(f.data(), h, d.data(), v.data(), z.data());
+        for (int y = 0; y < h; ++y) grid[static_cast<size_t>(y) * w + x] = d[y];
+    }
+    for (int y = 0; y < h; ++y) {
+        float* row = grid.data() + static_cast<size_t>(y) * w;
+        std::copy(row, row + w, f.begin());
+        distanceTransform1D(f.data(), w, d.data(), v.data(), z.data());
+        std::copy(d.begin(), d.begin() + w, row);
+    }
+}
+
+} // anonymous namespace
+
+bool DistanceField::build(const CollisionGrid& grid, const std::vector<CollisionShape>& shapes, int texelsPerTile) {
+    clear();
+
+    unsigned tileWidth = grid.getTileWidth();
+    unsigned tileHeight = grid.getTileHeight();
+    if (grid.isEmpty() || tileWidth == 0 || tileHeight == 0 || texelsPerTile <= 0) {
+        Log::Warning("DistanceField::build called without a valid map. Skipping.");
+        return false;
+    }
+
+    m_texelSize = static_cast<float>(std::min(tileWidth, tileHeight)) / static_cast<float>(texelsPerTile);
+    m_invTexelSize = 1.0f / m_texelSize;
+    m_width = static_cast<int>(std::ceil(static_cast<float>(grid.getWidth() * tileWidth) * m_invTexelSize)) + 2;
+    m_height = static_cast<int>(std::ceil(static_cast<float>(grid.getHeight() * tileHeight) * m_invTexelSize)) + 2;
+
+    m_occupancy.assign(static_cast<size_t>(m_width) * m_height, 1);
+    rasterize(grid, shapes, 1, 1, m_width - 1, m_height - 1);
+    m_distances.assign(m_occupancy.size(), 0);
+    computeRegion(0, 0, m_width, m_height);
+
+    Log::Info("Built distance field: " + std::to_string(m_width) + "x" + std::to_string(m_height) + " texels, " + std::to_string(m_texelSize) + " px per texel.");
+    return true;
+}
+
+void DistanceField::clear() {
+    m_width = 0;
+    m_height = 0;
+    m_texelSize = 0.0f;
+    m_invTexelSize = 0.0f;
+    m_occupancy.clear();
+    m_distances.clear();
+    m_dirtyRegions.clear();
+}
+
+void DistanceField::rasterize(const CollisionGrid& grid, const std::vector<CollisionShape>& shapes, int x0, int y0, int x1, int y1) {
+    // Interior texels in [x0,x1) x [y0,y1) take their value from the tile bitmap (border stays solid)
+    for (int ty = y0; ty < y1; ++ty) {
+        float cy = (static_cast<float>(ty) - 0.5f) * m_texelSize;
+        for (int tx = x0; tx < x1; ++tx) {
+            float cx = (static_cast<float>(tx) - 0.5f) * m_texelSize;
+            m_occupancy[static_cast<size_t>(ty) * m_width + tx] = grid.isSolidAt(cx, cy) ? 1 : 0;
+        }
+    }
+
+    // Collision shapes are rasterized at texel resolution, so sub-tile shapes keep their outline
+    float lineTolerance = m_texelSize * 0.5f;
+    for (const auto& shape : shapes) {
+        float tolerance = shape.type == CollisionShape::Type::Polyline ? lineTolerance : 0.0f;
+        int sx0 = std::max(x0, static_cast<int>(std::floor((shape.minX - tolerance) * m_invTexelSize + 0.5f)));
+        int sy0 = std::max(y0, static_cast<int>(std::floor((shape.minY - tolerance) * m_invTexelSize + 0.5f)));
+        int sx1 = std::min(x1 - 1, static_cast<int>(std::ceil((shape.maxX + tolerance) * m_invTexelSize + 0.5f)));
+        int sy1 = std::min(y1 - 1, static_cast<int>(std::ceil((shape.maxY + tolerance) * m_invTexelSize + 0.5f)));
+        for (int ty = sy0; ty <= sy1; ++ty) {
+            float cy = (static_cast<float>(ty) - 0.5f) * m_texelSize;
+            for (int tx = sx0; tx <= sx1; ++tx) {
+                float cx = (static_cast<float>(tx) - 0.5f) * m_texelSize;
+                if (shape.contains(cx, cy, tolerance)) {
+                    m_occupancy[static_cast<size_t>(ty) * m_width + tx] = 1;
+                }
+            }
+        }
+    }
+}
+
+void DistanceField::invalidateRegion(const CollisionGrid& grid, const std::vector<CollisionShape>& shapes,
+                                     float minX, float minY, float maxX, float maxY) {
+    if (m_distances.empty()) return;
+
+    // Texel i covers world [(i - 1) * texelSize, i * texelSize)
+    DirtyRegion region;
+    region.x0 = std::max(1, static_cast<int>(std::floor(minX * m_invTexelSize)) + 1);
+    region.y0 = std::max(1, static_cast<int>(std::floor(minY * m_invTexelSize)) + 1);
+    region.x1 = std::min(m_width - 1, static_cast<int>(std::ceil(maxX * m_invTexelSize)) + 1);
+    region.y1 = std::min(m_height - 1, static_cast<int>(std::ceil(maxY * m_invTexelSize)) + 1);
+    if (region.x0 >= region.x1 || region.y0 >= region.y1) return;
+
+    rasterize(grid, shapes, region.x0, region.y0, region.x1, region.y1);
+
+    // Distances change up to MAX_DISTANCE_TEXELS away from the edited texels
+    region.x0 = std::max(0, region.x0 - MAX_DISTANCE_TEXELS);
+    region.y0 = std::max(0, region.y0 - MAX_DISTANCE_TEXELS);
+    region.x1 = std::min(m_width, region.x1 + MAX_DISTANCE_TEXELS);
+    region.y1 = std::min(m_height, region.y1 + MAX_DISTANCE_TEXELS);
+
+    // Coalesce with a queued region when the union is not much larger than both
+    // (neighbouring edits from one explosion end up in a single transform)
+    for (auto& queued : m_dirtyRegions) {
+        DirtyRegion merged = {std::min(queued.x0, region.x0), std::min(queued.y0, region.y0),
+                              std::max(queued.x1, region.x1), std::max(queued.y1, region.y1)};
+        if (regionCost(merged) <= regionCost(queued) + regionCost(region)) {
+            queued = merged;
+            return;
+        }
+    }
+    m_dirtyRegions.push_back(region);
+}
+
+int DistanceField::rebuildDirty(int texelBudget) {
+    int spent = 0;
+    while (!m_dirtyRegions.empty() && (spent == 0 || spent < texelBudget)) {
+        DirtyRegion region = m_dirtyRegions.front();
+        m_dirtyRegions.erase(m_dirtyRegions.begin());
+        computeRegion(region.x0, region.y0, region.x1, region.y1);
+        spent += regionCost(region);
+    }
+    return spent;
+}
+
+int DistanceField::regionCost(const DirtyRegion& region) const {
+    // computeRegion() transforms the region padded by the clamp margin
+    const int margin = MAX_DISTANCE_TEXELS + 1;
+    int w = std::min(m_width, region.x1 + margin) - std::max(0, region.x0 - margin);
+    int h = std::min(m_height, region.y1 + margin) - std::max(0, region.y0 - margin);
+    return std::max(0, w) * std::max(0, h);
+}
+
+void DistanceField::computeRegion(int x0, int y0, int x1, int y1) {
+    // Values are clamped to MAX_DISTANCE_TEXELS, so texels in [x0,x1) x [y0,y1) only depend
+    // on occupancy within that margin. Transform a window padded by the margin.
+    const int margin = MAX_DISTANCE_TEXELS + 1;
+    int wx0 = std::max(0, x0 - margin);
+    int wy0 = std::max(0, y0 - margin);
+    int wx1 = std::min(m_width, x1 + margin);
+    int wy1 = std::min(m_height, y1 + margin);
+    int ww = wx1 - wx0;
+    int wh = wy1 - wy0;
+    if (ww <= 0 || wh <= 0) return;
+
+    std::vector<float> outside(static_cast<size_t>(ww) * wh);
+    std::vector<float> inside(static_cast<size_t>(ww) * wh);
+    for (int y = 0; y < wh; ++y) {
+        for (int x = 0; x < ww; ++x) {
+            bool solid = m_occupancy[static_cast<size_t>(wy0 + y) * m_width + (wx0 + x)] != 0;
+            outside[static_cast<size_t>(y) * ww + x] = solid ? 0.0f : EDT_INF;
+            inside[static_cast<size_t>(y) * ww + x] = solid ? EDT_INF : 0.0f;
+        }
+    }
+    distanceTransform2D(outside, ww, wh);
+    distanceTransform2D(inside, ww, wh);
+
+    // Distances are measured between texel centers; subtract half a texel to place the surface on the boundary
+    const float maxDistance = static_cast<float>(MAX_DISTANCE_TEXELS) * m_texelSize;
+    for (int y = y0; y < y1; ++y) {
+        for (int x = x0; x < x1; ++x) {
+            size_t windowIndex = static_cast<size_t>(y - wy0) * ww + (x - wx0);
+            size_t index = static_cast<size_t>(y) * m_width + x;
+            float texels = m_occupancy[index]
+                ? -(std::sqrt(inside[windowIndex]) - 0.5f)
+                : (std::sqrt(outside[windowIndex]) - 0.5f);
+            float pixels = std::max(-maxDistance, std::min(maxDistance, texels * m_texelSize));
+            m_distances[index] = static_cast<int16_t>(std::lround(pixels * DISTANCE_SCALE));
+        }
+    }
+}
+
+bool DistanceField::sample(float x, float y, float* outDistance, Vec2* outGradient) const {
+    if (m_distances.empty()) return false;
+
+    // Texel i (including the border) is centered at world (i - 0.5) * texelSize
+    float gx = std::max(0.0f, std::min(x * m_invTexelSize + 0.5f, static_cast<float>(m_width - 1)));
+    float gy = std::max(0.0f, std::min(y * m_invTexelSize + 0.5f, static_cast<float>(m_height - 1)));
+    int ix = std::min(static_cast<int>(gx), m_width - 2);
+    int iy = std::min(static_cast<int>(gy), m_height - 2);
+    float fx = gx - static_cast<float>(ix);
+    float fy = gy - static_cast<float>(iy);
+
+    const int16_t* row0 = m_distances.data() + static_cast<size_t>(iy) * m_width + ix;
+    const int16_t* row1 = row0 + m_width;
+    float d00 = row0[0], d10 = row0[1];
+    float d01 = row1[0], d11 = row1[1];
+
+    const float toPixels = 1.0f / DISTANCE_SCALE;
+    if (outDistance) {
+        float top = d00 + (d10 - d00) * fx;
+        float bottom = d01 + (d11 - d01) * fx;
+        *outDistance = (top + (bottom - top) * fy) * toPixels;
+    }
+    if (outGradient) {
+        float dx = (d10 - d00) * (1.0f - fy) + (d11 - d01) * fy;
+        float dy = (d01 - d00) * (1.0f - fx) + (d11 - d10) * fx;
+        float length = std::sqrt(dx * dx + dy * dy);
+        if (length > 1e-6f) {
+            *outGradient = {dx / length, dy / length};
+        } else {
+            *outGradient = {0.0f, 0.0f};
+        }
+    }
+    return true;
+}
+
+float DistanceField::sampleDistance(float x, float y) const {
+    float distance = static_cast<float>(MAX_DISTANCE_TEXELS) * m_texelSize;
+    sample(x, y, &distance, nullptr);
+    return distance;
+}
+
+Vec2 DistanceField::sampleGradient(float x, float y) const {
+    Vec2 gradient = {0.0f, 0.0f};
+    sample(x, y, nullptr, &gradient);
+    return gradient;
+}
+
+bool DistanceField::resolveCircle(Vec2& center, float radius, int maxIterations) const {
+    bool touched = false;
+    for (int i = 0; i < maxIterations; ++i) {
+        float distance = 0.0f;
+        Vec2 normal = {0.0f, 0.0f};
+        if (!sample(center.x, center.y, &distance, &normal) || distance >= radius) break;
+        touched = true;
+        if (normal.x == 0.0f && normal.y == 0.0f) break; // Deep inside a flat region, no direction to push
+        center += normal * (radius - distance);
+    }
+    return touched;
+}
+
+} // namespace TuxArena
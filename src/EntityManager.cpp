@@ -14,7 +14,10 @@
 #include "TuxArena/Entity.h"      // Base entity class and EntityContext
 #include "TuxArena/MapManager.h"  // Needed for initialization
 #include "TuxArena/Renderer.h"    // Needed for render methods
+#include "TuxArena/RenderSnapshot.h" // For RenderLayer
 #include "TuxArena/Log.h"
+#include "TuxArena/Profiler.h"
+#include "imgui.h"
 
 // --- Include Headers for ALL Derived Entity Types ---
 // These are required for the factory method (createEntity).
@@ -213,37 +216,56 @@ void EntityManager::update(const EntityContext& context) {
         }
     }
 
-    m_particleManager.update(context.deltaTime);
+    {
+        Profiler::Scope particleScope(context.profiler, ProfileStage::Particles);
+        m_particleManager.update(context.deltaTime);
+    }
 
     processDestructionQueue();
 }
 
 void EntityManager::render(Renderer& renderer) {
-    // Render all active entities
+    // Render all active entities that overlap the view. Bounds are conservative (center +/- largest extent)
+    // so rotated sprites are never culled early.
     for (const auto& entity : m_entities) {
         if (entity && entity->isActive()) {
+            Vec2 pos = entity->getPosition();
+            Vec2 size = entity->getSize();
+            float extent = std::max(size.x, size.y);
+            SDL_FRect bounds = {pos.x - extent, pos.y - extent, extent * 2.0f, extent * 2.0f};
+            if (!renderer.isVisible(bounds)) continue;
             entity->render(renderer);
         }
     }
 
+    renderer.setDrawLayer(RenderLayer::Effects); // Drawn over entities, grouped by texture
     m_particleManager.render(renderer);
+    renderer.setDrawLayer(RenderLayer::World);
 }
 
 void EntityManager::renderDebug(Renderer& renderer) {
      (void)renderer; // Suppress unused parameter warning
      if (!m_isInitialized) return;
-     // Render debug info for all active entities
+     // Entity and particle section of the perf overlay; called inside its ImGui window
+     static const char* const typeNames[] = {"Generic", "Player", "Bullet", "Rocket", "Health", "Ammo", "Trigger", "Decoration"};
+     constexpr size_t typeCount = sizeof(typeNames) / sizeof(typeNames[0]);
+     size_t activeCounts[typeCount] = {};
+     size_t active = 0;
      for (const auto& entityPtr : m_entities) {
-         if (entityPtr && entityPtr->isActive()) {
-             // Assuming entities might have a renderDebug method
-             // entityPtr->renderDebug(renderer);
-
-             // Example: Draw bounding boxes using a helper if available
-             // SDL_FRect aabb = entityPtr->getAABB(); // Assuming getAABB exists
-             // renderer.drawRectOutline(&aabb, {0, 255, 0, 150}); // Green outline
-         }
+         if (!entityPtr || !entityPtr->isActive()) continue;
+         size_t type = static_cast<size_t>(entityPtr->getType());
+         if (type < typeCount) ++activeCounts[type];
+         ++active;
+     }
+
+     ImGui::Text("Entities: %zu active of %zu", active, m_entities.size());
+     for (size_t type = 0; type < typeCount; ++type) {
+         if (activeCounts[type] > 0) ImGui::Text("  %-10s %zu", typeNames[type], activeCounts[type]);
      }
-      Log::Info("Rendered debug info for " + std::to_string(m_entities.size()) + " potential entities.");
+     ImGui::Text("Particles: %zu / %zu (quality %.0f%%)", m_particleManager.getParticleCount(),
+                 m_particleManager.getBudget(), m_particleManager.getQuality() * 100.0f);
+     ImGui::Text("  Blood %zu, trails %zu (%s kernels)", m_particleManager.getParticleCount(ParticleType::Blood),
+                 m_particleManager.getParticleCount(ParticleType::BulletTrail), getParticleKernelName());
 }
 
 std::vector<Entity*> EntityManager::getActiveEntities() const {
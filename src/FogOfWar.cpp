@@ -0,0 +1,95 @@
+// src/FogOfWar.cpp
+#include "TuxArena/FogOfWar.h"
+#include "TuxArena/CollisionGrid.h"
+
+#include <algorithm> // For std::fill, std::max
+#include <cmath>     // For std::floor
+
+namespace TuxArena {
+
+namespace {
+// Octant transforms (xx, xy, yx, yy) mapping the scanned octant onto the grid
+constexpr int OCTANTS[8][4] = {
+    { 1,  0,  0,  1}, { 0,  1,  1,  0}, { 0, -1,  1,  0}, {-1,  0,  0,  1},
+    {-1,  0,  0, -1}, { 0, -1, -1,  0}, { 0,  1, -1,  0}, { 1,  0,  0, -1}
+};
+} // anonymous namespace
+
+void FogOfWar::setRadius(int radiusTiles) {
+    m_radius = std::max(1, radiusTiles);
+    invalidate();
+}
+
+bool FogOfWar::update(const CollisionGrid& grid, const Vec2& position, size_t editCount) {
+    if (grid.isEmpty() || grid.getTileWidth() == 0 || grid.getTileHeight() == 0) return false;
+    int originX = static_cast<int>(std::floor(position.x / grid.getTileWidth()));
+    int originY = static_cast<int>(std::floor(position.y / grid.getTileHeight()));
+    if (m_grid == &grid && originX == m_originX && originY == m_originY && editCount == m_editCount &&
+        m_width == grid.getWidth() && m_height == grid.getHeight()) {
+        return false;
+    }
+
+    m_grid = &grid;
+    m_originX = originX;
+    m_originY = originY;
+    m_editCount = editCount;
+    m_width = grid.getWidth();
+    m_height = grid.getHeight();
+    m_mask.assign(static_cast<size_t>(m_width) * m_height, 0);
+
+    if (originX >= 0 && originY >= 0 && originX < m_width && originY < m_height) {
+        m_mask[static_cast<size_t>(originY) * m_width + originX] = 255;
+        for (const auto& octant : OCTANTS) {
+            castOctant(1, 1.0f, 0.0f, octant[0], octant[1], octant[2], octant[3]);
+        }
+    }
+    ++m_revision;
+    if (m_revision == 0) m_revision = 1; // 0 is reserved for "never computed"
+    return true;
+}
+
+bool FogOfWar::isVisible(int tileX, int tileY) const {
+    if (tileX < 0 || tileY < 0 || tileX >= m_width || tileY >= m_height) return false;
+    return m_mask[static_cast<size_t>(tileY) * m_width + tileX] != 0;
+}
+
+void FogOfWar::castOctant(int row, float startSlope, float endSlope, int xx, int xy, int yx, int yy) {
+    if (startSlope < endSlope) return;
+    const int radiusSquared = m_radius * m_radius;
+    float nextStartSlope = startSlope;
+    for (int distance = row; distance <= m_radius; ++distance) {
+        bool blocked = false;
+        int dy = -distance;
+        for (int dx = -distance; dx <= 0; ++dx) {
+            // Slopes through the left and right edges of the tile
+            float leftSlope = (dx - 0.5f) / (dy + 0.5f);
+            float rightSlope = (dx + 0.5f) / (dy - 0.5f);
+            if (startSlope < rightSlope) continue;
+            if (endSlope > leftSlope) break;
+
+            int tileX = m_originX + dx * xx + dy * xy;
+            int tileY = m_originY + dx * yx + dy * yy;
+            bool solid = m_grid->isSolid(tileX, tileY); // Outside the map counts as solid
+            if (dx * dx + dy * dy < radiusSquared && tileX >= 0 && tileY >= 0 && tileX < m_width && tileY < m_height) {
+                m_mask[static_cast<size_t>(tileY) * m_width + tileX] = 255;
+            }
+
+            if (blocked) {
+                if (solid) {
+                    nextStartSlope = rightSlope;
+                } else {
+                    blocked = false;
+                    startSlope = nextStartSlope;
+                }
+            } else if (solid && distance < m_radius) {
+                // Scan the part of the next rows that this wall does not shadow
+                blocked = true;
+                nextStartSlope = rightSlope;
+                castOctant(distance + 1, startSlope, leftSlope, xx, xy, yx, yy);
+            }
+        }
+        if (blocked) break;
+    }
+}
+
+} // namespace TuxArena
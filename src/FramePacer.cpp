@@ -0,0 +1,110 @@
+// src/FramePacer.cpp
+#include "TuxArena/FramePacer.h"
+
+#include <algorithm> // For std::max, std::min, std::clamp
+#include <cmath>     // For std::sqrt
+#include <thread>    // For std::this_thread::sleep_for, yield
+
+namespace TuxArena {
+
+namespace {
+double toMs(FramePacer::Clock::duration duration) {
+    return std::chrono::duration<double, std::milli>(duration).count();
+}
+
+FramePacer::Clock::duration fromMs(double ms) {
+    return std::chrono::duration_cast<FramePacer::Clock::duration>(std::chrono::duration<double, std::milli>(ms));
+}
+}
+
+void FramePacer::setTargetFps(double fps) {
+    m_targetFps = fps > 0.0 ? fps : 0.0;
+    m_interval = fps > 0.0 ? fromMs(1000.0 / fps) : Clock::duration::zero();
+}
+
+void FramePacer::waitForFrameStart() {
+    if (m_interval > Clock::duration::zero()) {
+        Clock::time_point now = Clock::now();
+        if (!m_started || now > m_deadline + m_interval) {
+            // First frame, or more than a frame behind (hitch, breakpoint): restart the schedule instead of catching up
+            m_deadline = now + m_interval;
+        }
+        Clock::time_point wakeTime = m_deadline - m_interval; // Right after the previous frame's deadline
+        if (m_lateInputSampling) {
+            wakeTime = std::max(wakeTime, m_deadline - fromMs(m_predictedWorkMs));
+        }
+        sleepUntil(wakeTime);
+    }
+    m_frameStart = Clock::now();
+}
+
+void FramePacer::endFrame() {
+    Clock::time_point now = Clock::now();
+    double workMs = toMs(now - m_frameStart);
+    m_lastWorkMs = workMs;
+
+    // Smoothed work time with headroom for spikes, so late-sampled frames rarely miss their deadline
+    m_smoothedWorkMs = m_started ? m_smoothedWorkMs * 0.9 + workMs * 0.1 : workMs;
+    m_predictedWorkMs = std::min(m_smoothedWorkMs * 1.5 + 0.5, m_interval > Clock::duration::zero() ? toMs(m_interval) : 0.0);
+
+    // Input is shown at the frame's deadline at the earliest (on submission when uncapped)
+    Clock::time_point shownAt = m_interval > Clock::duration::zero() ? std::max(now, m_deadline) : now;
+    m_workTimes[m_nextSample] = workMs;
+    m_latencies[m_nextSample] = toMs(shownAt - m_frameStart);
+    m_frameTimes[m_nextSample] = m_started ? toMs(now - m_lastFrameEnd) : 0.0;
+    m_nextSample = (m_nextSample + 1) % STATS_WINDOW;
+    m_sampleCount = std::min(m_sampleCount + 1, STATS_WINDOW);
+    updateStats();
+
+    if (m_interval > Clock::duration::zero()) m_deadline += m_interval;
+    m_lastFrameEnd = now;
+    m_started = true;
+}
+
+void FramePacer::sleepUntil(Clock::time_point wakeTime) {
+    Clock::duration remaining = wakeTime - Clock::now();
+    Clock::duration spin = fromMs(m_spinMs);
+    if (remaining > spin) {
+        // Coarse OS sleep, ending early by the spin margin
+        Clock::duration sleepTime = remaining - spin;
+        Clock::time_point sleepStart = Clock::now();
+        std::this_thread::sleep_for(sleepTime);
+        double oversleepMs = std::max(0.0, toMs(Clock::now() - sleepStart - sleepTime));
+        // Rise at once on a long oversleep, decay slowly afterwards
+        double margin = oversleepMs * 1.25 + 0.1;
+        m_spinMs = std::clamp(margin > m_spinMs ? margin : m_spinMs * 0.95 + margin * 0.05, 0.2, 4.0);
+    }
+    while (Clock::now() < wakeTime) {
+        std::this_thread::yield();
+    }
+}
+
+void FramePacer::updateStats() {
+    FrameStats stats;
+    // The oldest frame time of a fresh schedule is 0 (no previous frame); skip it
+    size_t frames = 0;
+    double sum = 0.0;
+    double sumSquares = 0.0;
+    for (size_t i = 0; i < m_sampleCount; ++i) {
+        stats.workMs += m_workTimes[i];
+        stats.inputLatencyMs += m_latencies[i];
+        if (m_frameTimes[i] <= 0.0) continue;
+        sum += m_frameTimes[i];
+        sumSquares += m_frameTimes[i] * m_frameTimes[i];
+        stats.maxFrameMs = std::max(stats.maxFrameMs, m_frameTimes[i]);
+        ++frames;
+    }
+    if (m_sampleCount > 0) {
+        stats.workMs /= static_cast<double>(m_sampleCount);
+        stats.inputLatencyMs /= static_cast<double>(m_sampleCount);
+    }
+    if (frames > 0) {
+        stats.meanFrameMs = sum / static_cast<double>(frames);
+        double variance = sumSquares / static_cast<double>(frames) - stats.meanFrameMs * stats.meanFrameMs;
+        stats.stdDevFrameMs = std::sqrt(std::max(0.0, variance));
+    }
+    stats.frameCount = frames;
+    m_stats = stats;
+}
+
+} // namespace TuxArena
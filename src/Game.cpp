@@ -15,11 +15,14 @@
 #include "TuxArena/InputManager.h"
 #include "TuxArena/Log.h"         // <-- Assume a proper logging header exists
 #include "TuxArena/MapManager.h"
+#include "TuxArena/MapRotation.h"
 #include "TuxArena/ModManager.h"
 #include "TuxArena/NetworkClient.h"
 #include "TuxArena/NetworkServer.h"
 #include "TuxArena/Player.h"      // For spawning player (though moved)
+#include "TuxArena/Random.h"
 #include "TuxArena/Renderer.h"
+#include "TuxArena/RenderThread.h"
 #include "TuxArena/WeaponManager.h"
 
 // SDL Includes
@@ -98,6 +101,11 @@ bool Game::init(const AppConfig& config) {
             m_perfFrequency = 1000; // Fallback to millisecond precision
         }
 
+        // Seed the simulation streams before anything draws from them; logged so a run can be repeated with --seed
+        uint64_t seed = m_config.randomSeed != 0 ? m_config.randomSeed : static_cast<uint64_t>(SDL_GetPerformanceCounter());
+        setRandomSeed(seed);
+        Log::Info("Random seed: " + std::to_string(seed));
+
         // Initialize core systems that are common to both client and server
         Log::Info("Initializing ModManager...");
         m_modManager = std::make_unique<ModManager>();
@@ -113,28 +121,43 @@ bool Game::init(const AppConfig& config) {
 
         Log::Info("Initializing MapManager...");
         m_mapManager = std::make_unique<MapManager>();
+        m_mapRotation = std::make_unique<MapRotation>();
 
         Log::Info("Initializing EntityManager...");
         m_entityManager = std::make_unique<EntityManager>();
 
         // If this is a dedicated server, initialize server-specific components and we're done
         if (m_config.isServer) {
+            // The rotation is every map in the maps directory, starting at the configured one
+            findAvailableMaps();
+            std::vector<std::string> rotation;
+            for (const auto& mapFile : m_availableMaps) {
+                rotation.push_back(resolveMapPath(mapFile));
+            }
+            m_mapRotation->setMaps(rotation);
+            m_mapRotation->setCurrentMap(resolveMapPath(m_config.mapName));
+            if (!changeMap(m_mapRotation->getCurrentMap())) {
+                throw std::runtime_error("Initial map load failed");
+            }
+
             Log::Info("Initializing NetworkServer for dedicated mode...");
             m_networkServer = std::make_unique<NetworkServer>();
             if (!m_networkServer->initialize(m_config.serverPort, m_config.serverMaxPlayers,
                                            m_entityManager.get(), m_mapManager.get())) {
                 throw std::runtime_error("Dedicated NetworkServer initialization failed");
             }
+            startRound();
             popState(); // Pop INITIALIZING
             pushState(GameState::PLAYING); // Dedicated server goes straight to playing
         }
         // Otherwise, initialize all the client-side systems
         else {
             Log::Info("Initializing Renderer...");
-            m_renderer = std::make_unique<Renderer>();
+            m_renderer = std::make_unique<Renderer>(m_assetManager.get());
             if (!m_renderer->initialize("TuxArena", m_config.windowWidth, m_config.windowHeight, m_config.vsyncEnabled)) {
                 throw std::runtime_error("Renderer initialization failed");
             }
+            m_renderer->setTextureBudget(static_cast<size_t>(std::max(0, m_config.textureBudgetMB)) * 1024u * 1024u);
 
             Log::Info("Initializing ParticleManager...");
             m_particleManager = std::make_unique<ParticleManager>();
@@ -150,12 +173,35 @@ bool Game::init(const AppConfig& config) {
 
             Log::Info("Initializing UIManager...");
             m_uiManager = std::make_unique<UIManager>(this);
-            if (!m_uiManager->initialize(m_renderer->getSDLWindow(), m_renderer->getSDLRenderer())) {
+            if (!m_uiManager->initialize(m_renderer->getSDLWindow(), m_renderer->getSDLRenderer(), m_renderer->getImGuiContext())) {
                 throw std::runtime_error("UIManager initialization failed");
             }
 
+            // Frames are recorded on this thread and drawn on the render thread (or right away without one)
+            m_renderSnapshot = std::make_unique<RenderSnapshot>();
+            if (m_config.renderThreadEnabled) {
+                m_renderThread = std::make_unique<RenderThread>(*m_renderer);
+                if (!m_renderThread->start()) {
+                    Log::Warning("Drawing on the main thread instead.");
+                    m_renderThread.reset();
+                }
+            }
+
+            // Frame pacing: cap at the display refresh rate unless configured otherwise
+            m_playingFps = m_config.targetFps;
+            if (m_config.targetFps == 0) {
+                SDL_DisplayMode mode;
+                int display = SDL_GetWindowDisplayIndex(m_renderer->getSDLWindow());
+                bool known = display >= 0 && SDL_GetCurrentDisplayMode(display, &mode) == 0 && mode.refresh_rate > 0;
+                m_playingFps = known ? mode.refresh_rate : 60.0;
+            }
+            m_framePacer.setLateInputSampling(m_config.lateInputSampling);
+            Log::Info("Frame cap: " + (m_playingFps > 0.0 ? std::to_string(static_cast<int>(m_playingFps)) + " FPS" : std::string("off")) +
+                      " (menus " + std::to_string(m_config.menuFps) + " FPS), late input sampling " + (m_config.lateInputSampling ? "on" : "off") + ".");
+
             // Find available maps for client UI
             findAvailableMaps();
+            configureNetworkClient();
             popState(); // Pop INITIALIZING
             pushState(GameState::MAIN_MENU);
         }
@@ -201,6 +247,12 @@ void Game::run() {
 
     // --- Main Loop ---
     while (m_isRunning) {
+        // Client frame pacing: sleep until this frame should start (before input, so input is fresh)
+        if (!m_config.isServer) {
+            m_framePacer.setTargetFps(m_gameState == GameState::PLAYING ? m_playingFps : m_config.menuFps);
+            m_framePacer.waitForFrameStart();
+        }
+
         // Calculate delta time for this frame
         double newTime = SDL_GetPerformanceCounter() / static_cast<double>(m_perfFrequency);
         double deltaTime = newTime - currentTime;
@@ -220,6 +272,7 @@ void Game::run() {
 
         // 1. Input Processing (Client only, usually always polled)
         if (!m_config.isServer && m_inputManager) {
+            Profiler::Scope inputScope(&m_profiler, ProfileStage::Input);
             handleInput();
             if (m_inputManager->quitRequested()) {
                 m_isRunning = false;
@@ -238,7 +291,10 @@ void Game::run() {
 
         // 2. Network Update (Receive data, check timeouts, potentially send ACKs/Pings)
         // Run network receives frequently regardless of game state to handle connect/disconnect etc.
-        networkUpdateReceive(currentTime);
+        {
+            Profiler::Scope networkScope(m_config.isServer ? nullptr : &m_profiler, ProfileStage::NetworkReceive);
+            networkUpdateReceive(currentTime);
+        }
 
 
         // 3. Core Update Logic (Fixed Timestep for Server, Variable for Client)
@@ -254,6 +310,7 @@ void Game::run() {
             // Note: Interpolation factor for rendering isn't needed on server
         } else {
             // --- Client Variable Timestep Update ---
+            Profiler::Scope simulationScope(&m_profiler, ProfileStage::Simulation);
             update(deltaTime); // Update client simulation/interpolation
         }
 
@@ -270,13 +327,21 @@ void Game::run() {
 
         // 6. Rendering (Client only)
         if (!m_config.isServer && m_renderer) {
-             if (m_gameState == GameState::PLAYING || m_gameState == GameState::LOADING) {
-                 // Optionally pass interpolation factor for smooth rendering on client:
-                 // float interpolationAlpha = static_cast<float>(accumulator / SERVER_FIXED_DELTA_TIME); // If client used fixed update too
-                 render(); // Render based on current interpolated/predicted state
-             } else {
-                  // Render main menu, loading screen, error message etc. based on state
-                  renderNonPlayingState();
+             // Optionally pass interpolation factor for smooth rendering on client:
+             // float interpolationAlpha = static_cast<float>(accumulator / SERVER_FIXED_DELTA_TIME); // If client used fixed update too
+             {
+                 Profiler::Scope renderScope(&m_profiler, ProfileStage::Render);
+                 render(); // Records the frame; non-playing states are drawn by renderNonPlayingState()
+             }
+             m_framePacer.endFrame();
+             // Replay of the previous frame when a render thread draws, of this one otherwise
+             Renderer::ReplayStats replayStats = m_renderThread ? m_renderThread->getReplayStats() : m_renderer->getReplayStats();
+             m_profiler.add(ProfileStage::Present, replayStats.prepareMs + replayStats.drawMs + replayStats.presentMs);
+             m_profiler.endFrame(deltaTime * 1000.0);
+             if (m_gameState == GameState::PLAYING && m_entityManager) {
+                 // Work time includes waiting on the render thread, so this covers both threads
+                 double targetFps = m_framePacer.getTargetFps() > 0.0 ? m_framePacer.getTargetFps() : 60.0;
+                 m_entityManager->getParticleManager()->reportFrameTime(static_cast<float>(m_framePacer.getLastWorkMs()), static_cast<float>(1000.0 / targetFps));
              }
         }
         // Server does not render graphics
@@ -296,6 +361,16 @@ void Game::shutdown() {
     // --- Shutdown Sequence (Reverse of Initialization Recommended) ---
     // Ensure network disconnects before entity manager clears entities that might be network-related
 
+    if (!m_config.isServer && m_framePacer.getStats().frameCount > 0) {
+        const FrameStats& stats = m_framePacer.getStats();
+        Log::Info("Frame pacing (last " + std::to_string(stats.frameCount) + " frames): mean " + std::to_string(stats.meanFrameMs) +
+                  " ms, std dev " + std::to_string(stats.stdDevFrameMs) + " ms, max " + std::to_string(stats.maxFrameMs) +
+                  " ms, work " + std::to_string(stats.workMs) + " ms, input latency " + std::to_string(stats.inputLatencyMs) + " ms");
+    }
+
+    // 0. Render thread: finishes its frame and hands the renderer back to this thread
+    if (m_renderThread) { Log::Info("Stopping render thread..."); m_renderThread->stop(); m_renderThread.reset(); }
+
     // 1. Mod Shutdown Hook
     if (m_modManager) { Log::Info("Triggering ModManager OnShutdown..."); m_modManager->triggerOnShutdown(); }
 
@@ -307,6 +382,7 @@ void Game::shutdown() {
     if (m_entityManager) { Log::Info("Shutting down EntityManager..."); m_entityManager->shutdown(); m_entityManager.reset(); }
 
     // 4. Map Manager
+    if (m_mapRotation) { Log::Info("Shutting down MapRotation..."); m_mapRotation.reset(); } // Waits for a pending preload
     if (m_mapManager) { Log::Info("Shutting down MapManager..."); m_mapManager->unloadMap(); m_mapManager.reset(); }
 
     // 5. Input Manager
@@ -347,8 +423,17 @@ void Game::update(double deltaTime) {
     // Populate the context for this frame
     populateEntityContext(m_currentContext, deltaTime);
 
-    // Only update core game logic when in the playing state
-    if (m_gameState == GameState::PLAYING) {
+    if (m_config.isServer && m_gameState == GameState::PLAYING) {
+        updateMapRotation(deltaTime);
+    }
+
+    // Finish rebuilding map data invalidated by destroyed tiles, a bounded amount per tick
+    if (m_mapManager && m_mapManager->isMapLoaded()) {
+        m_mapManager->updateDerivedData();
+    }
+
+    // Only update core game logic when in the playing state (the world is frozen during intermission)
+    if (m_gameState == GameState::PLAYING && m_intermissionTimeRemaining <= 0.0) {
         // Update Entities (handles prediction on client, authoritative on server)
         if (m_entityManager) {
              // Pass the context, which includes deltaTime
@@ -395,20 +480,80 @@ void Game::renderNonPlayingState() {
 }
 
 
+void Game::updateCamera() {
+    m_camera.setViewport(m_renderer->getWindowWidth(), m_renderer->getWindowHeight());
+
+    Player* player = m_entityManager ? m_entityManager->getPlayer() : nullptr;
+    if (player) {
+        m_camera.setPosition(player->getPosition());
+    }
+
+    if (m_mapManager && m_mapManager->isMapLoaded()) {
+        m_camera.clampToBounds(static_cast<float>(m_mapManager->getMapWidthPixels()),
+                               static_cast<float>(m_mapManager->getMapHeightPixels()));
+    }
+}
+
+void Game::updateMinimapMarkers() {
+    // Gathered at a lower rate than frames; the minimap is too small for the difference to show
+    double now = SDL_GetTicks() / 1000.0;
+    if (m_minimapMarkerTime >= 0.0 && now - m_minimapMarkerTime < MINIMAP_MARKER_INTERVAL) return;
+    m_minimapMarkerTime = now;
+
+    m_minimapMarkers.clear();
+    if (!m_entityManager) return;
+    Player* localPlayer = m_entityManager->getPlayer();
+    for (Entity* entity : m_entityManager->getActiveEntities()) {
+        Vec2 position = entity->getPosition();
+        switch (entity->getType()) {
+            case EntityType::PLAYER:
+                if (m_config.fogOfWar && entity != localPlayer && m_mapManager &&
+                    !m_fogOfWar.isVisible(static_cast<int>(position.x / m_mapManager->getTileWidth()),
+                                          static_cast<int>(position.y / m_mapManager->getTileHeight()))) {
+                    break; // Hidden by the fog
+                }
+                m_minimapMarkers.push_back({position.x, position.y, 3.0f,
+                                            entity == localPlayer ? SDL_Color{80, 220, 80, 255} : SDL_Color{220, 60, 60, 255}});
+                break;
+            case EntityType::ITEM_HEALTH:
+                m_minimapMarkers.push_back({position.x, position.y, 2.0f, {240, 240, 240, 255}});
+                break;
+            case EntityType::ITEM_AMMO:
+                m_minimapMarkers.push_back({position.x, position.y, 2.0f, {230, 200, 60, 255}});
+                break;
+            default:
+                break;
+        }
+    }
+}
+
 void Game::render() {
     // Assumes Renderer exists (Client only)
     if (!m_renderer) return;
 
-    m_renderer->clear(); // Clear background
+    // Extraction: the draw calls below are recorded into a snapshot, so entity, particle and tile
+    // state is copied now and the simulation is free to change it while the frame is drawn
+    RenderSnapshot& snapshot = m_renderThread ? m_renderThread->acquireBackBuffer() : *m_renderSnapshot;
+    m_renderer->beginRecording(snapshot);
 
     // --- Render Scene based on State ---
     if (m_gameState == GameState::PLAYING || m_gameState == GameState::LOADING) { // Show map/entities while loading too?
+        // World-space passes go through the camera
+        updateCamera();
+        m_renderer->setCamera(&m_camera);
+        if (m_mapPrebakePending && m_mapManager && m_mapManager->isMapLoaded()) {
+            m_renderer->prebakeMap(*m_mapManager);
+            m_mapPrebakePending = false;
+        }
+
         // 1. Render Map Background
         if (m_mapManager && m_mapManager->isMapLoaded()) {
             m_renderer->renderMap(*m_mapManager, MapLayer::Background);
         }
+        m_renderer->renderDecals(); // Blood and impact marks, above the floor and below everything else
 
-        // 2. Render Entities
+        // 2. Render Entities (y-sorted with each other by the renderer)
+        m_renderer->setDrawLayer(RenderLayer::World);
         if (m_entityManager) {
             m_entityManager->render(*m_renderer);
         }
@@ -418,15 +563,34 @@ void Game::render() {
              m_renderer->renderMap(*m_mapManager, MapLayer::Foreground);
         }
 
-        // 4. Render UI / HUD (In-Game HUD)
+        // Fog of war: recomputed only when the local player enters another tile
+        if (m_config.fogOfWar && m_mapManager && m_mapManager->isMapLoaded()) {
+            if (Player* player = m_entityManager ? m_entityManager->getPlayer() : nullptr) {
+                m_fogOfWar.update(m_mapManager->getCollisionGrid(), player->getPosition(), m_mapManager->getTileEdits().size());
+            }
+            SDL_FRect mapRect = {0.0f, 0.0f, static_cast<float>(m_mapManager->getMapWidthPixels()),
+                                 static_cast<float>(m_mapManager->getMapHeightPixels())};
+            m_renderer->renderFogMask(m_fogOfWar.getMask().data(), m_fogOfWar.getWidth(), m_fogOfWar.getHeight(),
+                                      m_fogOfWar.getRevision(), mapRect);
+        }
+
+        // 4. Render UI / HUD (In-Game HUD, screen space)
+        m_renderer->setCamera(nullptr);
+        m_renderer->setDrawLayer(RenderLayer::Hud);
          std::string networkStatus = "Offline";
          if (m_networkClient) networkStatus = m_networkClient->getStatusString();
          else if (m_networkServer) networkStatus = "Server Running";
          m_renderer->drawText(networkStatus, 10, 10, "assets/fonts/nokia.ttf", 16, {255, 255, 255, 255});
+         if (m_mapManager && m_mapManager->isMapLoaded()) {
+             updateMinimapMarkers();
+             SDL_FRect minimapRect = {static_cast<float>(m_renderer->getWindowWidth()) - MINIMAP_SIZE - 10.0f, 10.0f, MINIMAP_SIZE, MINIMAP_SIZE};
+             m_renderer->renderMinimap(*m_mapManager, minimapRect, m_minimapMarkers.data(), m_minimapMarkers.size());
+         }
          // TODO: Render health, ammo, score etc.
 
     } else {
          // Render based on other states (handled by renderNonPlayingState)
+         m_renderer->setDrawLayer(RenderLayer::Hud);
          renderNonPlayingState();
     }
 
@@ -434,11 +598,19 @@ void Game::render() {
     // Render Mods (might draw overlay UI)
     if (m_modManager) { m_modManager->triggerOnUpdate(0.0f); } // TODO: Pass proper delta time
 
-    // Render Debug Info (if enabled)
-    // if (m_debugEnabled) renderDebug();
-
+    // Performance overlay (F3): an ImGui frame built here, drawn over the frame by the replay
+    if (m_perfOverlay.isVisible() && m_renderer->hasImGui()) {
+        m_perfOverlay.build(m_profiler, m_framePacer.getStats(), *m_renderer, m_renderThread.get(),
+                            m_entityManager.get(), m_networkClient.get());
+        m_renderer->recordOverlay();
+    }
 
-    m_renderer->present(); // Swap buffers
+    m_renderer->endRecording();
+    if (m_renderThread) {
+        m_renderThread->submit(); // Drawn while the next tick runs
+    } else {
+        m_renderer->replay(snapshot); // Clear, draw and swap buffers
+    }
 }
 
 void Game::pushState(GameState state) {
@@ -486,6 +658,81 @@ void Game::findAvailableMaps() {
 
 
 
+// --- Map Rotation ---
+
+std::string Game::resolveMapPath(const std::string& mapName) const {
+    // Bare file names refer to the maps directory scanned by findAvailableMaps()
+    if (mapName.find('/') != std::string::npos) return mapName;
+    return "maps/" + mapName;
+}
+
+bool Game::changeMap(const std::string& mapPath) {
+    if (!m_mapRotation) return false;
+
+    std::unique_ptr<MapManager> nextMap = m_mapRotation->acquire(mapPath);
+    if (!nextMap) {
+        Log::Error("Map change to '" + mapPath + "' failed. Keeping the current map.");
+        return false;
+    }
+
+    // Single pointer publish, then rebind every system holding a raw MapManager pointer
+    std::unique_ptr<MapManager> previousMap = std::move(m_mapManager);
+    m_mapManager = std::move(nextMap);
+    m_currentContext.mapManager = m_mapManager.get();
+    if (m_entityManager) m_entityManager->setMapManager(m_mapManager.get());
+    if (m_networkServer) m_networkServer->changeMap(m_mapManager.get());
+    if (m_networkClient) m_networkClient->setMapManager(m_mapManager.get());
+    if (m_renderThread) m_renderThread->synchronize(); // Drawn frames may still reference the old map
+    m_mapPrebakePending = m_renderer != nullptr;
+    m_fogOfWar.invalidate(); // The new map may reuse the old map's address
+
+    // The old map is freed on the loader thread rather than in this frame
+    m_mapRotation->retire(std::move(previousMap));
+    Log::Info("Now playing map: " + m_mapManager->getMapName());
+    return true;
+}
+
+void Game::startRound() {
+    m_roundTimeRemaining = ROUND_DURATION_SECONDS;
+    m_intermissionTimeRemaining = 0.0;
+    if (!m_mapRotation || m_mapRotation->getMaps().size() < 2) return;
+
+    // Load the next map for the whole round, and let clients do the same
+    m_mapRotation->preloadNext();
+    if (m_networkServer) {
+        m_networkServer->setNextMapHint(m_mapRotation->getNextMap());
+    }
+}
+
+void Game::updateMapRotation(double deltaTime) {
+    if (!m_mapRotation || m_mapRotation->getMaps().size() < 2) return;
+
+    if (m_intermissionTimeRemaining > 0.0) {
+        m_intermissionTimeRemaining -= deltaTime;
+        if (m_intermissionTimeRemaining <= 0.0) {
+            startRound();
+        }
+        return;
+    }
+
+    m_roundTimeRemaining -= deltaTime;
+    if (m_roundTimeRemaining > 0.0) return;
+
+    std::string nextMap = m_mapRotation->getNextMap();
+    Log::Info("Round over. Rotating to map: " + nextMap);
+    if (changeMap(nextMap)) {
+        m_mapRotation->advance();
+    }
+    m_intermissionTimeRemaining = INTERMISSION_SECONDS;
+}
+
+void Game::configureNetworkClient() {
+    if (!m_networkClient) return;
+    m_networkClient->setMapRotation(m_mapRotation.get());
+    m_networkClient->setMapChangeHandler([this](const std::string& mapName) { return changeMap(mapName); });
+}
+
+
 // --- Network Update Logic ---
 
 void Game::networkUpdateReceive(double currentTime) {
@@ -496,6 +743,7 @@ void Game::networkUpdateReceive(double currentTime) {
      } else if (m_networkClient) {
           m_networkClient->receiveData();
           // Timeout check happens internally in receiveData for client currently
+          m_networkClient->update(); // Pings and connection stats
      }
 }
 
@@ -524,6 +772,13 @@ void Game::handleInput() {
     if (m_inputManager) {
         SDL_Event event;
         while (SDL_PollEvent(&event)) {
+            // Render target contents (baked map chunks) are lost on device/target resets
+            if ((event.type == SDL_RENDER_TARGETS_RESET || event.type == SDL_RENDER_DEVICE_RESET) && m_renderer) {
+                m_renderer->notifyRenderTargetsReset(); // Handled by the thread drawing the next frame
+            }
+            if (event.type == SDL_KEYDOWN && event.key.repeat == 0 && event.key.keysym.sym == SDLK_F3) {
+                m_perfOverlay.toggle();
+            }
             m_inputManager->processSDLEvent(event);
         }
     }
@@ -538,6 +793,8 @@ void Game::populateEntityContext(EntityContext& context, double deltaTime) {
     context.modManager = m_modManager.get();
     context.networkClient = m_networkClient.get();
     context.networkServer = m_networkServer.get();
+    context.profiler = m_config.isServer ? nullptr : &m_profiler;
+    context.camera = m_config.isServer ? nullptr : &m_camera;
     // context.physicsWorld = m_physicsEngine.get();
 }
 
@@ -0,0 +1,133 @@
+// src/GlyphCache.cpp
+#include "TuxArena/GlyphCache.h"
+#include "TuxArena/Log.h"
+
+#include <algorithm> // For std::max
+#include <cstdint>
+
+namespace TuxArena {
+
+GlyphCache::GlyphCache(SDL_Renderer* renderer, TTF_Font* font) : m_renderer(renderer), m_font(font) {}
+
+GlyphCache::~GlyphCache() {
+    for (SDL_Texture* page : m_pages) {
+        SDL_DestroyTexture(page);
+    }
+}
+
+bool GlyphCache::addPage() {
+    if (m_pages.size() >= MAX_PAGES) {
+        if (!m_full) Log::Warning("Glyph cache is full; glyphs of this font size will be missing");
+        m_full = true;
+        return false;
+    }
+    SDL_Texture* page = SDL_CreateTexture(m_renderer, SDL_PIXELFORMAT_RGBA32, SDL_TEXTUREACCESS_STATIC, PAGE_SIZE, PAGE_SIZE);
+    if (!page) {
+        Log::Error("Failed to create glyph page: " + std::string(SDL_GetError()));
+        return false;
+    }
+    SDL_SetTextureBlendMode(page, SDL_BLENDMODE_BLEND);
+
+    // Static texture contents start undefined; clear so the padding between glyphs is transparent
+    std::vector<uint32_t> clearPixels(static_cast<size_t>(PAGE_SIZE) * PAGE_SIZE, 0);
+    SDL_UpdateTexture(page, nullptr, clearPixels.data(), PAGE_SIZE * static_cast<int>(sizeof(uint32_t)));
+
+    m_pages.push_back(page);
+    m_shelfX = 0;
+    m_shelfY = 0;
+    m_shelfHeight = 0;
+    return true;
+}
+
+bool GlyphCache::rasterize(Uint16 character, Glyph& glyph) {
+    // TTF_RenderGlyph surfaces are one line tall with the glyph already placed on the baseline
+    SDL_Surface* rendered = TTF_RenderGlyph_Blended(m_font, character, {255, 255, 255, 255});
+    if (!rendered) return false;
+    SDL_Surface* surface = SDL_ConvertSurfaceFormat(rendered, SDL_PIXELFORMAT_RGBA32, 0);
+    SDL_FreeSurface(rendered);
+    if (!surface) return false;
+
+    const int padding = 1;
+    int width = surface->w + padding;
+    int height = surface->h + padding;
+    if (width > PAGE_SIZE || height > PAGE_SIZE) {
+        SDL_FreeSurface(surface);
+        return false;
+    }
+
+    // Shelf packing: glyphs of one font are of similar height
+    if (m_pages.empty() || m_shelfX + width > PAGE_SIZE) {
+        m_shelfX = 0;
+        m_shelfY += m_shelfHeight;
+        m_shelfHeight = 0;
+    }
+    if (m_pages.empty() || m_shelfY + height > PAGE_SIZE) {
+        if (!addPage()) {
+            SDL_FreeSurface(surface);
+            return false;
+        }
+    }
+
+    SDL_Rect rect = {m_shelfX, m_shelfY, surface->w, surface->h};
+    SDL_UpdateTexture(m_pages.back(), &rect, surface->pixels, surface->pitch);
+    SDL_FreeSurface(surface);
+
+    m_shelfX += width;
+    m_shelfHeight = std::max(m_shelfHeight, height);
+
+    int minX, maxX, minY, maxY, advance;
+    if (TTF_GlyphMetrics(m_font, character, &minX, &maxX, &minY, &maxY, &advance) != 0) {
+        advance = rect.w;
+    }
+    glyph.page = m_pages.back();
+    glyph.rect = rect;
+    glyph.advance = advance;
+    return true;
+}
+
+const GlyphCache::Glyph* GlyphCache::getGlyph(Uint16 character) {
+    auto it = m_glyphs.find(character);
+    if (it != m_glyphs.end()) {
+        return it->second.page ? &it->second : nullptr;
+    }
+
+    // Failed glyphs are remembered too (with no page) so they are not retried every frame
+    Glyph& glyph = m_glyphs[character];
+    if (!rasterize(character, glyph)) {
+        glyph = Glyph{};
+        return nullptr;
+    }
+    return &glyph;
+}
+
+const std::vector<GlyphCache::Quad>& GlyphCache::layout(const std::string& text) {
+    auto it = m_layouts.find(text);
+    if (it != m_layouts.end()) return it->second;
+
+    if (m_layouts.size() >= MAX_CACHED_LAYOUTS) {
+        m_layouts.clear(); // Dynamic strings (timers, scores) would otherwise grow the cache forever
+    }
+
+    std::vector<Quad>& quads = m_layouts[text];
+    quads.reserve(text.size());
+    float penX = 0.0f;
+    Uint16 previous = 0;
+    for (unsigned char byte : text) {
+        // Latin-1, matching TTF_RenderText
+        const Glyph* glyph = getGlyph(static_cast<Uint16>(byte));
+        if (!glyph) continue;
+        if (previous != 0) {
+            // Pair kerning (AV, To, ...), which TTF_RenderText applies too; 0 for fonts without a kern table
+            penX += static_cast<float>(TTF_GetFontKerningSizeGlyphs(m_font, previous, static_cast<Uint16>(byte)));
+        }
+        previous = static_cast<Uint16>(byte);
+        if (byte != ' ') {
+            quads.push_back({glyph->page, glyph->rect,
+                             {penX, 0.0f, static_cast<float>(glyph->rect.w), static_cast<float>(glyph->rect.h)}});
+        }
+        penX += static_cast<float>(glyph->advance);
+    }
+    return quads;
+}
+
+} // namespace TuxArena
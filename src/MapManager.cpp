@@ -15,6 +15,7 @@
 
 #include <filesystem> // For path manipulation (C++17)
 #include <algorithm> // For std::transform, std::find_if
+#include <cmath> // For std::floor
 
 namespace TuxArena {
 
@@ -47,7 +48,7 @@ bool MapManager::loadMap(const std::string& filePath) {
         }
     }
 
-    if (m_isMapLoaded) {
+    if (m_isMapLoaded && !m_useFallbackMap) {
         // Extract map properties
         m_mapWidth = m_tmxMap.getTileCount().x;
         m_mapHeight = m_tmxMap.getTileCount().y;
@@ -92,6 +93,9 @@ bool MapManager::loadMap(const std::string& filePath) {
             processLayer(*layer);
         }
 
+        buildTileLayers();
+        buildCollisionData();
+
         Log::Info("Map '" + m_mapName + "' loaded successfully. Dimensions: " + std::to_string(m_mapWidth) + "x" + std::to_string(m_mapHeight) + " tiles, " + std::to_string(m_tileWidth) + "x" + std::to_string(m_tileHeight) + " tile size.");
     }
 
@@ -128,6 +132,8 @@ void MapManager::createFallbackMap() {
     // Add a default spawn point in the center
     m_spawnPoints.push_back({(float)getMapWidthPixels() / 2.0f, (float)getMapHeightPixels() / 2.0f, "player_spawn", "player"});
 
+    buildCollisionData();
+
     Log::Info("Fallback map created. Dimensions: " + std::to_string(m_mapWidth) + "x" + std::to_string(m_mapHeight) + " tiles, " + std::to_string(m_tileWidth) + "x" + std::to_string(m_tileHeight) + " tile size.");
 }
 
@@ -144,6 +150,13 @@ void MapManager::unloadMap() {
         m_tilesets.clear();
         m_collisionShapes.clear();
         m_spawnPoints.clear();
+        m_raycaster.clear();
+        m_collisionGrid.clear();
+        m_distanceField.clear();
+        m_tileGids.clear();
+        m_destructibleLayers.clear();
+        m_staticSolid.clear();
+        m_tileEdits.clear();
         m_useFallbackMap = false;
     }
 }
@@ -243,6 +256,161 @@ void MapManager::processObjectLayer(const tmx::ObjectGroup& group) {
 }
 
 
+void MapManager::buildCollisionData() {
+    m_collisionGrid.reset(getMapWidthTiles(), getMapHeightTiles(), getTileWidth(), getTileHeight());
+
+    // Tiles painted on a collision tile layer are solid
+    for (const auto& layer : getRawLayers()) {
+        markCollisionTiles(*layer);
+    }
+
+    // Tiles whose center lies inside a collision object are solid
+    float tileWidth = static_cast<float>(getTileWidth());
+    float tileHeight = static_cast<float>(getTileHeight());
+    if (tileWidth > 0.0f && tileHeight > 0.0f) {
+        for (const auto& shape : m_collisionShapes) {
+            int x0 = std::max(0, static_cast<int>(std::floor(shape.minX / tileWidth)));
+            int y0 = std::max(0, static_cast<int>(std::floor(shape.minY / tileHeight)));
+            int x1 = std::min(m_collisionGrid.getWidth() - 1, static_cast<int>(std::floor(shape.maxX / tileWidth)));
+            int y1 = std::min(m_collisionGrid.getHeight() - 1, static_cast<int>(std::floor(shape.maxY / tileHeight)));
+            for (int ty = y0; ty <= y1; ++ty) {
+                for (int tx = x0; tx <= x1; ++tx) {
+                    if (shape.contains((tx + 0.5f) * tileWidth, (ty + 0.5f) * tileHeight)) {
+                        m_collisionGrid.setSolid(tx, ty, true);
+                    }
+                }
+            }
+        }
+    }
+
+    // Destructible tiles are solid until broken; remember what is solid without them
+    const uint8_t* solidTiles = m_collisionGrid.data();
+    m_staticSolid.assign(solidTiles, solidTiles + static_cast<size_t>(m_collisionGrid.getWidth()) * m_collisionGrid.getHeight());
+    for (size_t layerIndex : m_destructibleLayers) {
+        const auto& gids = m_tileGids[layerIndex];
+        unsigned width = getMapWidthTiles();
+        for (size_t i = 0; i < gids.size() && width > 0; ++i) {
+            if (gids[i] > 0) {
+                m_collisionGrid.setSolid(static_cast<int>(i % width), static_cast<int>(i / width), true);
+            }
+        }
+    }
+
+    m_raycaster.build(m_collisionGrid);
+
+    // The distance field also rasterizes the shapes themselves at sub-tile resolution
+    m_distanceField.build(m_collisionGrid, m_collisionShapes);
+}
+
+void MapManager::markCollisionTiles(const tmx::Layer& layer) {
+    if (layer.getType() == tmx::Layer::Type::Group) {
+        for (const auto& subLayer : layer.getLayerAs<tmx::LayerGroup>().getLayers()) {
+            markCollisionTiles(*subLayer);
+        }
+        return;
+    }
+    if (layer.getType() != tmx::Layer::Type::Tile) return;
+
+    std::string lowerName = layer.getName();
+    std::transform(lowerName.begin(), lowerName.end(), lowerName.begin(), ::tolower);
+    if (lowerName.find("collision") == std::string::npos || lowerName.find("destructible") != std::string::npos) return;
+
+    const auto& tileLayer = layer.getLayerAs<tmx::TileLayer>();
+    const auto& tiles = tileLayer.getTiles();
+    unsigned layerWidth = tileLayer.getSize().x;
+    for (size_t i = 0; i < tiles.size() && layerWidth > 0; ++i) {
+        if (tiles[i].ID > 0) {
+            m_collisionGrid.setSolid(static_cast<int>(i % layerWidth), static_cast<int>(i / layerWidth), true);
+        }
+    }
+    Log::Info("  - Marked collision tiles from layer: " + layer.getName());
+}
+
+void MapManager::buildTileLayers() {
+    const auto& layers = getRawLayers();
+    m_tileGids.assign(layers.size(), {});
+    m_destructibleLayers.clear();
+
+    for (size_t i = 0; i < layers.size(); ++i) {
+        if (layers[i]->getType() != tmx::Layer::Type::Tile) continue;
+
+        const auto& tiles = layers[i]->getLayerAs<tmx::TileLayer>().getTiles();
+        auto& gids = m_tileGids[i];
+        gids.resize(static_cast<size_t>(getMapWidthTiles()) * getMapHeightTiles(), 0);
+        for (size_t t = 0; t < tiles.size() && t < gids.size(); ++t) {
+            gids[t] = tiles[t].ID;
+        }
+
+        std::string lowerName = layers[i]->getName();
+        std::transform(lowerName.begin(), lowerName.end(), lowerName.begin(), ::tolower);
+        if (lowerName.find("destructible") != std::string::npos) {
+            m_destructibleLayers.push_back(i);
+            Log::Info("  - Destructible tile layer: " + layers[i]->getName());
+        }
+    }
+}
+
+uint32_t MapManager::getTileGid(size_t layerIndex, unsigned tileX, unsigned tileY) const {
+    if (layerIndex >= m_tileGids.size() || tileX >= getMapWidthTiles() || tileY >= getMapHeightTiles()) return 0;
+    const auto& gids = m_tileGids[layerIndex];
+    size_t index = static_cast<size_t>(tileY) * getMapWidthTiles() + tileX;
+    return index < gids.size() ? gids[index] : 0;
+}
+
+bool MapManager::applyTileEdit(const TileEdit& edit) {
+    if (!m_isMapLoaded || edit.tileX >= getMapWidthTiles() || edit.tileY >= getMapHeightTiles() ||
+        edit.layer >= m_tileGids.size() || m_tileGids[edit.layer].empty()) {
+        Log::Warning("Ignoring out of range tile edit at (" + std::to_string(edit.tileX) + "," + std::to_string(edit.tileY) + ") on layer " + std::to_string(edit.layer));
+        return false;
+    }
+
+    m_tileGids[edit.layer][static_cast<size_t>(edit.tileY) * getMapWidthTiles() + edit.tileX] = edit.gid;
+
+    bool solid = edit.solid != 0;
+    if (m_collisionGrid.isSolid(edit.tileX, edit.tileY) != solid) {
+        m_collisionGrid.setSolid(edit.tileX, edit.tileY, solid);
+        m_raycaster.updateTile(edit.tileX, edit.tileY);
+        float tileWidth = static_cast<float>(getTileWidth());
+        float tileHeight = static_cast<float>(getTileHeight());
+        m_distanceField.invalidateRegion(m_collisionGrid, m_collisionShapes, edit.tileX * tileWidth, edit.tileY * tileHeight,
+                                         (edit.tileX + 1) * tileWidth, (edit.tileY + 1) * tileHeight);
+    }
+
+    m_tileEdits.push_back(edit);
+    return true;
+}
+
+bool MapManager::breakTile(int tileX, int tileY) {
+    if (tileX < 0 || tileY < 0) return false;
+
+    for (size_t layerIndex : m_destructibleLayers) {
+        if (getTileGid(layerIndex, tileX, tileY) == 0) continue;
+
+        TileEdit edit;
+        edit.tileX = static_cast<uint16_t>(tileX);
+        edit.tileY = static_cast<uint16_t>(tileY);
+        edit.layer = static_cast<uint16_t>(layerIndex);
+        edit.gid = 0;
+        edit.solid = m_staticSolid[static_cast<size_t>(tileY) * getMapWidthTiles() + tileX];
+        return applyTileEdit(edit);
+    }
+    return false;
+}
+
+bool MapManager::isDestructible(int tileX, int tileY) const {
+    if (tileX < 0 || tileY < 0) return false;
+    for (size_t layerIndex : m_destructibleLayers) {
+        if (getTileGid(layerIndex, tileX, tileY) != 0) return true;
+    }
+    return false;
+}
+
+void MapManager::updateDerivedData(int texelBudget) {
+    if (m_distanceField.hasDirtyRegions()) {
+        m_distanceField.rebuildDirty(texelBudget);
+    }
+}
+
 // --- Map Property Accessors ---
 unsigned MapManager::getMapWidthTiles() const {
     if (m_useFallbackMap) return m_mapWidth;
@@ -0,0 +1,102 @@
+// src/MapRotation.cpp
+#include "TuxArena/MapRotation.h"
+#include "TuxArena/MapManager.h"
+#include "TuxArena/Log.h"
+
+#include <algorithm> // For std::find
+#include <chrono>    // For std::chrono::seconds
+
+namespace TuxArena {
+
+MapRotation::~MapRotation() {
+    cancel();
+}
+
+void MapRotation::setMaps(const std::vector<std::string>& mapPaths) {
+    std::string current = getCurrentMap();
+    m_maps = mapPaths;
+    m_currentIndex = 0;
+    if (!current.empty()) {
+        setCurrentMap(current);
+    }
+}
+
+void MapRotation::setCurrentMap(const std::string& mapPath) {
+    auto it = std::find(m_maps.begin(), m_maps.end(), mapPath);
+    if (it == m_maps.end()) {
+        m_maps.insert(m_maps.begin(), mapPath);
+        m_currentIndex = 0;
+    } else {
+        m_currentIndex = static_cast<size_t>(it - m_maps.begin());
+    }
+}
+
+std::string MapRotation::getCurrentMap() const {
+    return m_maps.empty() ? std::string() : m_maps[m_currentIndex];
+}
+
+std::string MapRotation::getNextMap() const {
+    return m_maps.empty() ? std::string() : m_maps[(m_currentIndex + 1) % m_maps.size()];
+}
+
+void MapRotation::advance() {
+    if (!m_maps.empty()) {
+        m_currentIndex = (m_currentIndex + 1) % m_maps.size();
+    }
+}
+
+void MapRotation::preload(const std::string& mapPath) {
+    if (mapPath.empty()) return;
+    if (m_pending.valid() && m_pendingPath == mapPath) return;
+    cancel();
+
+    Log::Info("Preloading map in background: " + mapPath);
+    m_pendingPath = mapPath;
+    // The retired map (if any) is destroyed on the loader thread as well
+    m_pending = std::async(std::launch::async, [mapPath, retired = std::move(m_retired)]() mutable {
+        retired.reset();
+        return loadMap(mapPath);
+    });
+}
+
+bool MapRotation::isPreloadReady() const {
+    return m_pending.valid() && m_pending.wait_for(std::chrono::seconds(0)) == std::future_status::ready;
+}
+
+std::unique_ptr<MapManager> MapRotation::acquire(const std::string& mapPath) {
+    if (m_pending.valid() && m_pendingPath == mapPath) {
+        if (!isPreloadReady()) {
+            Log::Warning("Map '" + mapPath + "' is still loading in the background. Waiting for it.");
+        }
+        std::unique_ptr<MapManager> map = m_pending.get();
+        m_pendingPath.clear();
+        return map;
+    }
+
+    cancel();
+    Log::Info("Map '" + mapPath + "' was not preloaded. Loading synchronously.");
+    return loadMap(mapPath);
+}
+
+void MapRotation::retire(std::unique_ptr<MapManager> map) {
+    m_retired = std::move(map);
+}
+
+void MapRotation::cancel() {
+    if (m_pending.valid()) {
+        m_pending.wait();
+        m_pending = {};
+    }
+    m_pendingPath.clear();
+}
+
+std::unique_ptr<MapManager> MapRotation::loadMap(const std::string& mapPath) {
+    auto map = std::make_unique<MapManager>();
+    if (!map->loadMap(mapPath)) {
+        Log::Error("Failed to load map: " + mapPath);
+        return nullptr;
+    }
+    return map;
+}
+
+} // namespace TuxArena
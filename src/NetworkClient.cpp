@@ -12,6 +12,7 @@
 
 #include "TuxArena/InputManager.h" // Include InputManager.h
 #include "TuxArena/MapManager.h" // Include MapManager.h
+#include "TuxArena/MapRotation.h"
 
 #include "SDL2/SDL.h" // For logging, timing
 #include "SDL2/SDL_net.h"
@@ -19,6 +20,7 @@
 #include <iostream>
 #include <cstring> // For memcpy, memset
 #include <stdexcept> // For potential exceptions
+#include <algorithm> // For std::min, std::max
 
 namespace TuxArena {
 
@@ -189,6 +191,8 @@ void NetworkClient::disconnect() {
     // Reset state immediately
     m_connectionState = ConnectionState::DISCONNECTED;
     m_clientId = 0;
+    m_tileMapSerial = 0; // A new server session starts its edit numbering over
+    m_tileEditsApplied = 0;
     // Optionally clear entities, reset map? Or leave that to game logic?
     // if(m_entityManager) m_entityManager->clearAllEntities(); // Example: Clear entities on disconnect
 
@@ -235,6 +239,7 @@ void NetworkClient::receiveData() {
             // Check if packet is from the known server address (ignore others)
             if (m_recvPacket->address.host == m_serverAddress.host && m_recvPacket->address.port == m_serverAddress.port) {
                 m_lastServerPacketTime = SDL_GetTicks() / 1000.0; // Update time received
+                m_bytesReceived += static_cast<size_t>(m_recvPacket->len);
                 handlePacket(m_recvPacket);
             } else {
                 // Log::Warning("Received packet from unexpected address: " + std::to_string(m_recvPacket->address.host) + ":" + std::to_string(m_recvPacket->address.port));
@@ -262,6 +267,13 @@ void NetworkClient::receiveData() {
 
 void NetworkClient::update() {
      if (!m_isInitialized) return;
+     double currentTime = SDL_GetPerformanceCounter() / static_cast<double>(SDL_GetPerformanceFrequency());
+     updateNetworkStats(currentTime);
+     // Repeated so a lost ack, or a count reset by a map reload, still reaches the server
+     if (m_connectionState == ConnectionState::CONNECTED && m_tileMapSerial != 0 &&
+         currentTime - m_lastTileAckTime >= Network::TILE_RESEND_INTERVAL) {
+         sendTileAck(currentTime);
+     }
     // This is where client-side prediction adjustments and entity state
     // interpolation logic would typically run based on received snapshots.
     // For now, leave it empty. State application happens directly in handleStateUpdate.
@@ -288,7 +300,10 @@ void NetworkClient::handlePacket(UDPpacket* packet) {
                 case Network::MessageType::SPAWN_ENTITY: handleSpawnEntity(packet); break;
                 case Network::MessageType::DESTROY_ENTITY: handleDestroyEntity(packet); break;
                 case Network::MessageType::PING: handlePing(packet); break;
+                case Network::MessageType::PONG: handlePong(packet); break;
                 case Network::MessageType::SET_MAP: handleSetMap(packet); break;
+                case Network::MessageType::NEXT_MAP_HINT: handleNextMapHint(packet); break;
+                case Network::MessageType::TILE_DELTA: handleTileDelta(packet); break;
                 // Ignore WELCOME/REJECT if already connected? Or handle as error/reset?
                 case Network::MessageType::WELCOME: Log::Warning("Received WELCOME while already connected."); break;
                 case Network::MessageType::REJECT: Log::Warning("Received REJECT while connected."); disconnect(); break;
@@ -456,24 +471,46 @@ void NetworkClient::handlePing(UDPpacket* packet) {
     sendPacketToServer(buffer, 1 /* + packet->len - 1 */);
 }
 
-void NetworkClient::handleSetMap(UDPpacket* packet) {
-    if (!m_mapManager) return;
+void NetworkClient::handlePong(UDPpacket* packet) {
+    // Echo of our PING: [MessageType, uint32 sequence]
+    if (packet->len < 1 + static_cast<int>(sizeof(uint32_t))) return;
+    uint32_t sequence;
+    memcpy(&sequence, packet->data + 1, sizeof(uint32_t));
+    sequence = SDL_SwapBE32(sequence);
+
+    PingSlot& slot = m_pings[sequence % PING_WINDOW];
+    if (slot.sentTime <= 0.0 || slot.sequence != sequence || slot.answered) return; // Too old or duplicate
+    slot.answered = true;
+    double now = SDL_GetPerformanceCounter() / static_cast<double>(SDL_GetPerformanceFrequency());
+    double rttMs = (now - slot.sentTime) * 1000.0;
+    m_stats.rttMs = m_stats.rttMs > 0.0 ? m_stats.rttMs * 0.875 + rttMs * 0.125 : rttMs;
+}
 
+std::string NetworkClient::readMapName(UDPpacket* packet) const {
     // The map name is a null-terminated string starting after the message type byte.
     char mapNameBuffer[256];
-    strncpy(mapNameBuffer, (char*)packet->data + 1, sizeof(mapNameBuffer) - 1);
-    mapNameBuffer[sizeof(mapNameBuffer) - 1] = '\0'; // Ensure null termination
-    std::string mapName = mapNameBuffer;
+    int nameLength = std::max(0, std::min(packet->len - 1, static_cast<int>(sizeof(mapNameBuffer)) - 1));
+    memcpy(mapNameBuffer, packet->data + 1, nameLength);
+    mapNameBuffer[nameLength] = '\0'; // Ensure null termination
+    return mapNameBuffer;
+}
 
+void NetworkClient::handleSetMap(UDPpacket* packet) {
+    if (!m_mapManager) return;
+
+    std::string mapName = readMapName(packet);
     Log::Info("Received SET_MAP command. Map: " + mapName);
 
     if (m_mapManager->getMapName() != mapName) {
         Log::Info("Loading map specified by server: " + mapName);
-        if (!m_mapManager->loadMap(mapName)) {
+        // The change handler swaps in a prefetched map when there is one (see handleNextMapHint)
+        bool loaded = m_mapChangeHandler ? m_mapChangeHandler(mapName) : m_mapManager->loadMap(mapName);
+        if (!loaded) {
             Log::Error("Failed to load map '" + mapName + "' specified by server! Disconnecting.");
             disconnect();
             m_connectionState = ConnectionState::CONNECTION_FAILED;
         } else {
+            m_tileEditsApplied = 0; // Edits applied so far belonged to the map that was replaced
             // Optionally, clear entities now that a new map is loaded.
             // The server should be sending spawn messages for the new map's entities.
             if (m_entityManager) {
@@ -483,6 +520,75 @@ void NetworkClient::handleSetMap(UDPpacket* packet) {
     }
 }
 
+void NetworkClient::handleNextMapHint(UDPpacket* packet) {
+    std::string mapName = readMapName(packet);
+    Log::Info("Received NEXT_MAP_HINT. Map: " + mapName);
+
+    if (m_mapRotation && !mapName.empty() && (!m_mapManager || m_mapManager->getMapName() != mapName)) {
+        m_mapRotation->preload(mapName);
+    }
+}
+
+
+void NetworkClient::handleTileDelta(UDPpacket* packet) {
+    if (!m_mapManager || packet->len < Network::TILE_DELTA_HEADER_SIZE) return;
+
+    uint16_t serial, count;
+    uint32_t first;
+    memcpy(&serial, packet->data + 1, sizeof(uint16_t));
+    memcpy(&first, packet->data + 3, sizeof(uint32_t));
+    memcpy(&count, packet->data + 7, sizeof(uint16_t));
+    serial = SDL_SwapBE16(serial);
+    first = SDL_SwapBE32(first);
+    count = SDL_SwapBE16(count);
+    if (packet->len < Network::TILE_DELTA_HEADER_SIZE + count * Network::TILE_DELTA_EDIT_SIZE) {
+        Log::Warning("Received invalid TILE_DELTA packet (too short).");
+        return;
+    }
+
+    if (serial != m_tileMapSerial) {
+        // Serials only grow (modulo 2^16); an older one is a late packet from a previous map
+        if (m_tileMapSerial != 0 && static_cast<int16_t>(serial - m_tileMapSerial) < 0) return;
+        m_tileMapSerial = serial;
+        m_tileEditsApplied = 0;
+    }
+
+    double currentTime = SDL_GetPerformanceCounter() / static_cast<double>(SDL_GetPerformanceFrequency());
+    if (first > m_tileEditsApplied) {
+        sendTileAck(currentTime); // An earlier packet was lost; the server resends from our count
+        return;
+    }
+
+    int offset = Network::TILE_DELTA_HEADER_SIZE;
+    for (uint16_t i = 0; i < count; ++i) {
+        TileEdit edit;
+        memcpy(&edit.tileX, packet->data + offset, sizeof(uint16_t)); offset += sizeof(uint16_t);
+        memcpy(&edit.tileY, packet->data + offset, sizeof(uint16_t)); offset += sizeof(uint16_t);
+        memcpy(&edit.layer, packet->data + offset, sizeof(uint16_t)); offset += sizeof(uint16_t);
+        edit.solid = packet->data[offset++];
+        memcpy(&edit.gid, packet->data + offset, sizeof(uint32_t)); offset += sizeof(uint32_t);
+        edit.tileX = SDL_SwapBE16(edit.tileX);
+        edit.tileY = SDL_SwapBE16(edit.tileY);
+        edit.layer = SDL_SwapBE16(edit.layer);
+        edit.gid = SDL_SwapBE32(edit.gid);
+        if (first + i < m_tileEditsApplied) continue; // Resent, already applied
+        m_mapManager->applyTileEdit(edit);
+        m_tileEditsApplied = first + i + 1;
+    }
+    sendTileAck(currentTime);
+}
+
+void NetworkClient::sendTileAck(double currentTime) {
+    uint8_t buffer[Network::TILE_ACK_SIZE];
+    buffer[0] = static_cast<uint8_t>(Network::MessageType::TILE_ACK);
+    uint16_t serialNet = SDL_SwapBE16(m_tileMapSerial);
+    uint32_t appliedNet = SDL_SwapBE32(m_tileEditsApplied);
+    memcpy(buffer + 1, &serialNet, sizeof(uint16_t));
+    memcpy(buffer + 3, &appliedNet, sizeof(uint32_t));
+    sendPacketToServer(buffer, sizeof(buffer));
+    m_lastTileAckTime = currentTime;
+}
+
 
 void NetworkClient::applyStateSnapshot(const uint8_t* buffer, int length, double serverTimestamp) {
     (void)buffer; // Suppress unused parameter warning
@@ -526,9 +632,44 @@ bool NetworkClient::sendPacketToServer(const uint8_t* data, int len) {
          // Log::Warning("SDLNet_UDP_Send failed: " + std::string(SDL_NetGetError())); // Can be noisy
          return false;
      }
+     m_bytesSent += static_cast<size_t>(len);
      return true;
 }
 
+void NetworkClient::updateNetworkStats(double currentTime) {
+    if (m_connectionState != ConnectionState::CONNECTED) return;
+
+    if (currentTime - m_lastPingTime >= PING_INTERVAL) {
+        // Loss over pings old enough to have been answered (one second)
+        size_t sent = 0;
+        size_t lost = 0;
+        for (const PingSlot& slot : m_pings) {
+            if (slot.sentTime <= 0.0 || currentTime - slot.sentTime < 1.0) continue;
+            ++sent;
+            if (!slot.answered) ++lost;
+        }
+        m_stats.lossPercent = sent > 0 ? 100.0 * static_cast<double>(lost) / static_cast<double>(sent) : 0.0;
+
+        uint32_t sequence = m_nextPingSequence++;
+        m_pings[sequence % PING_WINDOW] = {sequence, currentTime, false};
+        uint8_t buffer[1 + sizeof(uint32_t)];
+        buffer[0] = static_cast<uint8_t>(Network::MessageType::PING);
+        uint32_t sequenceNet = SDL_SwapBE32(sequence);
+        memcpy(buffer + 1, &sequenceNet, sizeof(uint32_t));
+        sendPacketToServer(buffer, sizeof(buffer));
+        m_lastPingTime = currentTime;
+    }
+
+    double window = currentTime - m_bandwidthWindowStart;
+    if (window >= 1.0) {
+        m_stats.receiveKBps = static_cast<double>(m_bytesReceived) / 1024.0 / window;
+        m_stats.sendKBps = static_cast<double>(m_bytesSent) / 1024.0 / window;
+        m_bytesReceived = 0;
+        m_bytesSent = 0;
+        m_bandwidthWindowStart = currentTime;
+    }
+}
+
 // --- Status Queries ---
 
 bool NetworkClient::isConnected() const {
@@ -21,6 +21,7 @@
 
 #include <vector>
 #include <cstring> // For memcpy, memset
+#include <algorithm> // For std::min
 
 namespace TuxArena {
 
@@ -202,6 +203,12 @@ void NetworkServer::handlePacket(UDPpacket* packet) {
             case Network::MessageType::PONG:
                  handleClientPong(packet, *client);
                  break;
+            case Network::MessageType::PING:
+                 handleClientPing(packet, *client);
+                 break;
+            case Network::MessageType::TILE_ACK:
+                 handleTileAck(packet, *client);
+                 break;
             // Handle ACK, other client->server messages
             default:
                 Log::Warning("Received unknown or unexpected message type (" + std::to_string(static_cast<int>(msgType)) + ") from client ID " + std::to_string(client->clientId));
@@ -281,14 +288,13 @@ void NetworkServer::handleConnectRequest(UDPpacket* packet, const IPaddress& add
     sendPacket(address, welcomeBuffer, sizeof(welcomeBuffer));
     Log::Info("Sent WELCOME to client ID " + std::to_string(client->clientId));
 
-    // 7. Send Set Map Message
-    std::string mapName = m_mapManager ? m_mapManager->getMapName() : "default.tmx";
-    size_t mapPacketLen = 1 + mapName.length() + 1;
-    uint8_t mapBuffer[mapPacketLen];
-    mapBuffer[0] = static_cast<uint8_t>(Network::MessageType::SET_MAP);
-    strcpy((char*)mapBuffer + 1, mapName.c_str());
-    sendPacket(address, mapBuffer, mapPacketLen);
-    Log::Info("Sent SET_MAP to client ID " + std::to_string(client->clientId) + " with map: " + mapName);
+    // 7. Send Set Map Message (and the upcoming map, so the client can prefetch it)
+    sendMapMessage(address, Network::MessageType::SET_MAP, m_mapManager ? m_mapManager->getMapName() : "default.tmx");
+    if (!m_nextMapName.empty()) {
+        sendMapMessage(address, Network::MessageType::NEXT_MAP_HINT, m_nextMapName);
+    }
+
+    // Tiles destroyed before the client joined go out with the next update (tileEditsAcked is 0)
 
     // 8. Spawn Player Entity
     EntityContext playerSpawnContext;
@@ -296,8 +302,7 @@ void NetworkServer::handleConnectRequest(UDPpacket* packet, const IPaddress& add
     playerSpawnContext.mapManager = m_mapManager;
     playerSpawnContext.isServer = true;
 
-    // TODO: Get spawn point from map
-    Vec2 spawnPos = {100.0f, 100.0f};
+    Vec2 spawnPos = pickSpawnPosition();
     Entity* player = m_entityManager->createEntity(EntityType::PLAYER, spawnPos, playerSpawnContext);
     if (player) {
         client->playerEntity = player;
@@ -307,22 +312,132 @@ void NetworkServer::handleConnectRequest(UDPpacket* packet, const IPaddress& add
         // TODO: Send SPAWN_ENTITY message for the *new* player to all *other* clients
 
         // Send a SPAWN_ENTITY message for the new player to the new client
-        uint8_t spawnBuffer[1 + sizeof(uint32_t) + sizeof(uint8_t) + sizeof(Vec2) + sizeof(float)];
-        spawnBuffer[0] = static_cast<uint8_t>(Network::MessageType::SPAWN_ENTITY);
-        uint32_t entityIdNet = SDL_SwapBE32(player->getId());
-        uint8_t entityType = static_cast<uint8_t>(player->getType());
-        memcpy(spawnBuffer + 1, &entityIdNet, sizeof(uint32_t));
-        memcpy(spawnBuffer + 1 + sizeof(uint32_t), &entityType, sizeof(uint8_t));
-        memcpy(spawnBuffer + 1 + sizeof(uint32_t) + sizeof(uint8_t), &spawnPos, sizeof(Vec2));
-        float rotation = player->getRotation();
-        memcpy(spawnBuffer + 1 + sizeof(uint32_t) + sizeof(uint8_t) + sizeof(Vec2), &rotation, sizeof(float));
-        sendPacket(address, spawnBuffer, sizeof(spawnBuffer));
+        sendSpawnEntity(address, player);
 
     } else {
         Log::Error("Failed to spawn player entity for client ID " + std::to_string(client->clientId));
     }
 }
 
+// --- Map Rotation ---
+
+void NetworkServer::changeMap(MapManager* mapManager) {
+    if (!mapManager) return;
+    m_mapManager = mapManager;
+    if (!m_isInitialized) return;
+
+    if (++m_mapSerial == 0) m_mapSerial = 1; // Acks for the old map's edits no longer count
+    std::string mapName = m_mapManager->getMapName();
+    if (mapName == m_nextMapName) {
+        m_nextMapName.clear();
+    }
+    Log::Info("Changing map to: " + mapName);
+
+    // Anything that is not a player belongs to the old map
+    if (m_entityManager) {
+        for (Entity* entity : m_entityManager->getActiveEntities()) {
+            if (entity->getType() != EntityType::PLAYER) {
+                m_entityManager->destroyEntity(entity->getId());
+            }
+        }
+    }
+
+    // Clients drop their entities on SET_MAP, so re-announce each player at its new spawn point
+    for (auto& [clientId, clientInfo] : m_clients) {
+        if (!clientInfo.isConnected) continue;
+        clientInfo.tileEditsAcked = 0;
+        clientInfo.tileEditsSent = 0;
+        sendMapMessage(clientInfo.address, Network::MessageType::SET_MAP, mapName);
+        if (clientInfo.playerEntity) {
+            clientInfo.playerEntity->setPosition(pickSpawnPosition());
+            sendSpawnEntity(clientInfo.address, clientInfo.playerEntity);
+        }
+    }
+}
+
+void NetworkServer::setNextMapHint(const std::string& mapName) {
+    m_nextMapName = mapName;
+    if (!m_isInitialized || mapName.empty()) return;
+
+    for (const auto& [clientId, clientInfo] : m_clients) {
+        if (clientInfo.isConnected) {
+            sendMapMessage(clientInfo.address, Network::MessageType::NEXT_MAP_HINT, mapName);
+        }
+    }
+    Log::Info("Sent NEXT_MAP_HINT to clients: " + mapName);
+}
+
+void NetworkServer::sendMapMessage(const IPaddress& dest, Network::MessageType type, const std::string& mapName) {
+    // Buffer: [MessageType, null-terminated map name]
+    uint8_t buffer[Network::MAX_PACKET_SIZE];
+    size_t nameLength = std::min(mapName.length(), static_cast<size_t>(Network::MAX_PACKET_SIZE - 2));
+    buffer[0] = static_cast<uint8_t>(type);
+    memcpy(buffer + 1, mapName.c_str(), nameLength);
+    buffer[1 + nameLength] = '\0';
+    sendPacket(dest, buffer, static_cast<int>(nameLength + 2));
+}
+
+void NetworkServer::sendSpawnEntity(const IPaddress& dest, Entity* entity) {
+    // Buffer: [MessageType::SPAWN_ENTITY, EntityID, EntityType, Position, Rotation]
+    uint8_t spawnBuffer[1 + sizeof(uint32_t) + sizeof(uint8_t) + sizeof(Vec2) + sizeof(float)];
+    spawnBuffer[0] = static_cast<uint8_t>(Network::MessageType::SPAWN_ENTITY);
+    uint32_t entityIdNet = SDL_SwapBE32(entity->getId());
+    uint8_t entityType = static_cast<uint8_t>(entity->getType());
+    Vec2 position = entity->getPosition();
+    float rotation = entity->getRotation();
+    memcpy(spawnBuffer + 1, &entityIdNet, sizeof(uint32_t));
+    memcpy(spawnBuffer + 1 + sizeof(uint32_t), &entityType, sizeof(uint8_t));
+    memcpy(spawnBuffer + 1 + sizeof(uint32_t) + sizeof(uint8_t), &position, sizeof(Vec2));
+    memcpy(spawnBuffer + 1 + sizeof(uint32_t) + sizeof(uint8_t) + sizeof(Vec2), &rotation, sizeof(float));
+    sendPacket(dest, spawnBuffer, sizeof(spawnBuffer));
+}
+
+void NetworkServer::sendTileEdits(const IPaddress& dest, size_t first, size_t last) {
+    if (!m_mapManager) return;
+    const auto& edits = m_mapManager->getTileEdits();
+    last = std::min(last, edits.size());
+
+    const size_t maxEditsPerPacket = (Network::MAX_PACKET_SIZE - Network::TILE_DELTA_HEADER_SIZE) / Network::TILE_DELTA_EDIT_SIZE;
+    uint8_t buffer[Network::MAX_PACKET_SIZE];
+    while (first < last) {
+        size_t count = std::min(last - first, maxEditsPerPacket);
+        buffer[0] = static_cast<uint8_t>(Network::MessageType::TILE_DELTA);
+        uint16_t serialNet = SDL_SwapBE16(m_mapSerial);
+        uint32_t firstNet = SDL_SwapBE32(static_cast<uint32_t>(first));
+        uint16_t countNet = SDL_SwapBE16(static_cast<uint16_t>(count));
+        memcpy(buffer + 1, &serialNet, sizeof(uint16_t));
+        memcpy(buffer + 3, &firstNet, sizeof(uint32_t));
+        memcpy(buffer + 7, &countNet, sizeof(uint16_t));
+
+        int offset = Network::TILE_DELTA_HEADER_SIZE;
+        for (size_t i = first; i < first + count; ++i) {
+            const TileEdit& edit = edits[i];
+            uint16_t tileX = SDL_SwapBE16(edit.tileX);
+            uint16_t tileY = SDL_SwapBE16(edit.tileY);
+            uint16_t layer = SDL_SwapBE16(edit.layer);
+            uint32_t gid = SDL_SwapBE32(edit.gid);
+            memcpy(buffer + offset, &tileX, sizeof(uint16_t)); offset += sizeof(uint16_t);
+            memcpy(buffer + offset, &tileY, sizeof(uint16_t)); offset += sizeof(uint16_t);
+            memcpy(buffer + offset, &layer, sizeof(uint16_t)); offset += sizeof(uint16_t);
+            buffer[offset++] = edit.solid;
+            memcpy(buffer + offset, &gid, sizeof(uint32_t)); offset += sizeof(uint32_t);
+        }
+
+        sendPacket(dest, buffer, offset);
+        first += count;
+    }
+}
+
+Vec2 NetworkServer::pickSpawnPosition() {
+    // Cycle through the map's spawn points so players don't stack on the same one
+    if (m_mapManager && !m_mapManager->getSpawnPoints().empty()) {
+        const auto& spawnPoints = m_mapManager->getSpawnPoints();
+        const SpawnPoint& spawn = spawnPoints[m_nextSpawnIndex++ % spawnPoints.size()];
+        return {spawn.x, spawn.y};
+    }
+    return {100.0f, 100.0f};
+}
+
 void NetworkServer::handleClientInput(UDPpacket* packet, ClientInfo& client) {
      // TODO: Deserialize Network::PlayerInputState from packet->data + 1
      // Validate input sequence number to handle out-of-order/duplicate packets
@@ -349,6 +464,26 @@ void NetworkServer::handleClientPong(UDPpacket* packet, ClientInfo& client) {
     // Log::Info("Received PONG from client ID " + std::to_string(client.clientId));
 }
 
+void NetworkServer::handleClientPing(UDPpacket* packet, ClientInfo& client) {
+    // Client-side RTT measurement: echo the payload back as a PONG right away
+    if (packet->len > Network::MAX_PACKET_SIZE) return;
+    uint8_t buffer[Network::MAX_PACKET_SIZE];
+    memcpy(buffer, packet->data, packet->len);
+    buffer[0] = static_cast<uint8_t>(Network::MessageType::PONG);
+    sendPacket(client.address, buffer, packet->len);
+}
+
+
+void NetworkServer::handleTileAck(UDPpacket* packet, ClientInfo& client) {
+    if (packet->len < Network::TILE_ACK_SIZE || !m_mapManager) return;
+    uint16_t serial;
+    uint32_t applied;
+    memcpy(&serial, packet->data + 1, sizeof(uint16_t));
+    memcpy(&applied, packet->data + 3, sizeof(uint32_t));
+    if (SDL_SwapBE16(serial) != m_mapSerial) return; // Late ack for a previous map
+    // The client's count, not a maximum: it drops back to 0 when it reloads the map
+    client.tileEditsAcked = std::min(static_cast<size_t>(SDL_SwapBE32(applied)), m_mapManager->getTileEdits().size());
+}
 
 void NetworkServer::sendUpdates() {
     if (!m_isInitialized) return;
@@ -412,6 +547,25 @@ void NetworkServer::sendUpdates() {
 
     // --- Broadcast State ---
     if (!m_clients.empty()) { // Only send if there are clients to send to
+        // Tile edits: new ones right away, unacknowledged ones again every TILE_RESEND_INTERVAL, since
+        // UDP may drop them and a missed destroyed wall would desync collision for the rest of the map.
+        // Only the resends carry the whole unacknowledged range, so the backlog of a destruction-heavy
+        // round costs one resend per interval, not one per tick.
+        size_t editCount = m_mapManager ? m_mapManager->getTileEdits().size() : 0;
+        double now = SDL_GetTicks() / 1000.0;
+        for (auto& [clientId, clientInfo] : m_clients) {
+            if (!clientInfo.isConnected || clientInfo.tileEditsAcked >= editCount) continue;
+            size_t first = std::max(clientInfo.tileEditsSent, clientInfo.tileEditsAcked);
+            bool resend = now - clientInfo.lastTileEditSendTime >= Network::TILE_RESEND_INTERVAL;
+            if (resend || first == clientInfo.tileEditsAcked) {
+                first = clientInfo.tileEditsAcked; // Nothing outstanding, or time to send it all again
+                clientInfo.lastTileEditSendTime = now;
+            } else if (first >= editCount) {
+                continue; // Everything sent, still waiting for the ack
+            }
+            sendTileEdits(clientInfo.address, first, editCount);
+            clientInfo.tileEditsSent = editCount;
+        }
         broadcastPacket(m_sendBuffer, bytesWritten);
         // Log::Info("Server sent STATE_UPDATE with " + std::to_string(numEntities) + " entities, size: " + std::to_string(bytesWritten) + " bytes.");
     }
@@ -0,0 +1,196 @@
+// src/ParticleKernels.cpp
+#include "TuxArena/ParticleKernels.h"
+
+#include <algorithm> // For std::min, std::max
+#include <cstring>   // For std::memcpy, std::strcmp
+
+// x86 builds compile the SSE2 and AVX2 kernels with per-function target attributes, so the rest of
+// the game keeps the default instruction set and the AVX2 path is only taken after a CPU check.
+#if (defined(__x86_64__) || (defined(__i386__) && defined(__SSE2__))) && (defined(__GNUC__) || defined(__clang__))
+#define TUXARENA_PARTICLE_SIMD_X86 1
+#include <immintrin.h>
+#endif
+
+namespace TuxArena
+{
+
+    namespace
+    {
+        using IntegrateFn = void (*)(const ParticleArrays&, size_t, size_t, float);
+        using FindDeadFn = size_t (*)(const float*, size_t, size_t);
+
+        void integrateScalar(const ParticleArrays& p, size_t begin, size_t end, float deltaTime)
+        {
+            for (size_t i = begin; i < end; ++i)
+            {
+                float life = p.life[i] - deltaTime;
+                p.life[i] = life;
+                p.x[i] += p.velocityX[i] * deltaTime;
+                p.y[i] += p.velocityY[i] * deltaTime;
+                float damping = std::max(0.0f, 1.0f - p.drag[i] * deltaTime);
+                p.velocityX[i] *= damping;
+                p.velocityY[i] *= damping;
+                float alpha = 255.0f * (1.0f - p.fade[i] * (1.0f - life * p.inverseLifetime[i]));
+                p.alpha[i] = static_cast<uint8_t>(std::min(255.0f, std::max(0.0f, alpha)));
+            }
+        }
+
+        size_t findDeadScalar(const float* life, size_t begin, size_t end)
+        {
+            for (size_t i = begin; i < end; ++i)
+            {
+                if (life[i] <= 0.0f) return i;
+            }
+            return end;
+        }
+
+#ifdef TUXARENA_PARTICLE_SIMD_X86
+        void integrateSse2(const ParticleArrays& p, size_t begin, size_t end, float deltaTime)
+        {
+            const __m128 dt = _mm_set1_ps(deltaTime);
+            const __m128 zero = _mm_setzero_ps();
+            const __m128 one = _mm_set1_ps(1.0f);
+            const __m128 full = _mm_set1_ps(255.0f);
+            size_t i = begin;
+            for (; i + 4 <= end; i += 4)
+            {
+                __m128 life = _mm_sub_ps(_mm_loadu_ps(p.life + i), dt);
+                _mm_storeu_ps(p.life + i, life);
+                __m128 velocityX = _mm_loadu_ps(p.velocityX + i);
+                __m128 velocityY = _mm_loadu_ps(p.velocityY + i);
+                _mm_storeu_ps(p.x + i, _mm_add_ps(_mm_loadu_ps(p.x + i), _mm_mul_ps(velocityX, dt)));
+                _mm_storeu_ps(p.y + i, _mm_add_ps(_mm_loadu_ps(p.y + i), _mm_mul_ps(velocityY, dt)));
+                __m128 damping = _mm_max_ps(zero, _mm_sub_ps(one, _mm_mul_ps(_mm_loadu_ps(p.drag + i), dt)));
+                _mm_storeu_ps(p.velocityX + i, _mm_mul_ps(velocityX, damping));
+                _mm_storeu_ps(p.velocityY + i, _mm_mul_ps(velocityY, damping));
+
+                __m128 remaining = _mm_sub_ps(one, _mm_mul_ps(life, _mm_loadu_ps(p.inverseLifetime + i)));
+                __m128 alpha = _mm_mul_ps(full, _mm_sub_ps(one, _mm_mul_ps(_mm_loadu_ps(p.fade + i), remaining)));
+                alpha = _mm_min_ps(full, _mm_max_ps(zero, alpha));
+                // Truncate like the scalar cast, then narrow 4 x int32 to 4 bytes
+                __m128i alpha32 = _mm_cvttps_epi32(alpha);
+                __m128i alpha8 = _mm_packus_epi16(_mm_packs_epi32(alpha32, alpha32), _mm_setzero_si128());
+                int packed = _mm_cvtsi128_si32(alpha8);
+                std::memcpy(p.alpha + i, &packed, 4);
+            }
+            integrateScalar(p, i, end, deltaTime);
+        }
+
+        size_t findDeadSse2(const float* life, size_t begin, size_t end)
+        {
+            const __m128 zero = _mm_setzero_ps();
+            size_t i = begin;
+            for (; i + 4 <= end; i += 4)
+            {
+                int mask = _mm_movemask_ps(_mm_cmple_ps(_mm_loadu_ps(life + i), zero));
+                if (mask != 0) return i + static_cast<size_t>(__builtin_ctz(static_cast<unsigned>(mask)));
+            }
+            return findDeadScalar(life, i, end);
+        }
+
+        __attribute__((target("avx2"))) void integrateAvx2(const ParticleArrays& p, size_t begin, size_t end, float deltaTime)
+        {
+            const __m256 dt = _mm256_set1_ps(deltaTime);
+            const __m256 zero = _mm256_setzero_ps();
+            const __m256 one = _mm256_set1_ps(1.0f);
+            const __m256 full = _mm256_set1_ps(255.0f);
+            size_t i = begin;
+            for (; i + 8 <= end; i += 8)
+            {
+                __m256 life = _mm256_sub_ps(_mm256_loadu_ps(p.life + i), dt);
+                _mm256_storeu_ps(p.life + i, life);
+                __m256 velocityX = _mm256_loadu_ps(p.velocityX + i);
+                __m256 velocityY = _mm256_loadu_ps(p.velocityY + i);
+                _mm256_storeu_ps(p.x + i, _mm256_add_ps(_mm256_loadu_ps(p.x + i), _mm256_mul_ps(velocityX, dt)));
+                _mm256_storeu_ps(p.y + i, _mm256_add_ps(_mm256_loadu_ps(p.y + i), _mm256_mul_ps(velocityY, dt)));
+                __m256 damping = _mm256_max_ps(zero, _mm256_sub_ps(one, _mm256_mul_ps(_mm256_loadu_ps(p.drag + i), dt)));
+                _mm256_storeu_ps(p.velocityX + i, _mm256_mul_ps(velocityX, damping));
+                _mm256_storeu_ps(p.velocityY + i, _mm256_mul_ps(velocityY, damping));
+
+                __m256 remaining = _mm256_sub_ps(one, _mm256_mul_ps(life, _mm256_loadu_ps(p.inverseLifetime + i)));
+                __m256 alpha = _mm256_mul_ps(full, _mm256_sub_ps(one, _mm256_mul_ps(_mm256_loadu_ps(p.fade + i), remaining)));
+                alpha = _mm256_min_ps(full, _mm256_max_ps(zero, alpha));
+                // Truncate like the scalar cast, then narrow 8 x int32 to 8 bytes
+                __m256i alpha32 = _mm256_cvttps_epi32(alpha);
+                __m128i alpha16 = _mm_packs_epi32(_mm256_castsi256_si128(alpha32), _mm256_extracti128_si256(alpha32, 1));
+                _mm_storel_epi64(reinterpret_cast<__m128i*>(p.alpha + i), _mm_packus_epi16(alpha16, alpha16));
+            }
+            integrateScalar(p, i, end, deltaTime);
+        }
+
+        __attribute__((target("avx2"))) size_t findDeadAvx2(const float* life, size_t begin, size_t end)
+        {
+            const __m256 zero = _mm256_setzero_ps();
+            size_t i = begin;
+            for (; i + 8 <= end; i += 8)
+            {
+                int mask = _mm256_movemask_ps(_mm256_cmp_ps(_mm256_loadu_ps(life + i), zero, _CMP_LE_OQ));
+                if (mask != 0) return i + static_cast<size_t>(__builtin_ctz(static_cast<unsigned>(mask)));
+            }
+            return findDeadScalar(life, i, end);
+        }
+#endif
+
+        struct Kernels
+        {
+            IntegrateFn integrate;
+            FindDeadFn findDead;
+            const char* name;
+        };
+
+        Kernels selectKernels()
+        {
+#ifdef TUXARENA_PARTICLE_SIMD_X86
+            __builtin_cpu_init();
+            if (__builtin_cpu_supports("avx2")) return {integrateAvx2, findDeadAvx2, "AVX2"};
+            return {integrateSse2, findDeadSse2, "SSE2"}; // Baseline on x86-64
+#else
+            return {integrateScalar, findDeadScalar, "scalar"};
+#endif
+        }
+
+        Kernels& getKernels()
+        {
+            static Kernels kernels = selectKernels(); // Thread-safe one-time initialization
+            return kernels;
+        }
+    } // anonymous namespace
+
+    void integrateParticles(const ParticleArrays& particles, size_t count, float deltaTime)
+    {
+        getKernels().integrate(particles, 0, count, deltaTime);
+    }
+
+    size_t findDeadParticle(const float* life, size_t begin, size_t end)
+    {
+        return getKernels().findDead(life, begin, end);
+    }
+
+    const char* getParticleKernelName()
+    {
+        return getKernels().name;
+    }
+
+    bool selectParticleKernel(const char* name)
+    {
+        const Kernels candidates[] = {
+#ifdef TUXARENA_PARTICLE_SIMD_X86
+            {integrateAvx2, findDeadAvx2, "AVX2"},
+            {integrateSse2, findDeadSse2, "SSE2"},
+#endif
+            {integrateScalar, findDeadScalar, "scalar"},
+        };
+        for (const Kernels& candidate : candidates)
+        {
+            if (std::strcmp(candidate.name, name) != 0) continue;
+#ifdef TUXARENA_PARTICLE_SIMD_X86
+            __builtin_cpu_init();
+            if (candidate.integrate == integrateAvx2 && !__builtin_cpu_supports("avx2")) return false;
+#endif
+            getKernels() = candidate;
+            return true;
+        }
+        return false;
+    }
+
+} // namespace TuxArena
@@ -1,5 +1,7 @@
 #include "TuxArena/ParticleManager.h"
+#include "TuxArena/Random.h"
 #include "TuxArena/Renderer.h"
+#include <algorithm>
 #include <cmath>
 
 namespace TuxArena
@@ -7,65 +9,142 @@ namespace TuxArena
 
     void ParticleManager::update(float deltaTime)
     {
-        for (auto it = m_particles.begin(); it != m_particles.end();)
+        // Integrate and fade everything with the widest kernel the CPU has, then swap-and-pop the dead
+        ParticlePool& pool = m_pool;
+        integrateParticles(pool.getArrays(), pool.getSize(), deltaTime);
+        pool.removeDead([this, &pool](size_t i)
         {
-            it->lifetime -= deltaTime;
-            if (it->lifetime <= 0)
+            // Settled blood stays on the floor as a decal instead of as a particle. Blood does not
+            // fade, so its alpha is still the emitted one.
+            if (pool.type[i] == ParticleType::Blood)
             {
-                it = m_particles.erase(it);
+                const Color& c = pool.color[i];
+                addDecal(pool.x[i], pool.y[i], pool.size[i], {c.r, c.g, c.b, pool.alpha[i]});
             }
-            else
-            {
-                it->position.x += it->velocity.x * deltaTime;
-                it->position.y += it->velocity.y * deltaTime;
-                // Fade out
-                it->color.a = static_cast<uint8_t>(255 * (it->lifetime / it->initialLifetime));
-                ++it;
-            }
-        }
+        });
     }
 
     void ParticleManager::render(Renderer& renderer)
     {
-        for (const auto& p : m_particles)
+        // Visible particles go into one sprite array and are drawn as a single batch
+        SDL_FRect view = renderer.getVisibleWorldRect();
+        float viewRight = view.x + view.w;
+        float viewBottom = view.y + view.h;
+        m_sprites.clear();
+        const ParticlePool& pool = m_pool;
+        for (size_t i = 0; i < pool.getSize(); ++i)
         {
-            renderer.drawCircle(p.position.x, p.position.y, p.size, p.color, true); // Draw as filled circle
+            float x = pool.x[i];
+            float y = pool.y[i];
+            float size = pool.size[i];
+            if (x + size < view.x || x - size > viewRight || y + size < view.y || y - size > viewBottom) continue;
+            const Color& c = pool.color[i];
+            m_sprites.push_back({x, y, size, {c.r, c.g, c.b, pool.alpha[i]}});
         }
+        renderer.drawPointSprites(m_sprites.data(), m_sprites.size());
+
+        renderer.addDecals(m_pendingDecals.data(), m_pendingDecals.size());
+        m_pendingDecals.clear();
+    }
+
+    void ParticleManager::addDecal(float x, float y, float radius, const Color& color)
+    {
+        if (m_pendingDecals.size() >= MAX_PENDING_DECALS) return;
+        m_pendingDecals.push_back({x, y, radius, {color.r, color.g, color.b, color.a}});
     }
 
     void ParticleManager::emitBlood(float x, float y, int count)
     {
-        for (int i = 0; i < count; ++i)
+        if (count <= 0) return;
+        // Always at least one particle, so every hit still shows
+        int scaledCount = std::max(1, static_cast<int>(std::lround(count * priorityShare(ParticlePriority::High))));
+        // All random values of the burst in one bulk call, BLOOD_RANDOM_VALUES per particle
+        m_randomValues.resize(static_cast<size_t>(scaledCount) * BLOOD_RANDOM_VALUES);
+        getRandom(RandomStream::Effects).fillFloats(m_randomValues.data(), m_randomValues.size(), 0.0f, 1.0f);
+        for (int i = 0; i < scaledCount && hasRoom(ParticlePriority::High); ++i)
         {
-            Particle p;
-            p.position = { x, y };
-            float angle = (float)(rand() % 360) * M_PI / 180.0f;
-            float speed = (float)(rand() % 150 + 50);
-            p.velocity = { std::cos(angle) * speed, std::sin(angle) * speed };
+            const float* r = m_randomValues.data() + static_cast<size_t>(i) * BLOOD_RANDOM_VALUES;
+            ParticleSpawn p;
+            p.x = x;
+            p.y = y;
+            float angle = r[0] * 2.0f * static_cast<float>(M_PI);
+            float speed = 50.0f + r[1] * 150.0f;
+            p.velocityX = std::cos(angle) * speed;
+            p.velocityY = std::sin(angle) * speed;
             // Darker, more desaturated blood color
-            p.color = { (uint8_t)(rand() % 30 + 100), (uint8_t)(rand() % 20), (uint8_t)(rand() % 20), 255 };
-            p.lifetime = (float)(rand() % 100) / 100.0f + 0.5f;
-            p.initialLifetime = p.lifetime;
-            p.size = (float)(rand() % 2 + 1); // Smaller size for point-like particles
+            p.color = { static_cast<uint8_t>(100.0f + r[2] * 30.0f), static_cast<uint8_t>(r[3] * 20.0f), static_cast<uint8_t>(r[4] * 20.0f), 255 };
+            p.lifetime = scaledLifetime(0.5f + r[5]);
+            p.size = r[6] < 0.5f ? 1.0f : 2.0f; // Smaller size for point-like particles
+            p.drag = 4.0f; // Slides to a stop, at full opacity, where it is baked into a decal
+            p.fade = 0.0f;
             p.type = ParticleType::Blood;
-            m_particles.push_back(p);
+            m_pool.add(p);
         }
     }
 
     void ParticleManager::emitBulletTrail(float x, float y, float dirX, float dirY)
     {
-        Particle p;
-        p.position = { x, y };
+        m_trailCredit += priorityShare(ParticlePriority::Low);
+        if (m_trailCredit < 1.0f || !hasRoom(ParticlePriority::Low)) return;
+        m_trailCredit -= 1.0f;
+
+        ParticleSpawn p;
+        p.x = x;
+        p.y = y;
         // Bullet trail particles should move slightly in the direction of the bullet
         // and then dissipate quickly.
         float speed = 50.0f; // Slower speed for trails
-        p.velocity = { dirX * speed, dirY * speed };
-        p.color = { 255, 255, 200, 200 }; // Faint yellow/white for bullet trails
-        p.lifetime = 0.2f; // Short lifetime
-        p.initialLifetime = p.lifetime;
+        p.velocityX = dirX * speed;
+        p.velocityY = dirY * speed;
+        p.color = { 255, 255, 200, 255 }; // Faint yellow/white for bullet trails
+        p.lifetime = scaledLifetime(0.2f); // Short lifetime
         p.size = 1.0f; // Small size
+        p.drag = 0.0f;
+        p.fade = 1.0f;
         p.type = ParticleType::BulletTrail;
-        m_particles.push_back(p);
+        m_pool.add(p);
+    }
+
+    void ParticleManager::reportFrameTime(float frameMs, float targetMs)
+    {
+        if (targetMs <= 0.0f) return;
+        // Smoothed so a single slow frame (GC in a mod, disk hitch) does not strip the effects
+        m_smoothedFrameMs = m_smoothedFrameMs > 0.0f ? m_smoothedFrameMs * 0.9f + frameMs * 0.1f : frameMs;
+        if (m_smoothedFrameMs > targetMs)
+        {
+            m_quality *= 0.95f; // Back off fast while over budget
+        }
+        else if (m_smoothedFrameMs < targetMs * 0.75f)
+        {
+            m_quality += 0.01f; // Recover over ~1.5 s at 60 FPS
+        }
+        m_quality = std::clamp(m_quality, MIN_QUALITY, 1.0f);
+    }
+
+    size_t ParticleManager::getBudget() const
+    {
+        return static_cast<size_t>(static_cast<float>(MAX_PARTICLES) * m_quality);
+    }
+
+    size_t ParticleManager::getParticleCount(ParticleType type) const
+    {
+        return static_cast<size_t>(std::count(m_pool.type.begin(), m_pool.type.begin() + static_cast<std::ptrdiff_t>(m_pool.getSize()), type));
+    }
+
+    float ParticleManager::priorityShare(ParticlePriority priority) const
+    {
+        return priority == ParticlePriority::High ? m_quality : m_quality * m_quality;
+    }
+
+    bool ParticleManager::hasRoom(ParticlePriority priority) const
+    {
+        size_t budget = getBudget();
+        return m_pool.getSize() < (priority == ParticlePriority::High ? budget : budget / 2);
+    }
+
+    float ParticleManager::scaledLifetime(float lifetime) const
+    {
+        return lifetime * (0.5f + 0.5f * m_quality);
     }
 
 } // namespace TuxArena
@@ -0,0 +1,74 @@
+// src/PerfOverlay.cpp
+#include "TuxArena/PerfOverlay.h"
+#include "TuxArena/EntityManager.h"
+#include "TuxArena/NetworkClient.h"
+#include "TuxArena/RenderThread.h"
+#include "TuxArena/Renderer.h"
+
+#include "imgui.h"
+#include "imgui_impl_opengl3.h"
+#include "imgui_impl_sdl2.h"
+
+namespace TuxArena {
+
+void PerfOverlay::build(const Profiler& profiler, const FrameStats& frameStats, Renderer& renderer, RenderThread* renderThread,
+                        EntityManager* entityManager, const NetworkClient* networkClient) {
+    Renderer::ReplayStats replayStats = renderThread ? renderThread->getReplayStats() : renderer.getReplayStats();
+
+    // The renderer's context, shared with UIManager. The GL backend's device objects were created at
+    // init, so its NewFrame() makes no GL calls and is safe while the render thread owns the context.
+    ImGui::SetCurrentContext(renderer.getImGuiContext());
+    ImGui_ImplOpenGL3_NewFrame();
+    ImGui_ImplSDL2_NewFrame();
+    ImGui::NewFrame();
+
+    ImGui::SetNextWindowPos(ImVec2(10.0f, 36.0f), ImGuiCond_Always);
+    ImGui::SetNextWindowBgAlpha(0.75f);
+    ImGui::Begin("Performance", nullptr,
+                 ImGuiWindowFlags_NoDecoration | ImGuiWindowFlags_AlwaysAutoResize | ImGuiWindowFlags_NoSavedSettings |
+                 ImGuiWindowFlags_NoFocusOnAppearing | ImGuiWindowFlags_NoNav | ImGuiWindowFlags_NoInputs);
+
+    // Frame pacing (FramePacer window) and graphs (Profiler history)
+    double fps = frameStats.meanFrameMs > 0.0 ? 1000.0 / frameStats.meanFrameMs : 0.0;
+    ImGui::Text("Frame %.2f ms (%.0f FPS)  jitter %.2f  max %.2f", frameStats.meanFrameMs, fps, frameStats.stdDevFrameMs, frameStats.maxFrameMs);
+    ImGui::Text("Work %.2f ms  input latency %.2f ms", frameStats.workMs, frameStats.inputLatencyMs);
+    int historySize = static_cast<int>(Profiler::HISTORY);
+    int historyOffset = static_cast<int>(profiler.getHistoryOffset());
+    ImGui::PlotLines("##frame", profiler.getFrameTimes().data(), historySize, historyOffset, "frame ms", 0.0f, 50.0f, ImVec2(300.0f, 48.0f));
+    ImGui::PlotLines("##tick", profiler.getStageTimes(ProfileStage::Simulation).data(), historySize, historyOffset, "tick ms", 0.0f, 16.0f, ImVec2(300.0f, 48.0f));
+
+    ImGui::Separator();
+    ImGui::Text("%-18s %7s %7s", "Stage", "mean", "max");
+    for (size_t i = 0; i < Profiler::STAGE_COUNT; ++i) {
+        ProfileStage stage = static_cast<ProfileStage>(i);
+        ImGui::Text("%-18s %7.2f %7.2f", Profiler::getStageName(stage), profiler.getStageMean(stage), profiler.getStageMax(stage));
+    }
+
+    ImGui::Separator();
+    ImGui::Text("Draw calls %zu  triangles %zu  commands %zu", replayStats.drawCalls, replayStats.triangles, replayStats.commandCount);
+    ImGui::Text("Texture memory %.1f MiB", static_cast<double>(replayStats.textureBytes) / (1024.0 * 1024.0));
+    const Renderer::TextureCacheStats& textureCache = replayStats.textureCache;
+    ImGui::Text("Texture cache %.1f / %.0f MiB (atlas %.0f MiB)  %zu textures (%zu unused)  %zu evicted",
+                static_cast<double>(textureCache.bytes) / (1024.0 * 1024.0), static_cast<double>(textureCache.budget) / (1024.0 * 1024.0),
+                static_cast<double>(textureCache.atlasBytes) / (1024.0 * 1024.0),
+                textureCache.textures, textureCache.unreferenced, textureCache.evictions);
+
+    if (entityManager) {
+        ImGui::Separator();
+        entityManager->renderDebug(renderer);
+    }
+
+    ImGui::Separator();
+    if (networkClient && networkClient->isConnected()) {
+        const NetworkStats& network = networkClient->getNetworkStats();
+        ImGui::Text("RTT %.0f ms  loss %.0f%%", network.rttMs, network.lossPercent);
+        ImGui::Text("In %.1f KB/s  out %.1f KB/s", network.receiveKBps, network.sendKBps);
+    } else {
+        ImGui::TextUnformatted("Network: not connected");
+    }
+
+    ImGui::End();
+    ImGui::Render();
+}
+
+} // namespace TuxArena
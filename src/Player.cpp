@@ -1,5 +1,6 @@
 // src/Player.cpp
 #include "TuxArena/Player.h"
+#include "TuxArena/Camera.h"
 #include "TuxArena/InputManager.h"
 #include "TuxArena/Renderer.h"
 #include "TuxArena/EntityManager.h"
@@ -7,6 +8,7 @@
 #include "TuxArena/Log.h"
 #include "TuxArena/MapManager.h"
 #include "TuxArena/ParticleManager.h"
+#include "TuxArena/Profiler.h"
 
 #include <cmath> // For std::sin, std::cos, std::atan2, std::sqrt
 #include <algorithm> // For std::min, std::max
@@ -22,11 +24,15 @@ Player::Player(EntityManager* manager)
 void Player::initialize(const EntityContext& context) {
     Log::Info("Player initialized.");
 
-    // Load player texture and stats based on selected character
+    // Load player texture and stats based on selected character (re-initialization drops the previous reference)
+    if (context.renderer) {
+        context.renderer->releaseTexture(m_playerTexture);
+        m_playerTexture = {};
+    }
     if (context.modManager && !context.playerCharacterId.empty()) {
         const CharacterInfo* selectedChar = context.modManager->getCharacterDefinition(context.playerCharacterId);
         if (selectedChar) {
-            m_playerTexture = context.renderer->loadTexture(selectedChar->texturePath);
+            m_playerTexture = context.renderer->acquireTexture(selectedChar->texturePath);
             if (!m_playerTexture) {
                 Log::Error("Failed to load texture for selected character: " + selectedChar->texturePath);
             }
@@ -36,7 +42,7 @@ void Player::initialize(const EntityContext& context) {
         } else {
             Log::Warning("Selected character ID '" + context.playerCharacterId + "' not found in ModManager. Using default stats and texture.");
             // Fallback to default texture and stats
-            m_playerTexture = context.renderer->loadTexture(m_texturePath);
+            m_playerTexture = context.renderer->acquireTexture(m_texturePath);
             if (!m_playerTexture) {
                 Log::Error("Failed to load default player texture: " + m_texturePath);
             }
@@ -45,7 +51,7 @@ void Player::initialize(const EntityContext& context) {
         }
     } else if (context.renderer) {
         // Fallback to default if no character selected or modManager is null
-        m_playerTexture = context.renderer->loadTexture(m_texturePath);
+        m_playerTexture = context.renderer->acquireTexture(m_texturePath);
         if (!m_playerTexture) {
             Log::Error("Failed to load default player texture: " + m_texturePath);
         }
@@ -129,7 +135,10 @@ void Player::render(Renderer& renderer) {
 }
 
 void Player::onDestroy(const EntityContext& context) {
-    (void)context; // Suppress unused parameter warning
+    if (context.renderer) {
+        context.renderer->releaseTexture(m_playerTexture);
+    }
+    m_playerTexture = {};
 }
 
 void Player::handleInput(const EntityContext& context) {
@@ -167,9 +176,14 @@ void Player::handleInput(const EntityContext& context) {
     // Mouse aiming
     float mouseX, mouseY;
     context.inputManager->getMousePosition(mouseX, mouseY);
+    // The cursor is in screen pixels; aim at the world point under it
+    Vec2 cursor = {mouseX, mouseY};
+    if (context.camera) {
+        cursor = context.camera->screenToWorld(cursor);
+    }
     // Calculate direction from player to mouse
-    float dx = mouseX - m_position.x;
-    float dy = mouseY - m_position.y;
+    float dx = cursor.x - m_position.x;
+    float dy = cursor.y - m_position.y;
     m_rotation = std::atan2(dy, dx) * (180.0f / M_PI); // Convert radians to degrees
 
     // Shooting input
@@ -231,12 +245,19 @@ void Player::applyMovement(const EntityContext& context) {
 
     // Basic map boundary collision (AABB vs AABB for map bounds)
     if (context.mapManager) {
+        Profiler::Scope collisionScope(context.profiler, ProfileStage::Collision);
         float mapWidth = static_cast<float>(context.mapManager->getMapWidthPixels());
         float mapHeight = static_cast<float>(context.mapManager->getMapHeightPixels());
 
         // Clamp player position within map boundaries
         nextPos.x = std::max(m_size.x / 2.0f, std::min(nextPos.x, mapWidth - m_size.x / 2.0f));
         nextPos.y = std::max(m_size.y / 2.0f, std::min(nextPos.y, mapHeight - m_size.y / 2.0f));
+
+        // Circle vs. map geometry: push out along the distance field normal, which slides along walls
+        const DistanceField& distanceField = context.mapManager->getDistanceField();
+        if (distanceField.isBuilt()) {
+            distanceField.resolveCircle(nextPos, std::min(m_size.x, m_size.y) / 2.0f);
+        }
     }
 
     m_position = nextPos;
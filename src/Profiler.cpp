@@ -0,0 +1,58 @@
+// src/Profiler.cpp
+#include "TuxArena/Profiler.h"
+
+#include <algorithm> // For std::max
+#include <SDL2/SDL.h>
+
+namespace TuxArena {
+
+Profiler::Scope::Scope(Profiler* profiler, ProfileStage stage)
+    : m_profiler(profiler), m_stage(stage) {
+    if (m_profiler) m_start = SDL_GetPerformanceCounter();
+}
+
+Profiler::Scope::~Scope() {
+    if (!m_profiler) return;
+    uint64_t elapsed = SDL_GetPerformanceCounter() - m_start;
+    m_profiler->add(m_stage, static_cast<double>(elapsed) * 1000.0 / static_cast<double>(SDL_GetPerformanceFrequency()));
+}
+
+void Profiler::endFrame(double frameMs) {
+    m_frameTimes[m_nextSample] = static_cast<float>(frameMs);
+    for (size_t stage = 0; stage < STAGE_COUNT; ++stage) {
+        m_stageTimes[stage][m_nextSample] = static_cast<float>(m_current[stage]);
+        m_current[stage] = 0.0;
+    }
+    m_nextSample = (m_nextSample + 1) % HISTORY;
+    m_sampleCount = std::min(m_sampleCount + 1, HISTORY);
+}
+
+const char* Profiler::getStageName(ProfileStage stage) {
+    switch (stage) {
+        case ProfileStage::Input:          return "Input";
+        case ProfileStage::NetworkReceive: return "Network receive";
+        case ProfileStage::Simulation:     return "Simulation";
+        case ProfileStage::Collision:      return "  Collision";
+        case ProfileStage::Particles:      return "  Particles";
+        case ProfileStage::Render:         return "Render (record)";
+        case ProfileStage::Present:        return "Present (replay)";
+        default:                           return "Unknown";
+    }
+}
+
+float Profiler::getStageMean(ProfileStage stage) const {
+    if (m_sampleCount == 0) return 0.0f;
+    const std::array<float, HISTORY>& samples = getStageTimes(stage);
+    float sum = 0.0f;
+    for (size_t i = 0; i < m_sampleCount; ++i) sum += samples[i];
+    return sum / static_cast<float>(m_sampleCount);
+}
+
+float Profiler::getStageMax(ProfileStage stage) const {
+    const std::array<float, HISTORY>& samples = getStageTimes(stage);
+    float maxMs = 0.0f;
+    for (size_t i = 0; i < m_sampleCount; ++i) maxMs = std::max(maxMs, samples[i]);
+    return maxMs;
+}
+
+} // namespace TuxArena
@@ -5,6 +5,7 @@
 #include "TuxArena/EntityManager.h" // For entity collision checks
 #include "TuxArena/MapManager.h"    // For map collision checks
 #include "TuxArena/Renderer.h" // For rendering
+#include "TuxArena/Profiler.h"
 
 #include <cmath> // For std::sin, std::cos
 
@@ -40,15 +41,26 @@ void ProjectileBullet::update(const EntityContext& context) {
     // Move the bullet
     Vec2 nextPos = m_position + m_velocity * context.deltaTime;
 
+    bool hitMap = false;
+    bool hitEntity = false;
+    {
+        Profiler::Scope collisionScope(context.profiler, ProfileStage::Collision);
+        hitMap = context.mapManager && checkMapCollision(nextPos, context);
+        hitEntity = !hitMap && context.entityManager && checkEntityCollision(context);
+    }
+
     // Check for map collision
-    if (context.mapManager && checkMapCollision(nextPos, context)) {
+    if (hitMap) {
         Log::Info("Bullet hit map at (" + std::to_string(nextPos.x) + ", " + std::to_string(nextPos.y) + ")");
         m_isActive = false; // Bullet is destroyed on map collision
+        if (m_particleManager) {
+            m_particleManager->addDecal(m_position.x, m_position.y, 2.5f, {40, 36, 32, 220}); // Scorch mark at the wall
+        }
         return;
     }
 
     // Check for entity collision (excluding owner)
-    if (context.entityManager && checkEntityCollision(context)) {
+    if (hitEntity) {
         Log::Info("Bullet hit entity.");
         m_isActive = false; // Bullet is destroyed on entity collision
         return;
@@ -98,8 +110,26 @@ bool ProjectileBullet::checkMapCollision(const Vec2& nextPos, const EntityContex
         return true; // Collision with map boundary
     }
 
-    // TODO: Implement actual collision with map tiles/objects if needed
-    // This would involve checking the collision shapes from MapManager
+    // Swept test against solid tiles, so fast bullets cannot tunnel through thin walls
+    const Raycaster& raycaster = context.mapManager->getRaycaster();
+    if (raycaster.isBuilt()) {
+        Vec2 step = nextPos - m_position;
+        float stepLength = std::sqrt(step.x * step.x + step.y * step.y);
+        RayHit hit = raycaster.castRay(m_position, step, stepLength);
+        if (hit.hit) {
+            // Destructible walls break on impact; the server replicates the edit to clients
+            if (context.isServer) {
+                context.mapManager->breakTile(hit.tileX, hit.tileY);
+            }
+            return true;
+        }
+    }
+
+    // Sub-tile collision objects via the distance field
+    const DistanceField& distanceField = context.mapManager->getDistanceField();
+    if (distanceField.isBuilt() && distanceField.sampleDistance(nextPos.x, nextPos.y) <= 0.0f) {
+        return true;
+    }
     return false;
 }
 
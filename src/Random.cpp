@@ -0,0 +1,131 @@
+// src/Random.cpp
+#include "TuxArena/Random.h"
+
+#include <algorithm> // For std::min
+#include <atomic>
+#include <limits>
+
+namespace TuxArena {
+
+namespace {
+constexpr uint64_t DEFAULT_SEED = 0x853c49e6748fea9bull;
+constexpr size_t STREAM_COUNT = static_cast<size_t>(RandomStream::Count);
+constexpr uint32_t NO_SLOT = std::numeric_limits<uint32_t>::max();
+
+uint64_t splitMix64(uint64_t& state) {
+    uint64_t z = (state += 0x9e3779b97f4a7c15ull);
+    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ull;
+    z = (z ^ (z >> 27)) * 0x94d049bb133111ebull;
+    return z ^ (z >> 31);
+}
+
+std::atomic<uint64_t> g_seed{DEFAULT_SEED};
+std::atomic<uint32_t> g_generation{0};     // Bumped by setRandomSeed() so threads reseed lazily
+std::atomic<uint32_t> g_nextThreadSlot{1}; // Slot 0 belongs to the first thread that set the seed
+std::atomic<bool> g_seedSlotClaimed{false};
+
+struct ThreadRandom {
+    uint32_t slot = NO_SLOT;
+    uint32_t generation = NO_SLOT; // Never a live generation, so the first use seeds
+    Random streams[STREAM_COUNT];
+};
+
+thread_local ThreadRandom t_random;
+} // anonymous namespace
+
+void Random::reseed(uint64_t seed, uint64_t stream) {
+    // Reference PCG32 initialization
+    m_state = 0;
+    m_increment = (stream << 1u) | 1u;
+    next();
+    m_state += seed;
+    next();
+
+    // The bulk lanes come from SplitMix64, so they are unrelated to the PCG32 sequence and to each other
+    uint64_t mix = seed ^ (stream * 0xd1342543de82ef95ull);
+    for (size_t lane = 0; lane < LANES; ++lane) {
+        for (size_t word = 0; word < 4; word += 2) {
+            uint64_t value = splitMix64(mix);
+            m_lanes[word][lane] = static_cast<uint32_t>(value);
+            m_lanes[word + 1][lane] = static_cast<uint32_t>(value >> 32);
+        }
+        if ((m_lanes[0][lane] | m_lanes[1][lane] | m_lanes[2][lane] | m_lanes[3][lane]) == 0) {
+            m_lanes[0][lane] = 1; // All-zero state would only ever return zero
+        }
+    }
+}
+
+uint32_t Random::nextBelow(uint32_t bound) {
+    if (bound == 0) return 0;
+    // Lemire's multiply-and-reject: one multiply, and a division only in the rare rejection case
+    uint64_t product = static_cast<uint64_t>(next()) * bound;
+    uint32_t low = static_cast<uint32_t>(product);
+    if (low < bound) {
+        uint32_t threshold = (0u - bound) % bound;
+        while (low < threshold) {
+            product = static_cast<uint64_t>(next()) * bound;
+            low = static_cast<uint32_t>(product);
+        }
+    }
+    return static_cast<uint32_t>(product >> 32);
+}
+
+void Random::fillFloats(float* out, size_t count, float min, float max) {
+    const float scale = (max - min) * (1.0f / 16777216.0f);
+    uint32_t block[LANES];
+    for (size_t i = 0; i < count;) {
+        // One xoshiro128+ step in every lane; 32-bit adds, shifts and xors only, so the loop
+        // vectorizes to two SSE2 (or one AVX2) operations per word
+        for (size_t lane = 0; lane < LANES; ++lane) {
+            uint32_t s0 = m_lanes[0][lane], s1 = m_lanes[1][lane], s2 = m_lanes[2][lane], s3 = m_lanes[3][lane];
+            block[lane] = s0 + s3;
+            uint32_t t = s1 << 9;
+            s2 ^= s0;
+            s3 ^= s1;
+            s1 ^= s2;
+            s0 ^= s3;
+            s2 ^= t;
+            s3 = (s3 << 11) | (s3 >> 21);
+            m_lanes[0][lane] = s0;
+            m_lanes[1][lane] = s1;
+            m_lanes[2][lane] = s2;
+            m_lanes[3][lane] = s3;
+        }
+        // The top 24 bits; the low bits of xoshiro128+ are its weak ones
+        size_t n = std::min(LANES, count - i);
+        for (size_t lane = 0; lane < n; ++lane) {
+            out[i + lane] = min + static_cast<float>(block[lane] >> 8) * scale;
+        }
+        i += n;
+    }
+}
+
+void setRandomSeed(uint64_t seed) {
+    g_seed.store(seed, std::memory_order_relaxed);
+    // Only one thread may own slot 0; any other caller keeps streams of its own
+    bool claimed = false;
+    if (t_random.slot != 0 && g_seedSlotClaimed.compare_exchange_strong(claimed, true, std::memory_order_relaxed)) {
+        t_random.slot = 0;
+    }
+    g_generation.fetch_add(1, std::memory_order_release);
+}
+
+uint64_t getRandomSeed() {
+    return g_seed.load(std::memory_order_relaxed);
+}
+
+Random& getRandom(RandomStream stream) {
+    ThreadRandom& local = t_random;
+    uint32_t generation = g_generation.load(std::memory_order_acquire);
+    if (local.generation != generation) {
+        if (local.slot == NO_SLOT) local.slot = g_nextThreadSlot.fetch_add(1, std::memory_order_relaxed);
+        uint64_t seed = g_seed.load(std::memory_order_relaxed);
+        for (size_t i = 0; i < STREAM_COUNT; ++i) {
+            local.streams[i].reseed(seed, (static_cast<uint64_t>(local.slot) << 8) | i);
+        }
+        local.generation = generation;
+    }
+    return local.streams[static_cast<size_t>(stream)];
+}
+
+} // namespace TuxArena
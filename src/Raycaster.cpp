@@ -0,0 +1,226 @@
+// src/Raycaster.cpp
+#include "TuxArena/Raycaster.h"
+#include "TuxArena/CollisionGrid.h"
+
+#include <algorithm> // For std::min, std::max
+#include <cmath>     // For std::floor, std::sqrt, std::cos, std::sin
+#include <limits>    // For std::numeric_limits
+
+namespace TuxArena {
+
+namespace {
+constexpr float RAY_INF = std::numeric_limits<float>::infinity();
+} // anonymous namespace
+
+void Raycaster::build(const CollisionGrid& grid) {
+    clear();
+    if (grid.isEmpty() || grid.getTileWidth() == 0 || grid.getTileHeight() == 0) return;
+
+    m_grid = &grid;
+    m_superWidth = (grid.getWidth() + SUPER_TILE_SIZE - 1) >> SUPER_TILE_SHIFT;
+    m_superHeight = (grid.getHeight() + SUPER_TILE_SIZE - 1) >> SUPER_TILE_SHIFT;
+    m_superCounts.assign(static_cast<size_t>(m_superWidth) * m_superHeight, 0);
+
+    for (int ty = 0; ty < grid.getHeight(); ++ty) {
+        for (int tx = 0; tx < grid.getWidth(); ++tx) {
+            if (grid.isSolid(tx, ty)) {
+                ++m_superCounts[static_cast<size_t>(ty >> SUPER_TILE_SHIFT) * m_superWidth + (tx >> SUPER_TILE_SHIFT)];
+            }
+        }
+    }
+}
+
+void Raycaster::clear() {
+    m_grid = nullptr;
+    m_superWidth = 0;
+    m_superHeight = 0;
+    m_superCounts.clear();
+}
+
+void Raycaster::updateTile(int tileX, int tileY) {
+    if (!m_grid || tileX < 0 || tileY < 0 || tileX >= m_grid->getWidth() || tileY >= m_grid->getHeight()) return;
+
+    int superX = tileX >> SUPER_TILE_SHIFT;
+    int superY = tileY >> SUPER_TILE_SHIFT;
+    int x0 = superX << SUPER_TILE_SHIFT;
+    int y0 = superY << SUPER_TILE_SHIFT;
+    int x1 = std::min(x0 + SUPER_TILE_SIZE, m_grid->getWidth());
+    int y1 = std::min(y0 + SUPER_TILE_SIZE, m_grid->getHeight());
+
+    uint8_t count = 0;
+    for (int ty = y0; ty < y1; ++ty) {
+        for (int tx = x0; tx < x1; ++tx) {
+            if (m_grid->isSolid(tx, ty)) ++count;
+        }
+    }
+    m_superCounts[static_cast<size_t>(superY) * m_superWidth + superX] = count;
+}
+
+Raycaster::Origin Raycaster::makeOrigin(const Vec2& origin) const {
+    Origin result;
+    result.pixels = origin;
+    result.tileX = origin.x / static_cast<float>(m_grid->getTileWidth());
+    result.tileY = origin.y / static_cast<float>(m_grid->getTileHeight());
+    return result;
+}
+
+RayHit Raycaster::castRay(const Vec2& origin, const Vec2& direction, float maxDistance) const {
+    RayHit result;
+    result.distance = maxDistance;
+    float length = std::sqrt(direction.x * direction.x + direction.y * direction.y);
+    if (!m_grid || length <= 0.0f) return result;
+    return traverse(makeOrigin(origin), direction.x / length, direction.y / length, maxDistance);
+}
+
+bool Raycaster::hasLineOfSight(const Vec2& from, const Vec2& to) const {
+    Vec2 delta = to - from;
+    float distance = std::sqrt(delta.x * delta.x + delta.y * delta.y);
+    if (!m_grid) return true;
+    if (distance <= 0.0f) return !m_grid->isSolidAt(from.x, from.y);
+    return !traverse(makeOrigin(from), delta.x / distance, delta.y / distance, distance).hit;
+}
+
+void Raycaster::castRays(const Vec2& origin, const Vec2* directions, int count, float maxDistance, RayHit* outHits) const {
+    if (!m_grid) {
+        for (int i = 0; i < count; ++i) {
+            outHits[i] = RayHit();
+            outHits[i].distance = maxDistance;
+        }
+        return;
+    }
+
+    Origin start = makeOrigin(origin);
+    for (int i = 0; i < count; ++i) {
+        float length = std::sqrt(directions[i].x * directions[i].x + directions[i].y * directions[i].y);
+        if (length <= 0.0f) {
+            outHits[i] = RayHit();
+            outHits[i].distance = maxDistance;
+            continue;
+        }
+        outHits[i] = traverse(start, directions[i].x / length, directions[i].y / length, maxDistance);
+    }
+}
+
+void Raycaster::castRayFan(const Vec2& origin, float centerAngleDegrees, float spreadDegrees, int count, float maxDistance, RayHit* outHits) const {
+    if (count <= 0) return;
+
+    // Spread the rays evenly across the cone, a single ray goes straight down the center
+    float step = count > 1 ? spreadDegrees / static_cast<float>(count - 1) : 0.0f;
+    float firstAngle = count > 1 ? centerAngleDegrees - spreadDegrees * 0.5f : centerAngleDegrees;
+
+    Origin start = makeOrigin(origin);
+    for (int i = 0; i < count; ++i) {
+        float angle = (firstAngle + step * static_cast<float>(i)) * static_cast<float>(M_PI / 180.0);
+        if (m_grid) {
+            outHits[i] = traverse(start, std::cos(angle), std::sin(angle), maxDistance);
+        } else {
+            outHits[i] = RayHit();
+            outHits[i].distance = maxDistance;
+        }
+    }
+}
+
+RayHit Raycaster::traverse(const Origin& origin, float dirX, float dirY, float maxDistance) const {
+    RayHit result;
+    result.distance = maxDistance;
+
+    const float tileWidth = static_cast<float>(m_grid->getTileWidth());
+    const float tileHeight = static_cast<float>(m_grid->getTileHeight());
+    const int gridWidth = m_grid->getWidth();
+    const int gridHeight = m_grid->getHeight();
+    const uint8_t* tiles = m_grid->data();
+
+    // Ray direction in tiles per pixel travelled, so 't' is always the distance in pixels
+    const float tdx = dirX / tileWidth;
+    const float tdy = dirY / tileHeight;
+    const int stepX = tdx > 0.0f ? 1 : -1;
+    const int stepY = tdy > 0.0f ? 1 : -1;
+    const float invX = tdx != 0.0f ? 1.0f / tdx : RAY_INF;
+    const float invY = tdy != 0.0f ? 1.0f / tdy : RAY_INF;
+    const float tDeltaX = std::fabs(invX);
+    const float tDeltaY = std::fabs(invY);
+
+    int tileX = static_cast<int>(std::floor(origin.tileX));
+    int tileY = static_cast<int>(std::floor(origin.tileY));
+
+    // Absolute ray distance at which the next vertical / horizontal tile boundary is crossed
+    auto nextBoundaryX = [&](int x) {
+        if (tdx == 0.0f) return RAY_INF;
+        return (static_cast<float>(tdx > 0.0f ? x + 1 : x) - origin.tileX) * invX;
+    };
+    auto nextBoundaryY = [&](int y) {
+        if (tdy == 0.0f) return RAY_INF;
+        return (static_cast<float>(tdy > 0.0f ? y + 1 : y) - origin.tileY) * invY;
+    };
+    float tMaxX = nextBoundaryX(tileX);
+    float tMaxY = nextBoundaryY(tileY);
+
+    float t = 0.0f;
+    int lastAxis = -1; // -1 = started here, 0 = crossed an x boundary, 1 = crossed a y boundary
+
+    while (t <= maxDistance) {
+        bool outside = tileX < 0 || tileY < 0 || tileX >= gridWidth || tileY >= gridHeight;
+
+        if (!outside && m_superCounts[static_cast<size_t>(tileY >> SUPER_TILE_SHIFT) * m_superWidth + (tileX >> SUPER_TILE_SHIFT)] == 0) {
+            // Empty super-tile: jump straight to where the ray leaves it
+            int superX0 = (tileX >> SUPER_TILE_SHIFT) << SUPER_TILE_SHIFT;
+            int superY0 = (tileY >> SUPER_TILE_SHIFT) << SUPER_TILE_SHIFT;
+            // Super-tiles on the right/bottom edge may be partial; never skip past the map edge
+            int superX1 = std::min(superX0 + SUPER_TILE_SIZE, gridWidth);
+            int superY1 = std::min(superY0 + SUPER_TILE_SIZE, gridHeight);
+            float exitX = tdx == 0.0f ? RAY_INF
+                : (static_cast<float>(tdx > 0.0f ? superX1 : superX0) - origin.tileX) * invX;
+            float exitY = tdy == 0.0f ? RAY_INF
+                : (static_cast<float>(tdy > 0.0f ? superY1 : superY0) - origin.tileY) * invY;
+
+            if (exitX < exitY) {
+                t = exitX;
+                tileX = tdx > 0.0f ? superX1 : superX0 - 1;
+                tileY = std::max(superY0, std::min(superY1 - 1, static_cast<int>(std::floor(origin.tileY + tdy * t))));
+                lastAxis = 0;
+            } else {
+                t = exitY;
+                tileY = tdy > 0.0f ? superY1 : superY0 - 1;
+                tileX = std::max(superX0, std::min(superX1 - 1, static_cast<int>(std::floor(origin.tileX + tdx * t))));
+                lastAxis = 1;
+            }
+            tMaxX = nextBoundaryX(tileX);
+            tMaxY = nextBoundaryY(tileY);
+            continue;
+        }
+
+        if (outside || tiles[static_cast<size_t>(tileY) * gridWidth + tileX] != 0) {
+            result.hit = true;
+            result.distance = t;
+            result.point = {origin.pixels.x + dirX * t, origin.pixels.y + dirY * t};
+            result.tileX = tileX;
+            result.tileY = tileY;
+            if (lastAxis == 0) {
+                result.normal = {static_cast<float>(-stepX), 0.0f};
+            } else if (lastAxis == 1) {
+                result.normal = {0.0f, static_cast<float>(-stepY)};
+            } else {
+                result.normal = {-dirX, -dirY}; // Started inside geometry
+            }
+            return result;
+        }
+
+        // Regular DDA step into the neighbouring tile
+        if (tMaxX < tMaxY) {
+            t = tMaxX;
+            tMaxX += tDeltaX;
+            tileX += stepX;
+            lastAxis = 0;
+        } else {
+            t = tMaxY;
+            tMaxY += tDeltaY;
+            tileY += stepY;
+            lastAxis = 1;
+        }
+    }
+
+    result.point = {origin.pixels.x + dirX * maxDistance, origin.pixels.y + dirY * maxDistance};
+    return result;
+}
+
+} // namespace TuxArena
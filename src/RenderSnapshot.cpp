@@ -0,0 +1,12 @@
+// src/RenderSnapshot.cpp
+#include "TuxArena/RenderSnapshot.h"
+
+#include "imgui.h"
+
+namespace TuxArena {
+
+OverlayDrawData::~OverlayDrawData() {
+    for (ImDrawList* list : lists) IM_DELETE(list);
+}
+
+} // namespace TuxArena
@@ -0,0 +1,55 @@
+// src/RenderSort.cpp
+#include "TuxArena/RenderSort.h"
+
+#include <algorithm> // For std::clamp
+#include <cmath>     // For std::lround
+
+namespace TuxArena {
+
+uint32_t renderSortDepthFromY(float y) {
+    const long maxDepth = (1L << RENDER_SORT_DEPTH_BITS) - 1;
+    long depth = std::lround(y * 4.0f) + (1L << (RENDER_SORT_DEPTH_BITS - 1));
+    return static_cast<uint32_t>(std::clamp(depth, 0L, maxDepth));
+}
+
+void radixSortByKey(std::vector<uint64_t>& keys, std::vector<uint32_t>& order,
+                    std::vector<uint64_t>& keyScratch, std::vector<uint32_t>& orderScratch) {
+    const size_t count = keys.size();
+    order.resize(count);
+    for (size_t i = 0; i < count; ++i) {
+        order[i] = static_cast<uint32_t>(i);
+    }
+    if (count < 2) return;
+
+    // All eight digit histograms in one pass over the keys
+    size_t histograms[8][256] = {};
+    for (uint64_t key : keys) {
+        for (int digit = 0; digit < 8; ++digit) {
+            ++histograms[digit][(key >> (digit * 8)) & 0xFF];
+        }
+    }
+
+    keyScratch.resize(count);
+    orderScratch.resize(count);
+    for (int digit = 0; digit < 8; ++digit) {
+        size_t* histogram = histograms[digit];
+        int shift = digit * 8;
+        if (histogram[(keys[0] >> shift) & 0xFF] == count) continue; // Same digit everywhere
+
+        size_t offset = 0;
+        for (int bucket = 0; bucket < 256; ++bucket) {
+            size_t bucketCount = histogram[bucket];
+            histogram[bucket] = offset;
+            offset += bucketCount;
+        }
+        for (size_t i = 0; i < count; ++i) {
+            size_t position = histogram[(keys[i] >> shift) & 0xFF]++;
+            keyScratch[position] = keys[i];
+            orderScratch[position] = order[i];
+        }
+        keys.swap(keyScratch);
+        order.swap(orderScratch);
+    }
+}
+
+} // namespace TuxArena
@@ -0,0 +1,116 @@
+// src/RenderThread.cpp
+#include "TuxArena/RenderThread.h"
+#include "TuxArena/Renderer.h"
+#include "TuxArena/Log.h"
+
+#include <string>
+#include <system_error>
+
+namespace TuxArena {
+
+RenderThread::RenderThread(Renderer& renderer) : m_renderer(renderer) {}
+
+RenderThread::~RenderThread() {
+    stop();
+}
+
+bool RenderThread::start() {
+    if (isRunning()) return true;
+    m_stopRequested = false;
+    m_pendingIndex = -1;
+    m_drawingIndex = -1;
+
+    // A GL context can only be current on one thread at a time
+    m_renderer.unbindFromCurrentThread();
+    try {
+        m_thread = std::thread(&RenderThread::threadMain, this);
+    } catch (const std::system_error& e) {
+        Log::Error("Failed to start render thread: " + std::string(e.what()));
+        m_renderer.bindToCurrentThread();
+        return false;
+    }
+    Log::Info("Render thread started.");
+    return true;
+}
+
+void RenderThread::stop() {
+    if (!isRunning()) return;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stopRequested = true;
+    }
+    m_condition.notify_all();
+    m_thread.join();
+    m_renderer.bindToCurrentThread();
+    Log::Info("Render thread stopped.");
+}
+
+RenderSnapshot& RenderThread::acquireBackBuffer() {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_condition.wait(lock, [this] { return m_drawingIndex != m_backIndex && m_pendingIndex != m_backIndex; });
+    return m_snapshots[m_backIndex];
+}
+
+void RenderThread::submit() {
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_condition.wait(lock, [this] { return m_pendingIndex < 0; });
+        m_pendingIndex = m_backIndex;
+        m_backIndex ^= 1;
+    }
+    m_condition.notify_all();
+}
+
+void RenderThread::synchronize() {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_condition.wait(lock, [this] { return m_pendingIndex < 0 && m_drawingIndex < 0; });
+}
+
+Renderer::ReplayStats RenderThread::getReplayStats() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_replayStats;
+}
+
+void RenderThread::setReplayHistoryEnabled(bool enabled) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_keepReplayHistory = enabled;
+    if (!enabled) m_replayHistory.clear();
+}
+
+std::vector<Renderer::ReplayStats> RenderThread::takeReplayHistory() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    std::vector<Renderer::ReplayStats> history;
+    history.swap(m_replayHistory);
+    return history;
+}
+
+void RenderThread::threadMain() {
+    m_renderer.bindToCurrentThread();
+
+    while (true) {
+        int index;
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_condition.wait(lock, [this] { return m_pendingIndex >= 0 || m_stopRequested; });
+            if (m_pendingIndex < 0) break; // Stop requested and nothing left to draw
+            index = m_pendingIndex;
+            m_pendingIndex = -1;
+            m_drawingIndex = index;
+        }
+        m_condition.notify_all();
+
+        m_renderer.replay(m_snapshots[index]);
+
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_drawingIndex = -1;
+            m_replayStats = m_renderer.getReplayStats();
+            if (m_keepReplayHistory) m_replayHistory.push_back(m_replayStats);
+        }
+        m_condition.notify_all();
+    }
+
+    m_renderer.unbindFromCurrentThread();
+}
+
+} // namespace TuxArena
@@ -1,5 +1,7 @@
 // src/Renderer.cpp
+#include "TuxArena/AssetManager.h"
 #include "TuxArena/Renderer.h"
+#include "TuxArena/RenderSnapshot.h"
 #include "TuxArena/Log.h"
 #include "TuxArena/UI.h"
 #include "../include/TuxArena/MapManager.h" // Include for renderMap - adjust if map rendering logic changes
@@ -16,9 +18,43 @@
 
 #include <iostream> // For error logging
 #include <utility> // For std::pair used in font cache key
+#include <algorithm> // For std::min, std::max
+#include <cmath> // For std::floor, std::ceil
+#include <vector>
+#include <cstring> // For memcpy
+#include <unordered_set>
 
 namespace TuxArena {
 
+namespace {
+// Snapshot being recorded on this thread. Thread-local so that replay() on the render thread,
+// which calls the same drawing functions, draws while the simulation thread records the next frame.
+thread_local RenderSnapshot* t_recordingSnapshot = nullptr;
+
+template <typename T>
+void copyImVector(ImVector<T>& destination, const ImVector<T>& source) {
+    destination.resize(source.Size); // Keeps the capacity; operator= would reallocate every frame
+    if (source.Size > 0) memcpy(destination.Data, source.Data, source.size_in_bytes());
+}
+
+// Map and decal chunks hold premultiplied color. Tiles and decals are baked with their alpha applied to
+// the color once (the target's alpha accumulating as with BLEND), and the chunks are drawn without
+// applying it again.
+SDL_BlendMode getChunkBakeBlendMode() {
+    static const SDL_BlendMode mode = SDL_ComposeCustomBlendMode(
+        SDL_BLENDFACTOR_SRC_ALPHA, SDL_BLENDFACTOR_ONE_MINUS_SRC_ALPHA, SDL_BLENDOPERATION_ADD,
+        SDL_BLENDFACTOR_ONE, SDL_BLENDFACTOR_ONE_MINUS_SRC_ALPHA, SDL_BLENDOPERATION_ADD);
+    return mode;
+}
+
+SDL_BlendMode getPremultipliedBlendMode() {
+    static const SDL_BlendMode mode = SDL_ComposeCustomBlendMode(
+        SDL_BLENDFACTOR_ONE, SDL_BLENDFACTOR_ONE_MINUS_SRC_ALPHA, SDL_BLENDOPERATION_ADD,
+        SDL_BLENDFACTOR_ONE, SDL_BLENDFACTOR_ONE_MINUS_SRC_ALPHA, SDL_BLENDOPERATION_ADD);
+    return mode;
+}
+}
+
 Renderer::Renderer(AssetManager* assetManager) : m_assetManager(assetManager) {
     // Log::Info("Renderer created.");
 }
@@ -48,23 +84,7 @@ bool Renderer::initialize(const std::string& windowTitle, int windowWidth, int w
     // }
 
 
-    // --- Initialize SDL_image ---
-    int imgFlags = IMG_INIT_PNG; // Initialize PNG loading
-    if (!(IMG_Init(imgFlags) & imgFlags)) {
-        Log::Error("SDL_image could not initialize! IMG_Error: " + std::string(IMG_GetError()));
-        // No need to SDL_QuitSubSystem video here, as it might be used elsewhere
-        return false;
-    }
-    Log::Info("SDL_image initialized successfully.");
-
-
-    // --- Initialize SDL_ttf ---
-    if (TTF_Init() == -1) {
-        Log::Error("SDL_ttf could not initialize! TTF_Error: " + std::string(TTF_GetError()));
-        IMG_Quit(); // Clean up SDL_image
-        return false;
-    }
-     Log::Info("SDL_ttf initialized successfully.");
+    if (!initializeLibraries()) return false;
 
 
     // --- Create Window ---
@@ -106,15 +126,26 @@ bool Renderer::initialize(const std::string& windowTitle, int windowWidth, int w
         return false;
     }
     Log::Info("SDL Renderer created successfully.");
+    m_windowWidth = windowWidth;
+    m_windowHeight = windowHeight;
+    m_glContext = SDL_GL_GetCurrentContext();
+    m_renderThreadId = std::this_thread::get_id();
+    m_spriteBatch.setRenderer(m_sdlRenderer);
+    m_textureAtlas.setRenderer(m_sdlRenderer);
 
     // Set default draw color for clearing
     SDL_SetRenderDrawColor(m_sdlRenderer, m_clearColor.r, m_clearColor.g, m_clearColor.b, m_clearColor.a);
 
     // Initialize ImGui
     IMGUI_CHECKVERSION();
-    ImGui::CreateContext();
+    m_imguiContext = ImGui::CreateContext();
     ImGui_ImplSDL2_InitForOpenGL(m_sdlWindow, SDL_GL_GetCurrentContext());
     ImGui_ImplOpenGL3_Init("#version 130");
+    // Font texture and shaders now, while the GL context is current here: ImGui frames are built on
+    // the main thread and drawn on the render thread, so the lazy creation in NewFrame() would make
+    // GL calls on the wrong thread. UIManager shares this context (getImGuiContext()).
+    ImGui_ImplOpenGL3_CreateDeviceObjects();
+    m_imguiInitialized = true;
 
     // Set the theme
     TuxArena::UI::SetGothicTheme();
@@ -124,6 +155,56 @@ bool Renderer::initialize(const std::string& windowTitle, int windowWidth, int w
     return true;
 }
 
+bool Renderer::initializeHeadless(int width, int height) {
+    if (m_isInitialized) {
+        Log::Warning("Renderer::initializeHeadless called on an initialized renderer.");
+        return true;
+    }
+    if (!initializeLibraries()) return false;
+
+    m_headlessSurface = SDL_CreateRGBSurfaceWithFormat(0, width, height, 32, SDL_PIXELFORMAT_RGBA32);
+    m_sdlRenderer = m_headlessSurface ? SDL_CreateSoftwareRenderer(m_headlessSurface) : nullptr;
+    if (!m_sdlRenderer) {
+        Log::Error("Headless software renderer could not be created! SDL_Error: " + std::string(SDL_GetError()));
+        if (m_headlessSurface) SDL_FreeSurface(m_headlessSurface);
+        m_headlessSurface = nullptr;
+        TTF_Quit();
+        IMG_Quit();
+        return false;
+    }
+    m_windowWidth = width;
+    m_windowHeight = height;
+    m_renderThreadId = std::this_thread::get_id();
+    m_spriteBatch.setRenderer(m_sdlRenderer);
+    m_textureAtlas.setRenderer(m_sdlRenderer);
+    SDL_SetRenderDrawColor(m_sdlRenderer, m_clearColor.r, m_clearColor.g, m_clearColor.b, m_clearColor.a);
+
+    m_isInitialized = true;
+    Log::Info("Headless renderer initialized (" + std::to_string(width) + "x" + std::to_string(height) + ", software).");
+    return true;
+}
+
+bool Renderer::initializeLibraries() {
+    // --- Initialize SDL_image ---
+    int imgFlags = IMG_INIT_PNG; // Initialize PNG loading
+    if (!(IMG_Init(imgFlags) & imgFlags)) {
+        Log::Error("SDL_image could not initialize! IMG_Error: " + std::string(IMG_GetError()));
+        // No need to SDL_QuitSubSystem video here, as it might be used elsewhere
+        return false;
+    }
+    Log::Info("SDL_image initialized successfully.");
+
+
+    // --- Initialize SDL_ttf ---
+    if (TTF_Init() == -1) {
+        Log::Error("SDL_ttf could not initialize! TTF_Error: " + std::string(TTF_GetError()));
+        IMG_Quit(); // Clean up SDL_image
+        return false;
+    }
+     Log::Info("SDL_ttf initialized successfully.");
+    return true;
+}
+
 void Renderer::shutdown() {
     if (!m_isInitialized) {
         return; // Nothing to shut down
@@ -131,19 +212,49 @@ void Renderer::shutdown() {
     Log::Info("Shutting down Renderer...");
 
     // Shutdown ImGui
-    ImGui_ImplOpenGL3_Shutdown();
-    ImGui_ImplSDL2_Shutdown();
-    ImGui::DestroyContext();
+    if (m_imguiInitialized) {
+        ImGui_ImplOpenGL3_Shutdown();
+        ImGui_ImplSDL2_Shutdown();
+        ImGui::DestroyContext(m_imguiContext);
+        m_imguiContext = nullptr;
+        m_imguiInitialized = false;
+    }
 
     // 1. Clear Caches and Destroy Resources
+    processPendingTextureWork();
+    invalidateMapCache();
+    clearDecals();
+    if (m_fogTexture) SDL_DestroyTexture(m_fogTexture);
+    m_fogTexture = nullptr;
+    m_fogTextureRevision = 0;
+    m_tileGids.clear();
+    m_tileGidsMap = nullptr;
+    m_recordedMap = nullptr;
+    Log::Info("Texture disk cache: " + std::to_string(m_textureDiskCache.getHitCount()) + " hits, " +
+              std::to_string(m_textureDiskCache.getMissCount()) + " decoded.");
     Log::Info("Clearing texture cache (" + std::to_string(m_textureCache.size()) + " items)...");
-    for (auto const& [key, val] : m_textureCache) {
-        if (val) {
-            SDL_DestroyTexture(val);
+    for (auto const& [key, entry] : m_textureCache) {
+        if (entry.texture) {
+            SDL_DestroyTexture(entry.texture);
         }
     }
     m_textureCache.clear();
+    m_texturePaths.clear();
+    m_unusedTextures.clear();
+    m_textureCacheBytes = 0;
+    m_textureSlots.clear();
+    m_freeTextureSlots.clear();
+    m_textureSlotByPath.clear();
+    m_pendingTextureLoads.clear();
+    m_pendingTextureReleases.clear();
+    m_tilesetTextures.clear();
+    m_textureAtlas.clear();
+    if (m_softCircleTexture) {
+        SDL_DestroyTexture(m_softCircleTexture);
+        m_softCircleTexture = nullptr;
+    }
 
+     m_glyphCaches.clear(); // Glyph pages reference the fonts below
      Log::Info("Clearing font cache (" + std::to_string(m_fontCache.size()) + " items)...");
      for (auto const& [key, val] : m_fontCache) {
          if (val) {
@@ -164,6 +275,10 @@ void Renderer::shutdown() {
         SDL_DestroyWindow(m_sdlWindow);
         m_sdlWindow = nullptr;
     }
+    if (m_headlessSurface) {
+        SDL_FreeSurface(m_headlessSurface);
+        m_headlessSurface = nullptr;
+    }
 
     // 3. Quit SDL Subsystems Initialized Here
      Log::Info("Shutting down SDL_ttf...");
@@ -178,124 +293,769 @@ void Renderer::shutdown() {
 
 void Renderer::clear() {
     if (!m_sdlRenderer) return;
+    m_spriteBatch.flush();
+    m_spriteBatch.resetStats(); // Per-frame batch statistics
     // Set draw color just in case it was changed
     SDL_SetRenderDrawColor(m_sdlRenderer, m_clearColor.r, m_clearColor.g, m_clearColor.b, m_clearColor.a);
     SDL_RenderClear(m_sdlRenderer);
 }
 
 void Renderer::present() {
-    if (!m_sdlWindow) return; // Ensure window exists
-    SDL_GL_SwapWindow(m_sdlWindow);
+    if (!m_sdlRenderer) return;
+    m_spriteBatch.flush(); // Submit the rest of the frame
+    if (m_sdlWindow) {
+        SDL_GL_SwapWindow(m_sdlWindow);
+    } else {
+        SDL_RenderPresent(m_sdlRenderer); // Headless: completes the frame in m_headlessSurface
+    }
+}
+
+RenderSnapshot* Renderer::recordingSnapshot() const {
+    return t_recordingSnapshot;
 }
 
-SDL_Texture* Renderer::loadTexture(const std::string& relativePath) {
-    std::string fullPath = m_assetManager->resolvePath(relativePath);
-    if (fullPath.empty()) {
-        Log::Warning("Texture not found: " + relativePath);
-        return createPlaceholderTexture();
+void Renderer::beginRecording(RenderSnapshot& snapshot) {
+    snapshot.clear();
+    t_recordingSnapshot = &snapshot;
+}
+
+void Renderer::endRecording() {
+    t_recordingSnapshot = nullptr;
+}
+
+void Renderer::bindToCurrentThread() {
+    if (m_glContext && SDL_GL_MakeCurrent(m_sdlWindow, m_glContext) != 0) {
+        Log::Error("Failed to make the GL context current on the render thread: " + std::string(SDL_GetError()));
     }
+    m_renderThreadId = std::this_thread::get_id();
+}
 
-    SDL_Texture* texture = IMG_LoadTexture(m_renderer, fullPath.c_str());
-    if (!texture) {
-        Log::Warning("Failed to load texture: " + fullPath + ", error: " + IMG_GetError());
-        return createPlaceholderTexture();
+void Renderer::unbindFromCurrentThread() {
+    if (m_glContext) SDL_GL_MakeCurrent(m_sdlWindow, nullptr);
+}
+
+void Renderer::replay(RenderSnapshot& snapshot) {
+    if (!m_sdlRenderer) return;
+    Uint64 startCounter = SDL_GetPerformanceCounter();
+    processPendingTextureWork();
+    if (m_renderTargetsReset.exchange(false)) {
+        invalidateMapCache();
+        clearDecals();
     }
 
-    return texture;
+    // Tile state first, so chunks baked by this frame see its edits
+    if (snapshot.mapReset) {
+        invalidateMapCache();
+        clearDecals();
+        m_tileGids.swap(snapshot.mapTileGids);
+        m_tileGidsMap = snapshot.map;
+    }
+    applyTileEdits(snapshot.tileEdits);
+    m_decalTime = SDL_GetTicks() / 1000.0;
+    expireDecalChunks();
+    bakeDecals(snapshot.decals);
+
+    // Sort keys are completed here, where textures resolve to the texture they are batched with
+    // (atlas page, glyph page), then the frame is drawn in key order
+    const size_t commandCount = snapshot.commands.size();
+    m_sortKeys.resize(commandCount);
+    m_resolvedTextures.resize(commandCount);
+    m_sortTextureIds.clear();
+    for (size_t i = 0; i < commandCount; ++i) {
+        const RenderCommand& command = snapshot.commands[i];
+        TextureView view;
+        if (command.type == RenderCommandType::Texture) {
+            if (command.texture) {
+                view.texture = command.texture;
+            } else {
+                view = resolveTexture(command.handle);
+            }
+        } else if (command.type == RenderCommandType::PointSprites) {
+            view.texture = getSoftCircleTexture();
+        }
+        m_resolvedTextures[i] = view;
+
+        uint32_t textureId = 0; // Untextured
+        uint32_t blend = 0;
+        if (view.texture) {
+            auto inserted = m_sortTextureIds.emplace(view.texture, static_cast<uint32_t>(m_sortTextureIds.size() + 1));
+            textureId = inserted.first->second;
+            SDL_BlendMode blendMode = view.blendMode;
+            if (blendMode == SDL_BLENDMODE_INVALID && SDL_GetTextureBlendMode(view.texture, &blendMode) != 0) {
+                blendMode = SDL_BLENDMODE_BLEND;
+            }
+            blend = static_cast<uint32_t>(blendMode);
+        }
+        m_sortKeys[i] = makeRenderSortKey(command.layer, command.depth, blend, textureId);
+    }
+    radixSortByKey(m_sortKeys, m_sortOrder, m_sortKeyScratch, m_sortOrderScratch);
+    Uint64 drawCounter = SDL_GetPerformanceCounter();
+
+    clear();
+    int cameraIndex = -1;
+    m_camera = nullptr;
+    for (uint32_t commandIndex : m_sortOrder) {
+        const RenderCommand& command = snapshot.commands[commandIndex];
+        if (command.cameraIndex != cameraIndex) {
+            cameraIndex = command.cameraIndex;
+            m_camera = cameraIndex >= 0 ? &snapshot.cameras[cameraIndex] : nullptr;
+        }
+        switch (command.type) {
+            case RenderCommandType::Texture: {
+                drawTextureView(m_resolvedTextures[commandIndex], command.hasSrcRect ? &command.srcRect : nullptr, &command.dstRect,
+                                command.angle, command.hasCenter ? &command.center : nullptr, command.flip);
+                break;
+            }
+            case RenderCommandType::Rect:
+                drawRect(&command.dstRect, command.color, command.filled);
+                break;
+            case RenderCommandType::Line:
+                drawLine(command.x1, command.y1, command.x2, command.y2, command.color);
+                break;
+            case RenderCommandType::Circle:
+                drawCircle(command.x1, command.y1, command.radius, command.color, command.filled);
+                break;
+            case RenderCommandType::Text:
+                drawText(snapshot.strings[command.stringIndex], command.x1, command.y1, snapshot.fonts[command.fontIndex],
+                         command.fontSize, command.color);
+                break;
+            case RenderCommandType::PointSprites:
+                drawPointSprites(snapshot.pointSprites.data() + command.first, command.count);
+                break;
+            case RenderCommandType::Map:
+                if (snapshot.map) renderMap(*snapshot.map, command.mapLayer);
+                break;
+            case RenderCommandType::PrebakeMap:
+                if (snapshot.map) prebakeMap(*snapshot.map);
+                break;
+            case RenderCommandType::Decals:
+                renderDecals();
+                break;
+            case RenderCommandType::Minimap:
+                if (snapshot.map) renderMinimap(*snapshot.map, command.dstRect, snapshot.pointSprites.data() + command.first, command.count);
+                break;
+            case RenderCommandType::FogMask:
+                renderFogMask(snapshot.fogMask.empty() ? nullptr : snapshot.fogMask.data(), snapshot.fogWidth, snapshot.fogHeight,
+                              command.first, command.dstRect);
+                break;
+        }
+    }
+    m_camera = nullptr; // Points into the snapshot
+    m_spriteBatch.flush(); // Counted with the frame's draw calls, not with the swap
+    drawOverlay(snapshot.overlay);
+    Uint64 presentCounter = SDL_GetPerformanceCounter();
+    m_replayStats.drawCalls = m_spriteBatch.getDrawCallCount();
+    m_replayStats.triangles = m_spriteBatch.getTriangleCount();
+    if (snapshot.overlay.listCount > 0) m_replayStats.textureBytes = measureTextureMemory();
+    m_replayStats.textureCache = getTextureCacheStats();
+    present();
+
+    double msPerCount = 1000.0 / static_cast<double>(SDL_GetPerformanceFrequency());
+    m_replayStats.prepareMs = static_cast<double>(drawCounter - startCounter) * msPerCount;
+    m_replayStats.drawMs = static_cast<double>(presentCounter - drawCounter) * msPerCount;
+    m_replayStats.presentMs = static_cast<double>(SDL_GetPerformanceCounter() - presentCounter) * msPerCount;
+    m_replayStats.commandCount = commandCount;
+}
+
+void Renderer::recordOverlay() {
+    RenderSnapshot* snapshot = recordingSnapshot();
+    ImDrawData* drawData = ImGui::GetDrawData();
+    if (!snapshot || !drawData || !drawData->Valid) return;
+
+    OverlayDrawData& overlay = snapshot->overlay;
+    overlay.listCount = 0;
+    for (int i = 0; i < drawData->CmdListsCount; ++i) {
+        const ImDrawList* source = drawData->CmdLists[i];
+        if (overlay.listCount == overlay.lists.size()) {
+            overlay.lists.push_back(IM_NEW(ImDrawList)(ImGui::GetDrawListSharedData()));
+        }
+        ImDrawList* copy = overlay.lists[overlay.listCount++];
+        copyImVector(copy->CmdBuffer, source->CmdBuffer);
+        copyImVector(copy->IdxBuffer, source->IdxBuffer);
+        copyImVector(copy->VtxBuffer, source->VtxBuffer);
+        copy->Flags = source->Flags;
+    }
+    overlay.displayPos[0] = drawData->DisplayPos.x;
+    overlay.displayPos[1] = drawData->DisplayPos.y;
+    overlay.displaySize[0] = drawData->DisplaySize.x;
+    overlay.displaySize[1] = drawData->DisplaySize.y;
+    overlay.framebufferScale[0] = drawData->FramebufferScale.x;
+    overlay.framebufferScale[1] = drawData->FramebufferScale.y;
+}
+
+void Renderer::drawOverlay(const OverlayDrawData& overlay) {
+    if (overlay.listCount == 0 || !m_imguiInitialized) return;
+    SDL_RenderFlush(m_sdlRenderer); // SDL's queued draws go first; ImGui draws with GL directly
+
+    ImDrawData drawData;
+    drawData.Valid = true;
+    drawData.DisplayPos = ImVec2(overlay.displayPos[0], overlay.displayPos[1]);
+    drawData.DisplaySize = ImVec2(overlay.displaySize[0], overlay.displaySize[1]);
+    drawData.FramebufferScale = ImVec2(overlay.framebufferScale[0], overlay.framebufferScale[1]);
+    for (size_t i = 0; i < overlay.listCount; ++i) drawData.AddDrawList(overlay.lists[i]);
+    ImGui_ImplOpenGL3_RenderDrawData(&drawData);
+}
+
+size_t Renderer::measureTextureMemory() {
+    // 4 bytes per texel for every live texture; textures reachable from several caches count once
+    std::unordered_set<SDL_Texture*> seen;
+    size_t bytes = 0;
+    auto add = [&](SDL_Texture* texture) {
+        int width = 0, height = 0;
+        if (!texture || !seen.insert(texture).second || SDL_QueryTexture(texture, nullptr, nullptr, &width, &height) != 0) return;
+        bytes += static_cast<size_t>(width) * static_cast<size_t>(height) * 4;
+    };
+    {
+        std::lock_guard<std::mutex> lock(m_textureMutex);
+        for (const TextureSlot& slot : m_textureSlots) {
+            if (slot.view.region.w == 0) add(slot.view.texture); // Atlas pages are counted below
+        }
+    }
+    for (const auto& entry : m_textureCache) add(entry.second.texture);
+    for (const auto& layer : m_mapChunks) {
+        for (const MapChunk& chunk : layer.second.chunks) add(chunk.texture);
+    }
+    add(m_softCircleTexture);
+    // Pages are not reachable from here; they have fixed sizes
+    bytes += m_textureAtlas.getPageBytes();
+    for (const auto& font : m_glyphCaches) {
+        for (const auto& size : font.second) {
+            bytes += size.second->getPageCount() * GlyphCache::PAGE_SIZE * GlyphCache::PAGE_SIZE * 4;
+        }
+    }
+    return bytes;
+}
+
+void Renderer::setCamera(const Camera* camera) {
+    if (RenderSnapshot* snapshot = recordingSnapshot()) {
+        // Applies to the commands recorded after this; each command keeps its camera through sorting
+        snapshot->activeCamera = -1;
+        if (camera) {
+            snapshot->activeCamera = static_cast<int>(snapshot->cameras.size());
+            snapshot->cameras.push_back(*camera);
+        }
+        return;
+    }
+    m_camera = camera;
+}
+
+void Renderer::setDrawLayer(RenderLayer layer) {
+    if (RenderSnapshot* snapshot = recordingSnapshot()) snapshot->activeLayer = layer;
+}
+
+RenderCommand& Renderer::recordCommand(RenderSnapshot& snapshot, RenderCommandType type, float sortY) {
+    RenderCommand& command = snapshot.commands.emplace_back();
+    command.type = type;
+    command.layer = snapshot.activeLayer;
+    command.cameraIndex = snapshot.activeCamera;
+    switch (command.layer) {
+        case RenderLayer::World: command.depth = renderSortDepthFromY(sortY); break;
+        case RenderLayer::Effects: command.depth = 0; break; // Grouped by texture only
+        default: command.depth = static_cast<uint32_t>(snapshot.commands.size() - 1); break; // Submission order
+    }
+    return command;
+}
+
+const Camera* Renderer::getCamera() const {
+    if (RenderSnapshot* snapshot = recordingSnapshot()) {
+        return snapshot->activeCamera >= 0 ? &snapshot->cameras[snapshot->activeCamera] : nullptr;
+    }
+    return m_camera;
+}
+
+SDL_Texture* Renderer::loadTexture(const std::string& filePath) {
+    CachedTexture* entry = retainTexture(filePath);
+    if (!entry) return nullptr;
+    if (!entry->texture) {
+        // Atlased images have no texture of their own; callers of this API need one they can use directly
+        SDL_Surface* surface = m_textureDiskCache.load(filePath);
+        entry->texture = surface ? SDL_CreateTextureFromSurface(m_sdlRenderer, surface) : nullptr;
+        if (surface) SDL_FreeSurface(surface);
+        if (!entry->texture) {
+            Log::Error("Failed to create texture for '" + filePath + "': " + std::string(SDL_GetError()));
+            return nullptr;
+        }
+        int width = 0, height = 0;
+        if (SDL_QueryTexture(entry->texture, nullptr, nullptr, &width, &height) == 0) {
+            size_t bytes = static_cast<size_t>(width) * static_cast<size_t>(height) * 4;
+            entry->bytes += bytes;
+            m_textureCacheBytes += bytes;
+        }
+        m_texturePaths[entry->texture] = filePath;
+    }
+    entry->pinned = true; // The caller keeps the raw pointer
+    return entry->texture;
 }
+
+Renderer::CachedTexture* Renderer::retainTexture(const std::string& filePath) {
     if (!m_sdlRenderer) return nullptr;
 
     // Check cache first
     auto it = m_textureCache.find(filePath);
     if (it != m_textureCache.end()) {
-        return it->second; // Return cached texture
+        CachedTexture& entry = it->second;
+        if (entry.unreferenced) {
+            m_unusedTextures.erase(entry.unusedPosition);
+            entry.unreferenced = false;
+        }
+        return &entry; // Return cached texture
     }
 
-    // Not in cache, try to load
-    SDL_Texture* newTexture = IMG_LoadTexture(m_sdlRenderer, filePath.c_str());
+    // Not in cache, try to load. Small images go to the atlas only; the rest get their own texture.
+    // Mod overrides and the install directory first, the working directory otherwise (as getFont does);
+    // the cache stays keyed by the requested path, which is what handles and callers know.
+    std::string fullPath = m_assetManager ? m_assetManager->resolvePath(filePath) : std::string();
+    if (fullPath.empty()) fullPath = filePath;
+    CachedTexture entry;
+    SDL_Surface* surface = m_textureDiskCache.load(fullPath); // Decoded pixels from disk when the PNG is unchanged
+    if (surface) {
+        if (const TextureAtlas::Region* region = m_textureAtlas.add(filePath, surface)) {
+            entry.atlased = true; // Its bytes are the page's, counted through the atlas
+            entry.region = *region;
+        } else {
+            entry.texture = SDL_CreateTextureFromSurface(m_sdlRenderer, surface);
+        }
+        SDL_FreeSurface(surface);
+    }
 
-    if (!newTexture) {
-        Log::Error("Failed to load texture '" + filePath + "'! IMG_Error: " + std::string(IMG_GetError()) + ". Generating placeholder.");
+    if (!entry.atlased && !entry.texture) {
+        Log::Error("Failed to load texture '" + fullPath + "'! IMG_Error: " + std::string(IMG_GetError()) + ". Generating placeholder.");
         // If loading fails, generate a placeholder texture
-        newTexture = generatePlaceholderTexture(64, 64, filePath);
-        if (!newTexture) {
+        entry.texture = generatePlaceholderTexture(64, 64, filePath);
+        if (!entry.texture) {
             Log::Error("Failed to generate placeholder texture for '" + filePath + "'.");
             return nullptr;
         }
+        entry.placeholder = true;
     }
 
      // std::cout << "Loaded texture: " << filePath << std::endl; // Debug logging
     // Add to cache
-    m_textureCache[filePath] = newTexture;
-    return newTexture;
+    if (entry.texture) {
+        int width = 0, height = 0;
+        if (SDL_QueryTexture(entry.texture, nullptr, nullptr, &width, &height) == 0) {
+            entry.bytes = static_cast<size_t>(width) * static_cast<size_t>(height) * 4;
+        }
+        m_texturePaths[entry.texture] = filePath;
+    }
+    m_textureCacheBytes += entry.bytes;
+    CachedTexture& cached = m_textureCache[filePath] = entry;
+    enforceTextureBudget(); // Makes room among the unreferenced textures
+    return &cached;
+}
+
+void Renderer::unreferenceTexture(const std::string& filePath) {
+    auto it = m_textureCache.find(filePath);
+    if (it == m_textureCache.end() || it->second.pinned || it->second.unreferenced) return;
+    if (it->second.placeholder) {
+        // Retried on the next load, in case the file appeared
+        m_spriteBatch.flush(); // Queued quads may still reference the texture
+        eraseCachedTexture(it);
+        return;
+    }
+    m_unusedTextures.push_front(it->first);
+    it->second.unusedPosition = m_unusedTextures.begin();
+    it->second.unreferenced = true;
+    enforceTextureBudget();
+}
+
+void Renderer::eraseCachedTexture(std::unordered_map<std::string, CachedTexture>::iterator it) {
+    CachedTexture& entry = it->second;
+    if (entry.unreferenced) m_unusedTextures.erase(entry.unusedPosition);
+    m_textureCacheBytes -= entry.bytes;
+    if (entry.atlased) m_textureAtlas.remove(it->first); // Frees the cell, and the page once it is empty
+    if (entry.texture) {
+        m_texturePaths.erase(entry.texture);
+        SDL_DestroyTexture(entry.texture);
+    }
+    m_textureCache.erase(it);
+}
+
+void Renderer::enforceTextureBudget() {
+    if (getTextureCacheBytes() <= m_textureBudget || m_unusedTextures.empty()) return;
+    m_spriteBatch.flush(); // Queued quads may still reference an evicted texture
+    // Evicting an atlased image only frees memory once its page is empty, but its cell is reused
+    // before a new page is allocated, so the atlas stops growing either way
+    while (getTextureCacheBytes() > m_textureBudget && !m_unusedTextures.empty()) {
+        auto it = m_textureCache.find(m_unusedTextures.back());
+        if (it == m_textureCache.end()) {
+            m_unusedTextures.pop_back();
+            continue;
+        }
+        size_t before = getTextureCacheBytes();
+        ++m_textureEvictions;
+        eraseCachedTexture(it); // Also takes it off the unused list
+        m_textureEvictedBytes += before - getTextureCacheBytes();
+    }
+}
+
+void Renderer::setTextureBudget(size_t bytes) {
+    m_textureBudget = bytes;
+    enforceTextureBudget();
+}
+
+Renderer::TextureCacheStats Renderer::getTextureCacheStats() const {
+    TextureCacheStats stats;
+    stats.bytes = getTextureCacheBytes();
+    stats.atlasBytes = m_textureAtlas.getPageBytes();
+    stats.budget = m_textureBudget;
+    stats.textures = m_textureCache.size();
+    stats.unreferenced = m_unusedTextures.size();
+    stats.evictions = m_textureEvictions;
+    stats.evictedBytes = m_textureEvictedBytes;
+    return stats;
+}
+
+TextureHandle Renderer::acquireTexture(const std::string& filePath) {
+    std::unique_lock<std::mutex> lock(m_textureMutex);
+    auto existing = m_textureSlotByPath.find(filePath);
+    if (existing != m_textureSlotByPath.end()) {
+        TextureSlot& slot = m_textureSlots[existing->second];
+        ++slot.refCount;
+        return {existing->second, slot.generation};
+    }
+
+    uint32_t index;
+    if (!m_freeTextureSlots.empty()) {
+        index = m_freeTextureSlots.back();
+        m_freeTextureSlots.pop_back();
+    } else {
+        index = static_cast<uint32_t>(m_textureSlots.size());
+        m_textureSlots.emplace_back();
+    }
+    TextureSlot& slot = m_textureSlots[index];
+    if (++slot.generation == 0) slot.generation = 1; // 0 marks invalid handles
+    slot.view = TextureView{};
+    slot.view.blendMode = SDL_BLENDMODE_BLEND;
+    slot.refCount = 1;
+    slot.path = filePath;
+    m_textureSlotByPath[filePath] = index;
+    TextureHandle handle = {index, slot.generation};
+
+    if (!isRenderThread()) {
+        m_pendingTextureLoads.push_back(handle); // Draws of the handle are skipped until it is loaded
+        return handle;
+    }
+    lock.unlock(); // The texture cache is render-thread only
+    const CachedTexture* entry = retainTexture(filePath);
+    lock.lock();
+    setSlotTexture(m_textureSlots[index], entry);
+    return handle;
+}
+
+void Renderer::setSlotTexture(TextureSlot& slot, const CachedTexture* entry) {
+    if (!entry) {
+        slot.view.texture = nullptr;
+        slot.view.region = {0, 0, 0, 0};
+    } else if (entry->atlased) {
+        slot.view.texture = entry->region.page;
+        slot.view.region = entry->region.rect;
+    } else {
+        slot.view.texture = entry->texture;
+        slot.view.region = {0, 0, 0, 0}; // Whole texture
+    }
+}
+
+void Renderer::releaseTexture(TextureHandle handle) {
+    std::unique_lock<std::mutex> lock(m_textureMutex);
+    if (!handle || handle.index >= m_textureSlots.size()) return;
+    TextureSlot& slot = m_textureSlots[handle.index];
+    if (slot.generation != handle.generation || slot.refCount == 0) return;
+    if (--slot.refCount > 0) return;
+
+    bool loaded = slot.view.texture != nullptr;
+    std::string path = std::move(slot.path);
+    m_textureSlotByPath.erase(path);
+    slot.view = TextureView{};
+    slot.path.clear();
+    if (++slot.generation == 0) slot.generation = 1; // Outstanding copies of the handle become stale
+    m_freeTextureSlots.push_back(handle.index);
+    if (!loaded) return; // A pending load finds the slot stale and unreferences the path itself
+
+    if (!isRenderThread()) {
+        m_pendingTextureReleases.push_back(std::move(path)); // A snapshot being drawn may still use it
+        return;
+    }
+    lock.unlock();
+    unreferenceTexture(path);
+}
+
+SDL_Texture* Renderer::getTexture(TextureHandle handle) const {
+    return resolveTexture(handle).texture;
+}
+
+Renderer::TextureView Renderer::resolveTexture(TextureHandle handle) const {
+    std::lock_guard<std::mutex> lock(m_textureMutex);
+    if (handle.index >= m_textureSlots.size()) return TextureView{};
+    const TextureSlot& slot = m_textureSlots[handle.index];
+    return slot.generation == handle.generation ? slot.view : TextureView{};
+}
+
+bool Renderer::getTextureImage(TextureHandle handle, SDL_Texture*& texture, SDL_FRect& uvRect) const {
+    TextureView view = resolveTexture(handle);
+    texture = view.texture;
+    uvRect = {0.0f, 0.0f, 1.0f, 1.0f};
+    if (!texture) return false;
+    int width = 0, height = 0;
+    if (view.region.w > 0 && SDL_QueryTexture(texture, nullptr, nullptr, &width, &height) == 0 && width > 0 && height > 0) {
+        uvRect = {static_cast<float>(view.region.x) / width, static_cast<float>(view.region.y) / height,
+                  static_cast<float>(view.region.w) / width, static_cast<float>(view.region.h) / height};
+    }
+    return true;
+}
+
+void Renderer::setTextureColorMod(TextureHandle handle, const Color& color) {
+    std::lock_guard<std::mutex> lock(m_textureMutex);
+    if (handle.index >= m_textureSlots.size()) return;
+    TextureSlot& slot = m_textureSlots[handle.index];
+    if (slot.generation == handle.generation) slot.view.colorMod = {color.r, color.g, color.b, color.a};
+}
+
+void Renderer::setTextureBlendMode(TextureHandle handle, SDL_BlendMode blendMode) {
+    std::lock_guard<std::mutex> lock(m_textureMutex);
+    if (handle.index >= m_textureSlots.size()) return;
+    TextureSlot& slot = m_textureSlots[handle.index];
+    if (slot.generation == handle.generation) slot.view.blendMode = blendMode;
+}
+
+void Renderer::processPendingTextureWork() {
+    std::vector<TextureHandle> loads;
+    std::vector<std::string> releases;
+    std::vector<std::string> paths;
+    {
+        std::lock_guard<std::mutex> lock(m_textureMutex);
+        loads.swap(m_pendingTextureLoads);
+        releases.swap(m_pendingTextureReleases);
+        for (TextureHandle handle : loads) {
+            paths.push_back(m_textureSlots[handle.index].path);
+        }
+    }
+
+    // Releases first, so a path released and acquired again takes its texture back off the unused list
+    for (const std::string& path : releases) {
+        unreferenceTexture(path);
+    }
+
+    for (size_t i = 0; i < loads.size(); ++i) {
+        const CachedTexture* entry = retainTexture(paths[i]);
+        std::unique_lock<std::mutex> lock(m_textureMutex);
+        TextureSlot& slot = m_textureSlots[loads[i].index];
+        if (slot.generation == loads[i].generation) {
+            setSlotTexture(slot, entry);
+        } else if (entry && m_textureSlotByPath.find(paths[i]) == m_textureSlotByPath.end()) {
+            lock.unlock();
+            unreferenceTexture(paths[i]); // Released again before it was loaded
+        }
+    }
+}
+
+void Renderer::drawTexture(TextureHandle texture, const SDL_Rect* srcRect, const SDL_FRect* dstRect, double angle, const SDL_FPoint* center, SDL_RendererFlip flip) {
+    if (RenderSnapshot* snapshot = recordingSnapshot()) {
+        if (!texture || !dstRect) return;
+        RenderCommand& command = recordCommand(*snapshot, RenderCommandType::Texture, dstRect->y + dstRect->h);
+        command.handle = texture;
+        command.hasSrcRect = srcRect != nullptr;
+        if (srcRect) command.srcRect = *srcRect;
+        command.dstRect = *dstRect;
+        command.angle = angle;
+        command.hasCenter = center != nullptr;
+        if (center) command.center = *center;
+        command.flip = flip;
+        return;
+    }
+    drawTextureView(resolveTexture(texture), srcRect, dstRect, angle, center, flip);
 }
 
 void Renderer::drawTexture(SDL_Texture* texture, const SDL_Rect* srcRect, const SDL_FRect* dstRect, double angle, const SDL_FPoint* center, SDL_RendererFlip flip) {
-    if (!m_sdlRenderer || !texture) return;
+    if (RenderSnapshot* snapshot = recordingSnapshot()) {
+        if (!texture || !dstRect) return; // Whole-target copies are not recorded
+        RenderCommand& command = recordCommand(*snapshot, RenderCommandType::Texture, dstRect->y + dstRect->h);
+        command.texture = texture;
+        command.hasSrcRect = srcRect != nullptr;
+        if (srcRect) command.srcRect = *srcRect;
+        command.dstRect = *dstRect;
+        command.angle = angle;
+        command.hasCenter = center != nullptr;
+        if (center) command.center = *center;
+        command.flip = flip;
+        return;
+    }
+    TextureView view;
+    view.texture = texture; // Raw textures keep their own SDL color/alpha/blend mods
+    drawTextureView(view, srcRect, dstRect, angle, center, flip);
+}
 
-    // SDL2's SDL_RenderCopyEx takes SDL_Rect for src and SDL_Rect for dst
-    // We need to convert SDL_FRect to SDL_Rect for dstRect if it's used.
-    // For now, assuming dstRect is already in integer coordinates or will be converted.
-    // If dstRect is float, it needs to be cast to SDL_Rect or use SDL_RenderCopyExF if available (SDL 2.0.10+)
+void Renderer::drawTextureView(const TextureView& view, const SDL_Rect* srcRect, const SDL_FRect* dstRect, double angle, const SDL_FPoint* center, SDL_RendererFlip flip) {
+    if (!m_sdlRenderer || !view.texture) return;
+
+    SDL_FRect screenRect;
+    SDL_FPoint screenCenter;
+    if (m_camera && dstRect) {
+        screenRect = m_camera->worldToScreen(*dstRect);
+        dstRect = &screenRect;
+        if (center) {
+            screenCenter = {center->x * m_camera->getZoom(), center->y * m_camera->getZoom()};
+            center = &screenCenter;
+        }
+    }
 
-    if (SDL_RenderCopyExF(m_sdlRenderer, texture, srcRect, dstRect, angle, center, flip) != 0) {
-        Log::Error("Error rendering texture: " + std::string(SDL_GetError()));
+    // Atlased images are drawn from their page so consecutive sprites share one batch
+    SDL_Rect atlasSrcRect;
+    if (view.region.w > 0) {
+        const SDL_Rect& region = view.region;
+        atlasSrcRect = srcRect ? SDL_Rect{region.x + srcRect->x, region.y + srcRect->y, srcRect->w, srcRect->h} : region;
+        srcRect = &atlasSrcRect;
     }
+
+    const SDL_Color& mod = view.colorMod;
+    SDL_BlendMode blendMode = m_blendModeOverride != SDL_BLENDMODE_INVALID ? m_blendModeOverride : view.blendMode;
+    if (!dstRect) {
+        // Whole render target: not worth batching
+        m_spriteBatch.flush();
+        bool tinted = mod.r != 255 || mod.g != 255 || mod.b != 255 || mod.a != 255;
+        if (tinted) {
+            SDL_SetTextureColorMod(view.texture, mod.r, mod.g, mod.b);
+            SDL_SetTextureAlphaMod(view.texture, mod.a);
+        }
+        if (blendMode != SDL_BLENDMODE_INVALID) SDL_SetTextureBlendMode(view.texture, blendMode);
+        if (SDL_RenderCopyExF(m_sdlRenderer, view.texture, srcRect, dstRect, angle, center, flip) != 0) {
+            Log::Error("Error rendering texture: " + std::string(SDL_GetError()));
+        }
+        if (tinted) {
+            // Atlas pages are shared, so the mods must not leak into other images
+            SDL_SetTextureColorMod(view.texture, 255, 255, 255);
+            SDL_SetTextureAlphaMod(view.texture, 255);
+        }
+        return;
+    }
+    m_spriteBatch.drawTexture(view.texture, srcRect, *dstRect, angle, center, flip, mod, blendMode);
 }
 
 void Renderer::destroyTexture(SDL_Texture* texture) {
     if (!texture) return;
 
-    // Remove from cache if present
-    for (auto it = m_textureCache.begin(); it != m_textureCache.end(); ++it) {
-        if (it->second == texture) {
-            m_textureCache.erase(it);
-            break;
+    auto path = m_texturePaths.find(texture);
+    if (path == m_texturePaths.end()) {
+        SDL_DestroyTexture(texture);
+        return;
+    }
+    auto it = m_textureCache.find(path->second);
+    if (it == m_textureCache.end()) {
+        m_texturePaths.erase(path);
+        SDL_DestroyTexture(texture);
+        return;
+    }
+    m_spriteBatch.flush(); // Queued quads may still reference the texture
+    bool handled;
+    {
+        std::lock_guard<std::mutex> lock(m_textureMutex);
+        handled = m_textureSlotByPath.find(it->first) != m_textureSlotByPath.end();
+    }
+    if (it->second.atlased && handled) {
+        // Handles still draw from the atlas; drop only the texture loadTexture() made
+        CachedTexture& entry = it->second;
+        int width = 0, height = 0;
+        if (SDL_QueryTexture(texture, nullptr, nullptr, &width, &height) == 0) {
+            size_t bytes = static_cast<size_t>(width) * static_cast<size_t>(height) * 4;
+            entry.bytes -= bytes;
+            m_textureCacheBytes -= bytes;
         }
+        m_texturePaths.erase(path);
+        SDL_DestroyTexture(texture);
+        entry.texture = nullptr;
+        entry.pinned = false;
+        return;
     }
-    SDL_DestroyTexture(texture);
+    eraseCachedTexture(it); // Frees its atlas cell too
 }
 
 void Renderer::drawRect(const SDL_FRect* rect, const Color& color, bool filled) {
-    if (!m_sdlRenderer || !rect) return;
+    if (!rect) return;
+    if (RenderSnapshot* snapshot = recordingSnapshot()) {
+        RenderCommand& command = recordCommand(*snapshot, RenderCommandType::Rect, rect->y + rect->h);
+        command.dstRect = *rect;
+        command.color = color;
+        command.filled = filled;
+        return;
+    }
+    if (!m_sdlRenderer) return;
+
+    SDL_FRect screenRect;
+    if (m_camera) {
+        screenRect = m_camera->worldToScreen(*rect);
+        rect = &screenRect;
+    }
 
-    SDL_SetRenderDrawColor(m_sdlRenderer, color.r, color.g, color.b, color.a);
     if (filled) {
-        SDL_RenderFillRectF(m_sdlRenderer, rect);
+        m_spriteBatch.fillRect(*rect, {color.r, color.g, color.b, color.a});
     } else {
-        SDL_RenderDrawRectF(m_sdlRenderer, rect);
+        m_spriteBatch.drawRect(*rect, {color.r, color.g, color.b, color.a});
     }
 }
 
 void Renderer::drawLine(float x1, float y1, float x2, float y2, const Color& color) {
+    if (RenderSnapshot* snapshot = recordingSnapshot()) {
+        RenderCommand& command = recordCommand(*snapshot, RenderCommandType::Line, std::max(y1, y2));
+        command.x1 = x1; command.y1 = y1;
+        command.x2 = x2; command.y2 = y2;
+        command.color = color;
+        return;
+    }
     if (!m_sdlRenderer) return;
-    SDL_SetRenderDrawColor(m_sdlRenderer, color.r, color.g, color.b, color.a);
-    SDL_RenderDrawLineF(m_sdlRenderer, x1, y1, x2, y2);
+    if (m_camera) {
+        Vec2 start = m_camera->worldToScreen(Vec2{x1, y1});
+        Vec2 end = m_camera->worldToScreen(Vec2{x2, y2});
+        x1 = start.x; y1 = start.y;
+        x2 = end.x; y2 = end.y;
+    }
+    m_spriteBatch.drawLine(x1, y1, x2, y2, {color.r, color.g, color.b, color.a});
+}
+
+SDL_FRect Renderer::getVisibleWorldRect() const {
+    if (const Camera* camera = getCamera()) return camera->getVisibleWorldRect();
+    return {0.0f, 0.0f, static_cast<float>(m_windowWidth), static_cast<float>(m_windowHeight)};
 }
 
+bool Renderer::isVisible(const SDL_FRect& worldRect) const {
+    SDL_FRect view = getVisibleWorldRect();
+    return worldRect.x < view.x + view.w && worldRect.x + worldRect.w > view.x &&
+           worldRect.y < view.y + view.h && worldRect.y + worldRect.h > view.y;
+}
 
-TTF_Font* Renderer::getFont(const std::string& relativePath, int fontSize) {
-    std::string fullPath = m_assetManager->resolvePath(relativePath);
-    if (fullPath.empty()) {
-        Log::Warning("Font not found: " + relativePath);
-        return getFont("assets/fonts/nokia.ttf", fontSize); // Fallback to default font
-    }
 
-    std::string key = fullPath + std::to_string(fontSize);
-    if (m_fontCache.count(key)) {
-        return m_fontCache[key];
+TTF_Font* Renderer::getFont(const std::string& fontPath, int fontSize) {
+    std::pair<std::string, int> key = {fontPath, fontSize};
+    auto it = m_fontCache.find(key);
+    if (it != m_fontCache.end()) {
+        return it->second;
     }
 
+    // Mod overrides and the install directory first; the working directory otherwise
+    const std::string defaultFont = "assets/fonts/nokia.ttf";
+    std::string fullPath = m_assetManager ? m_assetManager->resolvePath(fontPath) : std::string();
+    if (fullPath.empty()) fullPath = fontPath;
     TTF_Font* font = TTF_OpenFont(fullPath.c_str(), fontSize);
     if (!font) {
         Log::Warning("Failed to load font: " + fullPath + ", error: " + TTF_GetError());
-        return getFont("assets/fonts/nokia.ttf", fontSize); // Fallback to default font
+        if (fontPath == defaultFont) return nullptr;
+        return getFont(defaultFont, fontSize); // Fallback to default font
     }
 
     m_fontCache[key] = font;
     return font;
 }
 
+GlyphCache* Renderer::getGlyphCache(const std::string& fontPath, int fontSize) {
+    // Two lookups without building a key string, since this runs for every drawText call
+    auto& sizes = m_glyphCaches[fontPath];
+    auto it = sizes.find(fontSize);
+    if (it != sizes.end()) return it->second.get();
+
+    TTF_Font* font = getFont(fontPath, fontSize);
+    if (!font) return nullptr;
+    return sizes.emplace(fontSize, std::make_unique<GlyphCache>(m_sdlRenderer, font)).first->second.get();
+}
+
 SDL_Texture* Renderer::createPlaceholderTexture() {
     SDL_Surface* surface = SDL_CreateRGBSurface(0, 32, 32, 32, 0, 0, 0, 0);
     SDL_FillRect(surface, NULL, SDL_MapRGB(surface->format, 255, 0, 255));
@@ -306,66 +1066,107 @@ SDL_Texture* Renderer::createPlaceholderTexture() {
 
 
 void Renderer::drawText(const std::string& text, float x, float y, const std::string& fontPath, int fontSize, const Color& color) {
-     if (!m_sdlRenderer || text.empty()) return;
-
-     TTF_Font* font = getFont(fontPath, fontSize);
-     if (!font) {
-         return; // Font loading failed
+     if (text.empty()) return;
+     if (RenderSnapshot* snapshot = recordingSnapshot()) {
+         RenderCommand& command = recordCommand(*snapshot, RenderCommandType::Text, y + static_cast<float>(fontSize));
+         command.x1 = x; command.y1 = y;
+         command.fontSize = fontSize;
+         command.color = color;
+         command.stringIndex = static_cast<uint32_t>(snapshot->strings.size());
+         snapshot->strings.push_back(text);
+         // Frames use a handful of fonts; store each path once
+         auto font = std::find(snapshot->fonts.begin(), snapshot->fonts.end(), fontPath);
+         command.fontIndex = static_cast<uint32_t>(font - snapshot->fonts.begin());
+         if (font == snapshot->fonts.end()) snapshot->fonts.push_back(fontPath);
+         return;
      }
+     if (!m_sdlRenderer) return;
 
-     // 1. Render text surface (using Blended for quality with alpha)
-     // Note: TTF_RenderText_Solid is faster but no alpha. UTF8 variants exist too.
-     SDL_Surface* textSurface = TTF_RenderText_Blended(font, text.c_str(), {color.r, color.g, color.b, color.a});
-     if (!textSurface) {
-         Log::Error("Failed to render text surface! TTF_Error: " + std::string(TTF_GetError()));
-         // Font is cached, no need to close it here unless loadFont failed internally
-         return;
+     GlyphCache* glyphCache = getGlyphCache(fontPath, fontSize);
+     if (!glyphCache) {
+         return; // Font loading failed
      }
 
-     // 2. Create texture from surface
-     SDL_Texture* textTexture = SDL_CreateTextureFromSurface(m_sdlRenderer, textSurface);
-     if (!textTexture) {
-          Log::Error("Failed to create text texture! SDL_Error: " + std::string(SDL_GetError()));
-          SDL_FreeSurface(textSurface); // Clean up surface
-          return;
+     // Cached layout of white glyph quads, tinted through the vertex color. Screen space, bypasses the camera.
+     for (const GlyphCache::Quad& quad : glyphCache->layout(text)) {
+         SDL_FRect dstRect = {x + quad.dstRect.x, y + quad.dstRect.y, quad.dstRect.w, quad.dstRect.h};
+         m_spriteBatch.drawTexture(quad.page, &quad.srcRect, dstRect, 0.0, nullptr, SDL_FLIP_NONE,
+                                   {color.r, color.g, color.b, color.a});
      }
+}
 
-     // 3. Get texture dimensions and prepare destination rect
-     SDL_FRect dstRect = {x, y, static_cast<float>(textSurface->w), static_cast<float>(textSurface->h)};
 
-     // 4. Render the texture
-     drawTexture(textTexture, nullptr, &dstRect); // Draw whole texture
+SDL_Texture* Renderer::getSoftCircleTexture() {
+    if (m_softCircleTexture || !m_sdlRenderer) return m_softCircleTexture;
+
+    const int size = 32;
+    std::vector<uint32_t> pixels(static_cast<size_t>(size) * size);
+    for (int y = 0; y < size; ++y) {
+        for (int x = 0; x < size; ++x) {
+            float dx = (x + 0.5f) / size * 2.0f - 1.0f;
+            float dy = (y + 0.5f) / size * 2.0f - 1.0f;
+            float distance = std::sqrt(dx * dx + dy * dy);
+            // Solid disc fading out over the outer eighth of the radius
+            float alpha = std::clamp((1.0f - distance) * 8.0f, 0.0f, 1.0f);
+            uint8_t a = static_cast<uint8_t>(alpha * 255.0f);
+            // SDL_PIXELFORMAT_RGBA32 is byte order R, G, B, A
+            uint8_t* bytes = reinterpret_cast<uint8_t*>(&pixels[static_cast<size_t>(y) * size + x]);
+            bytes[0] = 255; bytes[1] = 255; bytes[2] = 255; bytes[3] = a;
+        }
+    }
 
-     // 5. Clean up surface and texture (texture is temporary for this draw call)
-     SDL_FreeSurface(textSurface);
-     SDL_DestroyTexture(textTexture);
+    m_softCircleTexture = SDL_CreateTexture(m_sdlRenderer, SDL_PIXELFORMAT_RGBA32, SDL_TEXTUREACCESS_STATIC, size, size);
+    if (!m_softCircleTexture) {
+        Log::Error("Failed to create point sprite texture: " + std::string(SDL_GetError()));
+        return nullptr;
+    }
+    SDL_UpdateTexture(m_softCircleTexture, nullptr, pixels.data(), size * static_cast<int>(sizeof(uint32_t)));
+    SDL_SetTextureBlendMode(m_softCircleTexture, SDL_BLENDMODE_BLEND);
+    return m_softCircleTexture;
 }
 
+void Renderer::drawPointSprites(const PointSprite* sprites, size_t count) {
+    if (count == 0) return;
+    if (RenderSnapshot* snapshot = recordingSnapshot()) {
+        RenderCommand& command = recordCommand(*snapshot, RenderCommandType::PointSprites, 0.0f);
+        command.first = static_cast<uint32_t>(snapshot->pointSprites.size());
+        command.count = static_cast<uint32_t>(count);
+        snapshot->pointSprites.insert(snapshot->pointSprites.end(), sprites, sprites + count);
+        return;
+    }
+    if (!m_sdlRenderer) return;
+    SDL_Texture* texture = getSoftCircleTexture();
+    if (!texture) return;
+
+    if (m_camera) {
+        SDL_FRect view = m_camera->getVisibleWorldRect();
+        m_spriteBatch.drawPointSprites(texture, sprites, count, {view.x, view.y}, m_camera->getZoom());
+    } else {
+        m_spriteBatch.drawPointSprites(texture, sprites, count);
+    }
+}
 
 void Renderer::drawCircle(float x, float y, float radius, const Color& color, bool filled) {
+    if (RenderSnapshot* snapshot = recordingSnapshot()) {
+        RenderCommand& command = recordCommand(*snapshot, RenderCommandType::Circle, y + radius);
+        command.x1 = x; command.y1 = y;
+        command.radius = radius;
+        command.color = color;
+        command.filled = filled;
+        return;
+    }
     if (!m_sdlRenderer) return;
-
-    SDL_SetRenderDrawColor(m_sdlRenderer, color.r, color.g, color.b, color.a);
+    if (m_camera) {
+        Vec2 center = m_camera->worldToScreen(Vec2{x, y});
+        x = center.x;
+        y = center.y;
+        radius *= m_camera->getZoom();
+    }
 
     if (filled) {
-        // Draw filled circle using a series of horizontal lines
-        for (int dy = 0; dy <= radius; ++dy) {
-            float dx = std::sqrt(radius * radius - dy * dy);
-            SDL_RenderDrawLineF(m_sdlRenderer, x - dx, y + dy, x + dx, y + dy);
-            SDL_RenderDrawLineF(m_sdlRenderer, x - dx, y - dy, x + dx, y - dy);
-        }
+        m_spriteBatch.fillCircle(x, y, radius, {color.r, color.g, color.b, color.a});
     } else {
-        // Draw outline using midpoint circle algorithm or similar
-        int segments = 36; // Number of segments to approximate the circle
-        for (int i = 0; i < segments; ++i) {
-            float angle1 = (float)i / segments * 2 * M_PI;
-            float angle2 = (float)(i + 1) / segments * 2 * M_PI;
-            float x1 = x + radius * std::cos(angle1);
-            float y1 = y + radius * std::sin(angle1);
-            float x2 = x + radius * std::cos(angle2);
-            float y2 = y + radius * std::sin(angle2);
-            SDL_RenderDrawLineF(m_sdlRenderer, x1, y1, x2, y2);
-        }
+        m_spriteBatch.drawCircle(x, y, radius, {color.r, color.g, color.b, color.a});
     }
 }
 
@@ -379,8 +1180,12 @@ SDL_Texture* Renderer::generatePlaceholderTexture(int width, int height, const s
         return nullptr;
     }
 
-    // Set the texture as the current rendering target
+    // Set the texture as the current rendering target (texture space, so no camera transform)
+    m_spriteBatch.flush();
+    SDL_Texture* previousTarget = SDL_GetRenderTarget(m_sdlRenderer);
     SDL_SetRenderTarget(m_sdlRenderer, placeholderTexture);
+    const Camera* savedCamera = m_camera;
+    m_camera = nullptr;
 
     // Save current draw color
     Uint8 oldR, oldG, oldB, oldA;
@@ -423,80 +1228,611 @@ SDL_Texture* Renderer::generatePlaceholderTexture(int width, int height, const s
     }
 
     // Restore previous rendering target and draw color
-    SDL_SetRenderTarget(m_sdlRenderer, nullptr);
+    m_spriteBatch.flush();
+    SDL_SetRenderTarget(m_sdlRenderer, previousTarget);
     SDL_SetRenderDrawColor(m_sdlRenderer, oldR, oldG, oldB, oldA);
+    m_camera = savedCamera;
 
     Log::Info("Generated placeholder texture for '" + assetName + "' (W: " + std::to_string(width) + ", H: " + std::to_string(height) + ").");
     return placeholderTexture;
 }
 
 // Placeholder for Map Rendering - requires MapManager implementation details
+bool Renderer::isLayerDrawnAs(const std::string& layerName, MapLayer layer) {
+    // This is a simplified check; a more robust system might use layer properties from Tiled
+    bool isBackground = layerName.find("background") != std::string::npos;
+    bool isForeground = layerName.find("foreground") != std::string::npos;
+    bool isObject = layerName.find("object") != std::string::npos;
+    switch (layer) {
+        // Layers without a recognised name are drawn with the background
+        case MapLayer::Background: return isBackground || (!isForeground && !isObject);
+        case MapLayer::Foreground: return isForeground;
+        // Object layers are typically handled by EntityManager, but if they contain tiles, render them
+        case MapLayer::Objects: return isObject;
+        default: return false;
+    }
+}
+
+void Renderer::drawTiles(const MapManager& mapManager, size_t layerIndex, unsigned x0, unsigned y0, unsigned x1, unsigned y1, float offsetX, float offsetY) {
+    const auto& tileLayer = mapManager.getRawLayers()[layerIndex]->getLayerAs<tmx::TileLayer>();
+    const auto& tiles = tileLayer.getTiles();
+    unsigned tileWidth = mapManager.getTileWidth();
+    unsigned tileHeight = mapManager.getTileHeight();
+    x1 = std::min(x1, tileLayer.getSize().x);
+    y1 = std::min(y1, tileLayer.getSize().y);
+
+    for (unsigned int y = y0; y < y1; ++y) {
+        for (unsigned int x = x0; x < x1; ++x) {
+            unsigned int tileIndex = x + y * tileLayer.getSize().x;
+            if (tileIndex >= tiles.size()) continue;
+            const auto& tile = tiles[tileIndex];
+            uint32_t gid = getTileGid(layerIndex, x, y); // Includes destroyed/edited tiles
+            if (gid == 0) continue; // ID 0 means empty tile
+
+            const TilesetInfo* tilesetInfo = mapManager.findTilesetForGid(gid);
+            if (!tilesetInfo) continue;
+            auto tilesetTexture = m_tilesetTextures.find(tilesetInfo); // Resolved once per map
+            if (tilesetTexture == m_tilesetTextures.end() || !tilesetTexture->second) continue;
+
+            SDL_Rect srcRect = mapManager.getSourceRectForGid(gid, *tilesetInfo);
+            SDL_FRect dstRect = {
+                static_cast<float>(x * tileWidth) + offsetX,
+                static_cast<float>(y * tileHeight) + offsetY,
+                static_cast<float>(tileWidth),
+                static_cast<float>(tileHeight)
+            };
+
+            // Apply tile flipping if necessary (Tiled supports horizontal, vertical, diagonal flip)
+            SDL_RendererFlip flip = SDL_FLIP_NONE;
+            if (gid == tile.ID && tile.flipFlags & tmx::TileLayer::FlipFlag::Horizontal) flip = static_cast<SDL_RendererFlip>(flip | SDL_FLIP_HORIZONTAL);
+            if (gid == tile.ID && tile.flipFlags & tmx::TileLayer::FlipFlag::Vertical) flip = static_cast<SDL_RendererFlip>(flip | SDL_FLIP_VERTICAL);
+            // Diagonal flip is more complex and might require rotation + flip, or custom shader
+
+            drawTexture(tilesetTexture->second, &srcRect, &dstRect, 0.0, nullptr, flip);
+        }
+    }
+}
+
+void Renderer::invalidateMapCache() {
+    for (auto& [layer, chunkLayer] : m_mapChunks) {
+        for (MapChunk& chunk : chunkLayer.chunks) {
+            if (chunk.texture) SDL_DestroyTexture(chunk.texture);
+        }
+    }
+    m_mapChunks.clear();
+    m_chunkMap = nullptr;
+    m_chunkBakingFailed = false;
+    if (m_minimapTexture) SDL_DestroyTexture(m_minimapTexture);
+    m_minimapTexture = nullptr;
+    m_minimapMap = nullptr;
+}
+
+void Renderer::bindTilesetTextures(const MapManager& mapManager) {
+    // Acquire the new map's tilesets before releasing the old ones, so shared tilesets stay loaded.
+    // Textures are also resolved here rather than while baking, where placeholder generation would switch targets.
+    std::unordered_map<const TilesetInfo*, TextureHandle> tilesetTextures;
+    for (const auto& [firstGid, tilesetInfo] : mapManager.getTilesets()) {
+        tilesetTextures[&tilesetInfo] = acquireTexture(tilesetInfo.imagePath);
+    }
+    for (const auto& [tilesetInfo, handle] : m_tilesetTextures) {
+        releaseTexture(handle);
+    }
+    m_tilesetTextures = std::move(tilesetTextures);
+}
+
+Renderer::MapChunkLayer& Renderer::getChunkLayer(const MapManager& mapManager, MapLayer layer) {
+    if (m_chunkMap != &mapManager) {
+        invalidateMapCache();
+        m_chunkMap = &mapManager;
+        bindTilesetTextures(mapManager);
+        // Chunks are aligned to whole tiles so every tile lands in exactly one chunk
+        m_chunkTilesX = std::max(1u, static_cast<unsigned>(MAP_CHUNK_SIZE) / mapManager.getTileWidth());
+        m_chunkTilesY = std::max(1u, static_cast<unsigned>(MAP_CHUNK_SIZE) / mapManager.getTileHeight());
+        m_chunksX = (mapManager.getMapWidthTiles() + m_chunkTilesX - 1) / m_chunkTilesX;
+        m_chunksY = (mapManager.getMapHeightTiles() + m_chunkTilesY - 1) / m_chunkTilesY;
+    }
+
+    auto it = m_mapChunks.find(layer);
+    if (it != m_mapChunks.end()) return it->second;
+
+    MapChunkLayer& chunkLayer = m_mapChunks[layer];
+    const auto& tmxLayers = mapManager.getRawLayers();
+    for (size_t layerIndex = 0; layerIndex < tmxLayers.size(); ++layerIndex) {
+        if (tmxLayers[layerIndex]->getType() == tmx::Layer::Type::Tile && isLayerDrawnAs(tmxLayers[layerIndex]->getName(), layer)) {
+            chunkLayer.layerIndices.push_back(layerIndex);
+        }
+    }
+    chunkLayer.chunks.resize(static_cast<size_t>(m_chunksX) * m_chunksY);
+    return chunkLayer;
+}
+
+uint32_t Renderer::getTileGid(size_t layerIndex, unsigned tileX, unsigned tileY) const {
+    if (layerIndex >= m_tileGids.size() || !m_tileGidsMap || tileX >= m_tileGidsMap->getMapWidthTiles()) return 0;
+    const auto& gids = m_tileGids[layerIndex];
+    size_t index = static_cast<size_t>(tileY) * m_tileGidsMap->getMapWidthTiles() + tileX;
+    return index < gids.size() ? gids[index] : 0;
+}
+
+void Renderer::bindTileGids(const MapManager& mapManager) {
+    // Replayed snapshots have already provided the GIDs; this covers drawing without recording
+    if (m_tileGidsMap == &mapManager) return;
+    m_tileGids = mapManager.getTileGidLayers();
+    m_tileGidsMap = &mapManager;
+}
+
+void Renderer::applyTileEdits(const std::vector<TileEdit>& edits) {
+    if (!edits.empty()) m_minimapDirty = true;
+    for (const TileEdit& edit : edits) {
+        if (edit.layer >= m_tileGids.size() || !m_tileGidsMap) continue;
+        auto& gids = m_tileGids[edit.layer];
+        size_t index = static_cast<size_t>(edit.tileY) * m_tileGidsMap->getMapWidthTiles() + edit.tileX;
+        if (index < gids.size()) gids[index] = edit.gid;
+
+        // Re-bake the chunks the edit touches
+        if (m_chunkTilesX == 0 || m_chunkTilesY == 0) continue;
+        unsigned chunkX = edit.tileX / m_chunkTilesX;
+        unsigned chunkY = edit.tileY / m_chunkTilesY;
+        if (chunkX >= m_chunksX || chunkY >= m_chunksY) continue;
+        for (auto& [layer, chunkLayer] : m_mapChunks) {
+            if (std::find(chunkLayer.layerIndices.begin(), chunkLayer.layerIndices.end(), edit.layer) != chunkLayer.layerIndices.end()) {
+                chunkLayer.chunks[chunkX + chunkY * m_chunksX].dirty = true;
+            }
+        }
+    }
+}
+
+void Renderer::recordMapState(RenderSnapshot& snapshot, const MapManager& mapManager, bool reset) {
+    // The render thread never reads MapManager's tile GIDs, which change under it; it gets a full
+    // copy when the map changes and the edit list after that
+    if (snapshot.mapCaptured && snapshot.map == &mapManager && !reset) return;
+    const auto& edits = mapManager.getTileEdits();
+    if (reset || m_recordedMap != &mapManager || m_recordedEditCursor > edits.size()) {
+        snapshot.mapReset = true;
+        snapshot.mapTileGids = mapManager.getTileGidLayers();
+        snapshot.tileEdits.clear(); // Already part of the copy
+        m_recordedMap = &mapManager;
+    } else {
+        snapshot.tileEdits.insert(snapshot.tileEdits.end(), edits.begin() + static_cast<std::ptrdiff_t>(m_recordedEditCursor), edits.end());
+    }
+    m_recordedEditCursor = edits.size();
+    snapshot.map = &mapManager;
+    snapshot.mapCaptured = true;
+}
+
+bool Renderer::bakeChunk(const MapManager& mapManager, const MapChunkLayer& chunkLayer, unsigned chunkX, unsigned chunkY, MapChunk& chunk) {
+    unsigned x0 = chunkX * m_chunkTilesX;
+    unsigned y0 = chunkY * m_chunkTilesY;
+    unsigned x1 = x0 + m_chunkTilesX;
+    unsigned y1 = y0 + m_chunkTilesY;
+    chunk.dirty = false;
+
+    bool hasTiles = false;
+    for (size_t layerIndex : chunkLayer.layerIndices) {
+        for (unsigned y = y0; y < std::min(y1, mapManager.getMapHeightTiles()) && !hasTiles; ++y) {
+            for (unsigned x = x0; x < std::min(x1, mapManager.getMapWidthTiles()) && !hasTiles; ++x) {
+                hasTiles = getTileGid(layerIndex, x, y) != 0;
+            }
+        }
+    }
+    if (!hasTiles) {
+        if (chunk.texture) {
+            SDL_DestroyTexture(chunk.texture);
+            chunk.texture = nullptr;
+        }
+        return true;
+    }
+
+    int chunkWidth = static_cast<int>(m_chunkTilesX * mapManager.getTileWidth());
+    int chunkHeight = static_cast<int>(m_chunkTilesY * mapManager.getTileHeight());
+    if (!chunk.texture) {
+        chunk.texture = SDL_CreateTexture(m_sdlRenderer, SDL_PIXELFORMAT_RGBA8888, SDL_TEXTUREACCESS_TARGET, chunkWidth, chunkHeight);
+        if (!chunk.texture) {
+            Log::Warning("Failed to create map chunk texture, drawing tiles directly: " + std::string(SDL_GetError()));
+            return false;
+        }
+        if (SDL_SetTextureBlendMode(chunk.texture, getPremultipliedBlendMode()) != 0) {
+            // Plain BLEND would apply the tiles' alpha a second time at the chunk edges
+            Log::Warning("Premultiplied alpha not supported, drawing tiles directly: " + std::string(SDL_GetError()));
+            SDL_DestroyTexture(chunk.texture);
+            chunk.texture = nullptr;
+            return false;
+        }
+    }
+
+    m_spriteBatch.flush();
+    SDL_Texture* previousTarget = SDL_GetRenderTarget(m_sdlRenderer);
+    Uint8 oldR, oldG, oldB, oldA;
+    SDL_GetRenderDrawColor(m_sdlRenderer, &oldR, &oldG, &oldB, &oldA);
+    const Camera* savedCamera = m_camera;
+    m_camera = nullptr; // Chunk space
+
+    SDL_SetRenderTarget(m_sdlRenderer, chunk.texture);
+    SDL_SetRenderDrawColor(m_sdlRenderer, 0, 0, 0, 0);
+    SDL_RenderClear(m_sdlRenderer);
+    float offsetX = -static_cast<float>(x0 * mapManager.getTileWidth());
+    float offsetY = -static_cast<float>(y0 * mapManager.getTileHeight());
+    m_blendModeOverride = getChunkBakeBlendMode();
+    for (size_t layerIndex : chunkLayer.layerIndices) {
+        drawTiles(mapManager, layerIndex, x0, y0, x1, y1, offsetX, offsetY);
+    }
+
+    m_camera = savedCamera;
+    m_spriteBatch.flush();
+    m_blendModeOverride = SDL_BLENDMODE_INVALID;
+    SDL_SetRenderTarget(m_sdlRenderer, previousTarget);
+    SDL_SetRenderDrawColor(m_sdlRenderer, oldR, oldG, oldB, oldA);
+    return true;
+}
+
+void Renderer::prebakeMap(const MapManager& mapManager) {
+    if (!m_isInitialized || !m_sdlRenderer || !mapManager.isMapLoaded()) return;
+    if (mapManager.getTileWidth() == 0 || mapManager.getTileHeight() == 0) return;
+    if (RenderSnapshot* snapshot = recordingSnapshot()) {
+        recordMapState(*snapshot, mapManager, true); // A new map may reuse the old map's address
+        RenderLayer previousLayer = snapshot->activeLayer;
+        snapshot->activeLayer = RenderLayer::MapBackground; // Before any map draw
+        recordCommand(*snapshot, RenderCommandType::PrebakeMap, 0.0f);
+        snapshot->activeLayer = previousLayer;
+        return;
+    }
+    bindTileGids(mapManager);
+
+    invalidateMapCache(); // A new map may reuse the old map's address
+    size_t chunkTextures = 0;
+    for (MapLayer layer : {MapLayer::Background, MapLayer::Foreground, MapLayer::Objects}) {
+        MapChunkLayer& chunkLayer = getChunkLayer(mapManager, layer);
+        for (unsigned chunkY = 0; chunkY < m_chunksY && !m_chunkBakingFailed; ++chunkY) {
+            for (unsigned chunkX = 0; chunkX < m_chunksX && !m_chunkBakingFailed; ++chunkX) {
+                MapChunk& chunk = chunkLayer.chunks[chunkX + chunkY * m_chunksX];
+                m_chunkBakingFailed = !bakeChunk(mapManager, chunkLayer, chunkX, chunkY, chunk);
+                if (chunk.texture) ++chunkTextures;
+            }
+        }
+    }
+    Log::Info("Baked " + std::to_string(chunkTextures) + " map chunk textures (" + std::to_string(m_chunksX) + "x" +
+              std::to_string(m_chunksY) + " chunks per layer).");
+}
+
 void Renderer::renderMap(const MapManager& mapManager, MapLayer layer) {
     if (!m_isInitialized || !m_sdlRenderer || !mapManager.isMapLoaded()) return;
 
     // Get map properties
     unsigned tileWidth = mapManager.getTileWidth();
     unsigned tileHeight = mapManager.getTileHeight();
+    if (tileWidth == 0 || tileHeight == 0) return;
+
+    if (RenderSnapshot* snapshot = recordingSnapshot()) {
+        recordMapState(*snapshot, mapManager, false);
+        // Map layers have their own draw layers, whatever layer is active
+        RenderLayer previousLayer = snapshot->activeLayer;
+        snapshot->activeLayer = layer == MapLayer::Foreground ? RenderLayer::MapForeground :
+                                layer == MapLayer::Background ? RenderLayer::MapBackground : RenderLayer::World;
+        RenderCommand& command = recordCommand(*snapshot, RenderCommandType::Map, 0.0f);
+        command.mapLayer = layer;
+        snapshot->activeLayer = previousLayer;
+        return;
+    }
+    bindTileGids(mapManager);
 
-    // Iterate through all layers in the TMX map
-    const auto& tmxLayers = mapManager.getRawLayers();
-    for (const auto& tmxLayer : tmxLayers) {
-        if (tmxLayer->getType() == tmx::Layer::Type::Tile) {
-            const auto& tileLayer = tmxLayer->getLayerAs<tmx::TileLayer>();
-
-            // Determine if this layer should be rendered based on the MapLayer enum
-            // This is a simplified check; a more robust system might use layer properties from Tiled
-            bool renderThisLayer = false;
-            if (layer == MapLayer::Background && tmxLayer->getName().find("background") != std::string::npos) {
-                renderThisLayer = true;
-            } else if (layer == MapLayer::Foreground && tmxLayer->getName().find("foreground") != std::string::npos) {
-                renderThisLayer = true;
-            } else if (layer == MapLayer::Objects && tmxLayer->getName().find("object") != std::string::npos) {
-                // Object layers are typically handled by EntityManager, but if they contain tiles, render them
-                renderThisLayer = true;
-            }
-            // If no specific layer type is requested, render all tile layers
-            if (layer == MapLayer::Background && tmxLayer->getName().find("background") == std::string::npos && tmxLayer->getName().find("foreground") == std::string::npos && tmxLayer->getName().find("object") == std::string::npos) {
-                renderThisLayer = true;
+    MapChunkLayer& chunkLayer = getChunkLayer(mapManager, layer);
+    if (chunkLayer.layerIndices.empty()) return;
+
+    // Only the tile range under the visible world rect is drawn
+    SDL_FRect view = getVisibleWorldRect();
+    unsigned firstX = static_cast<unsigned>(std::max(0.0f, std::floor(view.x / tileWidth)));
+    unsigned firstY = static_cast<unsigned>(std::max(0.0f, std::floor(view.y / tileHeight)));
+    unsigned lastX = static_cast<unsigned>(std::max(0.0f, std::ceil((view.x + view.w) / tileWidth)));
+    unsigned lastY = static_cast<unsigned>(std::max(0.0f, std::ceil((view.y + view.h) / tileHeight)));
+
+    if (m_chunkBakingFailed) {
+        for (size_t layerIndex : chunkLayer.layerIndices) {
+            drawTiles(mapManager, layerIndex, firstX, firstY, lastX, lastY, 0.0f, 0.0f);
+        }
+        return;
+    }
+
+    unsigned chunkWidth = m_chunkTilesX * tileWidth;
+    unsigned chunkHeight = m_chunkTilesY * tileHeight;
+    unsigned endChunkX = std::min(m_chunksX, (lastX + m_chunkTilesX - 1) / m_chunkTilesX);
+    unsigned endChunkY = std::min(m_chunksY, (lastY + m_chunkTilesY - 1) / m_chunkTilesY);
+    for (unsigned chunkY = firstY / m_chunkTilesY; chunkY < endChunkY; ++chunkY) {
+        for (unsigned chunkX = firstX / m_chunkTilesX; chunkX < endChunkX; ++chunkX) {
+            MapChunk& chunk = chunkLayer.chunks[chunkX + chunkY * m_chunksX];
+            if (chunk.dirty && !bakeChunk(mapManager, chunkLayer, chunkX, chunkY, chunk)) {
+                m_chunkBakingFailed = true;
+                renderMap(mapManager, layer); // Falls back to drawing tiles
+                return;
             }
+            if (!chunk.texture) continue;
+
+            SDL_FRect dstRect = {
+                static_cast<float>(chunkX * chunkWidth),
+                static_cast<float>(chunkY * chunkHeight),
+                static_cast<float>(chunkWidth),
+                static_cast<float>(chunkHeight)
+            };
+            drawTexture(chunk.texture, nullptr, &dstRect);
+        }
+    }
+}
+
+void Renderer::renderMinimap(const MapManager& mapManager, const SDL_FRect& screenRect, const PointSprite* markers, size_t markerCount) {
+    if (!m_isInitialized || !m_sdlRenderer || !mapManager.isMapLoaded()) return;
+    if (RenderSnapshot* snapshot = recordingSnapshot()) {
+        recordMapState(*snapshot, mapManager, false);
+        RenderCommand& command = recordCommand(*snapshot, RenderCommandType::Minimap, 0.0f);
+        command.dstRect = screenRect;
+        command.first = static_cast<uint32_t>(snapshot->pointSprites.size());
+        command.count = static_cast<uint32_t>(markerCount);
+        snapshot->pointSprites.insert(snapshot->pointSprites.end(), markers, markers + markerCount);
+        return;
+    }
+
+    float mapWidth = static_cast<float>(mapManager.getMapWidthPixels());
+    float mapHeight = static_cast<float>(mapManager.getMapHeightPixels());
+    if (mapWidth <= 0.0f || mapHeight <= 0.0f) return;
+    if (m_minimapMap != &mapManager ||
+        (m_minimapDirty && SDL_GetTicks() - m_minimapBakeTicks >= MINIMAP_REBAKE_INTERVAL_MS)) {
+        bindTileGids(mapManager);
+        bakeMinimap(mapManager);
+    }
+    if (!m_minimapTexture) return;
+
+    float scale = std::min(screenRect.w / mapWidth, screenRect.h / mapHeight);
+    SDL_FRect dstRect = {screenRect.x, screenRect.y, mapWidth * scale, mapHeight * scale};
+    m_spriteBatch.fillRect(dstRect, {0, 0, 0, 160});
+    m_spriteBatch.drawTexture(m_minimapTexture, nullptr, dstRect);
+
+    m_minimapMarkers.clear();
+    for (size_t i = 0; i < markerCount; ++i) {
+        PointSprite marker = markers[i];
+        marker.x = dstRect.x + marker.x * scale;
+        marker.y = dstRect.y + marker.y * scale;
+        m_minimapMarkers.push_back(marker);
+    }
+    if (SDL_Texture* circle = getSoftCircleTexture()) {
+        m_spriteBatch.drawPointSprites(circle, m_minimapMarkers.data(), m_minimapMarkers.size());
+    }
+}
 
+void Renderer::bakeMinimap(const MapManager& mapManager) {
+    if (m_minimapTexture) SDL_DestroyTexture(m_minimapTexture);
+    m_minimapTexture = nullptr;
+    m_minimapMap = &mapManager;
+    m_minimapDirty = false;
+    m_minimapBakeTicks = SDL_GetTicks();
+
+    // Downsampled from the chunk textures, so the tiles are not drawn a second time
+    float mapWidth = static_cast<float>(mapManager.getMapWidthPixels());
+    float mapHeight = static_cast<float>(mapManager.getMapHeightPixels());
+    float scale = std::min(1.0f, static_cast<float>(MINIMAP_MAX_SIZE) / std::max(mapWidth, mapHeight));
+    int width = std::max(1, static_cast<int>(std::lround(mapWidth * scale)));
+    int height = std::max(1, static_cast<int>(std::lround(mapHeight * scale)));
+    std::vector<MapChunkLayer*> chunkLayers;
+    for (MapLayer layer : {MapLayer::Background, MapLayer::Foreground}) {
+        chunkLayers.push_back(&getChunkLayer(mapManager, layer));
+    }
+    if (m_chunkBakingFailed) return; // No chunk textures to downsample: no minimap
+
+    m_minimapTexture = SDL_CreateTexture(m_sdlRenderer, SDL_PIXELFORMAT_RGBA8888, SDL_TEXTUREACCESS_TARGET, width, height);
+    if (!m_minimapTexture) {
+        Log::Warning("Failed to create minimap texture: " + std::string(SDL_GetError()));
+        return;
+    }
+    SDL_SetTextureBlendMode(m_minimapTexture, getPremultipliedBlendMode()); // Downsampled premultiplied chunks
 
-            if (renderThisLayer) {
-                const auto& tiles = tileLayer.getTiles();
-                for (unsigned int y = 0; y < tileLayer.getSize().y; ++y) {
-                    for (unsigned int x = 0; x < tileLayer.getSize().x; ++x) {
-                        unsigned int tileIndex = x + y * tileLayer.getSize().x;
-                        if (tileIndex < tiles.size()) {
-                            const auto& tile = tiles[tileIndex];
-                            if (tile.ID > 0) { // ID 0 means empty tile
-                                const TilesetInfo* tilesetInfo = mapManager.findTilesetForGid(tile.ID);
-                                if (tilesetInfo) {
-                                    SDL_Texture* tilesetTexture = loadTexture(tilesetInfo->imagePath);
-                                    if (tilesetTexture) {
-                                        SDL_Rect srcRect = mapManager.getSourceRectForGid(tile.ID, *tilesetInfo);
-                                        SDL_FRect dstRect = {
-                                            static_cast<float>(x * tileWidth),
-                                            static_cast<float>(y * tileHeight),
-                                            static_cast<float>(tileWidth),
-                                            static_cast<float>(tileHeight)
-                                        };
-
-                                        // Apply tile flipping if necessary (Tiled supports horizontal, vertical, diagonal flip)
-                                        SDL_RendererFlip flip = SDL_FLIP_NONE;
-                                        if (tile.flipFlags & tmx::TileLayer::FlipFlag::Horizontal) flip = static_cast<SDL_RendererFlip>(flip | SDL_FLIP_HORIZONTAL);
-                                        if (tile.flipFlags & tmx::TileLayer::FlipFlag::Vertical) flip = static_cast<SDL_RendererFlip>(flip | SDL_FLIP_VERTICAL);
-                                        // Diagonal flip is more complex and might require rotation + flip, or custom shader
-
-                                        drawTexture(tilesetTexture, &srcRect, &dstRect, 0.0, nullptr, flip);
-                                    }
-                                }
-                            }
-                        }
-                    }
+    m_spriteBatch.flush();
+    SDL_Texture* previousTarget = SDL_GetRenderTarget(m_sdlRenderer);
+    Uint8 oldR, oldG, oldB, oldA;
+    SDL_GetRenderDrawColor(m_sdlRenderer, &oldR, &oldG, &oldB, &oldA);
+    SDL_SetRenderTarget(m_sdlRenderer, m_minimapTexture);
+    SDL_SetRenderDrawColor(m_sdlRenderer, 0, 0, 0, 0);
+    SDL_RenderClear(m_sdlRenderer);
+
+    float chunkWidth = static_cast<float>(m_chunkTilesX * mapManager.getTileWidth()) * scale;
+    float chunkHeight = static_cast<float>(m_chunkTilesY * mapManager.getTileHeight()) * scale;
+    for (MapChunkLayer* chunkLayer : chunkLayers) {
+        for (unsigned chunkY = 0; chunkY < m_chunksY; ++chunkY) {
+            for (unsigned chunkX = 0; chunkX < m_chunksX; ++chunkX) {
+                MapChunk& chunk = chunkLayer->chunks[chunkX + chunkY * m_chunksX];
+                if (chunk.dirty) {
+                    // bakeChunk restores this target when it is done
+                    m_chunkBakingFailed = !bakeChunk(mapManager, *chunkLayer, chunkX, chunkY, chunk);
+                    if (m_chunkBakingFailed) break;
                 }
+                if (!chunk.texture) continue;
+                SDL_FRect dstRect = {chunkX * chunkWidth, chunkY * chunkHeight, chunkWidth, chunkHeight};
+                m_spriteBatch.drawTexture(chunk.texture, nullptr, dstRect);
+            }
+        }
+    }
+
+    m_spriteBatch.flush();
+    SDL_SetRenderTarget(m_sdlRenderer, previousTarget);
+    SDL_SetRenderDrawColor(m_sdlRenderer, oldR, oldG, oldB, oldA);
+}
+
+void Renderer::renderFogMask(const uint8_t* mask, int width, int height, uint32_t revision, const SDL_FRect& worldRect) {
+    if (revision == 0) return;
+    if (RenderSnapshot* snapshot = recordingSnapshot()) {
+        RenderLayer previousLayer = snapshot->activeLayer;
+        snapshot->activeLayer = RenderLayer::MapForeground; // Over entities and the foreground recorded before it
+        RenderCommand& command = recordCommand(*snapshot, RenderCommandType::FogMask, 0.0f);
+        command.dstRect = worldRect;
+        command.first = revision;
+        snapshot->activeLayer = previousLayer;
+        if (revision != m_recordedFogRevision && mask) {
+            snapshot->fogMask.assign(mask, mask + static_cast<size_t>(width) * height);
+            snapshot->fogWidth = width;
+            snapshot->fogHeight = height;
+            m_recordedFogRevision = revision;
+        }
+        return;
+    }
+    if (!m_sdlRenderer) return;
+
+    if (revision != m_fogTextureRevision && mask) {
+        uploadFogMask(mask, width, height);
+        m_fogTextureRevision = revision;
+    }
+    if (m_fogTexture) drawTexture(m_fogTexture, nullptr, &worldRect);
+}
+
+void Renderer::uploadFogMask(const uint8_t* mask, int width, int height) {
+    if (width <= 0 || height <= 0) return;
+    if (!m_fogTexture || m_fogTextureWidth != width || m_fogTextureHeight != height) {
+        if (m_fogTexture) SDL_DestroyTexture(m_fogTexture);
+        m_fogTexture = SDL_CreateTexture(m_sdlRenderer, SDL_PIXELFORMAT_RGBA8888, SDL_TEXTUREACCESS_STREAMING, width, height);
+        if (!m_fogTexture) {
+            Log::Warning("Failed to create fog of war texture: " + std::string(SDL_GetError()));
+            return;
+        }
+        SDL_SetTextureBlendMode(m_fogTexture, SDL_BLENDMODE_BLEND);
+        SDL_SetTextureScaleMode(m_fogTexture, SDL_ScaleModeLinear); // Soft edges between tiles
+        m_fogTextureWidth = width;
+        m_fogTextureHeight = height;
+    }
+
+    // RGBA8888: hidden tiles are opaque fog, visible ones transparent
+    const uint32_t hidden = (8u << 24) | (8u << 16) | (14u << 8) | 255u;
+    m_fogPixels.resize(static_cast<size_t>(width) * height);
+    for (size_t i = 0; i < m_fogPixels.size(); ++i) {
+        m_fogPixels[i] = mask[i] ? 0u : hidden;
+    }
+    SDL_UpdateTexture(m_fogTexture, nullptr, m_fogPixels.data(), width * static_cast<int>(sizeof(uint32_t)));
+}
+
+namespace {
+uint64_t makeDecalChunkKey(int chunkX, int chunkY) {
+    return (static_cast<uint64_t>(static_cast<uint32_t>(chunkX)) << 32) | static_cast<uint32_t>(chunkY);
+}
+}
+
+void Renderer::addDecals(const PointSprite* decals, size_t count) {
+    if (count == 0) return;
+    if (RenderSnapshot* snapshot = recordingSnapshot()) {
+        snapshot->decals.insert(snapshot->decals.end(), decals, decals + count);
+        return;
+    }
+    bakeDecals(std::vector<PointSprite>(decals, decals + count));
+}
+
+void Renderer::renderDecals() {
+    if (RenderSnapshot* snapshot = recordingSnapshot()) {
+        RenderLayer previousLayer = snapshot->activeLayer;
+        snapshot->activeLayer = RenderLayer::MapBackground; // Recorded right after the background: drawn over it
+        recordCommand(*snapshot, RenderCommandType::Decals, 0.0f);
+        snapshot->activeLayer = previousLayer;
+        return;
+    }
+    if (!m_sdlRenderer || m_decalChunks.empty()) return;
+
+    SDL_FRect view = getVisibleWorldRect();
+    for (auto& [key, chunk] : m_decalChunks) {
+        SDL_FRect dstRect = {
+            static_cast<float>(static_cast<int32_t>(key >> 32)) * DECAL_CHUNK_SIZE,
+            static_cast<float>(static_cast<int32_t>(key & 0xFFFFFFFFu)) * DECAL_CHUNK_SIZE,
+            static_cast<float>(DECAL_CHUNK_SIZE),
+            static_cast<float>(DECAL_CHUNK_SIZE)
+        };
+        if (dstRect.x + dstRect.w < view.x || dstRect.x > view.x + view.w ||
+            dstRect.y + dstRect.h < view.y || dstRect.y > view.y + view.h) continue;
+
+        double idle = m_decalTime - chunk.lastStampTime - DECAL_FADE_DELAY;
+        Uint8 alpha = idle <= 0.0 ? 255 : static_cast<Uint8>(255.0 * std::max(0.0, 1.0 - idle / DECAL_FADE_TIME));
+        SDL_FRect screenRect = m_camera ? m_camera->worldToScreen(dstRect) : dstRect;
+        // Premultiplied, so the fade scales the color as well
+        m_spriteBatch.drawTexture(chunk.texture, nullptr, screenRect, 0.0, nullptr, SDL_FLIP_NONE, {alpha, alpha, alpha, alpha});
+    }
+}
+
+void Renderer::clearDecals() {
+    for (auto& [key, chunk] : m_decalChunks) {
+        if (chunk.texture) SDL_DestroyTexture(chunk.texture);
+    }
+    m_decalChunks.clear();
+    m_decalsFailed = false;
+}
+
+void Renderer::expireDecalChunks() {
+    for (auto it = m_decalChunks.begin(); it != m_decalChunks.end();) {
+        if (m_decalTime - it->second.lastStampTime >= DECAL_FADE_DELAY + DECAL_FADE_TIME) {
+            SDL_DestroyTexture(it->second.texture);
+            it = m_decalChunks.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
+
+void Renderer::bakeDecals(const std::vector<PointSprite>& decals) {
+    if (decals.empty() || m_decalsFailed || !m_sdlRenderer) return;
+    SDL_Texture* circle = getSoftCircleTexture();
+    if (!circle) return;
+
+    // Chunks touched by this frame's decals (a decal on a chunk edge touches up to four)
+    std::vector<uint64_t> touched;
+    for (const PointSprite& decal : decals) {
+        int firstX = static_cast<int>(std::floor((decal.x - decal.radius) / DECAL_CHUNK_SIZE));
+        int firstY = static_cast<int>(std::floor((decal.y - decal.radius) / DECAL_CHUNK_SIZE));
+        int lastX = static_cast<int>(std::floor((decal.x + decal.radius) / DECAL_CHUNK_SIZE));
+        int lastY = static_cast<int>(std::floor((decal.y + decal.radius) / DECAL_CHUNK_SIZE));
+        for (int chunkY = firstY; chunkY <= lastY; ++chunkY) {
+            for (int chunkX = firstX; chunkX <= lastX; ++chunkX) {
+                uint64_t key = makeDecalChunkKey(chunkX, chunkY);
+                if (std::find(touched.begin(), touched.end(), key) == touched.end()) touched.push_back(key);
             }
         }
     }
+
+    m_spriteBatch.flush();
+    SDL_Texture* previousTarget = SDL_GetRenderTarget(m_sdlRenderer);
+    Uint8 oldR, oldG, oldB, oldA;
+    SDL_GetRenderDrawColor(m_sdlRenderer, &oldR, &oldG, &oldB, &oldA);
+    for (uint64_t key : touched) {
+        auto it = m_decalChunks.find(key);
+        if (it == m_decalChunks.end()) {
+            if (m_decalChunks.size() >= MAX_DECAL_CHUNKS) {
+                auto oldest = std::min_element(m_decalChunks.begin(), m_decalChunks.end(), [](const auto& a, const auto& b) {
+                    return a.second.lastStampTime < b.second.lastStampTime;
+                });
+                SDL_DestroyTexture(oldest->second.texture);
+                m_decalChunks.erase(oldest);
+            }
+            DecalChunk chunk;
+            chunk.texture = SDL_CreateTexture(m_sdlRenderer, SDL_PIXELFORMAT_RGBA8888, SDL_TEXTUREACCESS_TARGET, DECAL_CHUNK_SIZE, DECAL_CHUNK_SIZE);
+            if (!chunk.texture) {
+                Log::Warning("Failed to create decal chunk texture, decals disabled: " + std::string(SDL_GetError()));
+                m_decalsFailed = true;
+                break;
+            }
+            if (SDL_SetTextureBlendMode(chunk.texture, getPremultipliedBlendMode()) != 0) {
+                // Stamped like the map chunks, see getChunkBakeBlendMode()
+                Log::Warning("Premultiplied alpha not supported, decals disabled: " + std::string(SDL_GetError()));
+                SDL_DestroyTexture(chunk.texture);
+                m_decalsFailed = true;
+                break;
+            }
+            SDL_SetRenderTarget(m_sdlRenderer, chunk.texture);
+            SDL_SetRenderDrawColor(m_sdlRenderer, 0, 0, 0, 0);
+            SDL_RenderClear(m_sdlRenderer);
+            it = m_decalChunks.emplace(key, chunk).first;
+        } else {
+            SDL_SetRenderTarget(m_sdlRenderer, it->second.texture);
+        }
+        it->second.lastStampTime = m_decalTime;
+
+        // All of the frame's decals, in chunk space; the ones outside are clipped by the target
+        SDL_FPoint origin = {
+            static_cast<float>(static_cast<int32_t>(key >> 32)) * DECAL_CHUNK_SIZE,
+            static_cast<float>(static_cast<int32_t>(key & 0xFFFFFFFFu)) * DECAL_CHUNK_SIZE
+        };
+        m_spriteBatch.drawPointSprites(circle, decals.data(), decals.size(), origin, 1.0f, getChunkBakeBlendMode());
+        m_spriteBatch.flush();
+    }
+    SDL_SetTextureBlendMode(circle, SDL_BLENDMODE_BLEND); // Particles and minimap markers draw it with its own mode
+    SDL_SetRenderTarget(m_sdlRenderer, previousTarget);
+    SDL_SetRenderDrawColor(m_sdlRenderer, oldR, oldG, oldB, oldA);
 }
 
 GLuint Renderer::getOpenGLTextureID(SDL_Texture* texture) {
@@ -0,0 +1,231 @@
+// src/SpriteBatch.cpp
+#include "TuxArena/SpriteBatch.h"
+#include "TuxArena/Log.h"
+
+#include <algorithm> // For std::clamp, std::min
+#include <cmath>     // For std::sin, std::cos, std::sqrt
+#include <string>
+
+namespace TuxArena {
+
+void SpriteBatch::setTexture(SDL_Texture* texture, SDL_BlendMode blendMode) {
+    if (texture == m_texture && blendMode == m_blendMode) return;
+    flush();
+    m_blendMode = blendMode;
+    if (texture == m_texture) return;
+    m_texture = texture;
+    m_textureWidth = 1.0f;
+    m_textureHeight = 1.0f;
+    if (texture) {
+        int width = 0, height = 0;
+        if (SDL_QueryTexture(texture, nullptr, nullptr, &width, &height) == 0 && width > 0 && height > 0) {
+            m_textureWidth = static_cast<float>(width);
+            m_textureHeight = static_cast<float>(height);
+        }
+    }
+}
+
+void SpriteBatch::reserve(size_t vertexCount) {
+    if (m_vertices.size() + vertexCount > MAX_BATCH_VERTICES) {
+        flush();
+    }
+}
+
+void SpriteBatch::pushQuad(const SDL_FPoint corners[4], const SDL_FPoint uvs[4], SDL_Color color) {
+    reserve(4);
+    int base = static_cast<int>(m_vertices.size());
+    for (int i = 0; i < 4; ++i) {
+        m_vertices.push_back({corners[i], color, uvs[i]});
+    }
+    m_indices.insert(m_indices.end(), {base, base + 1, base + 2, base, base + 2, base + 3});
+}
+
+int SpriteBatch::circleSegments(float radius) {
+    // Enough segments that edges stay under a couple of pixels, few enough for particles to stay cheap
+    return std::clamp(static_cast<int>(radius * 0.5f) + 8, 8, 64);
+}
+
+void SpriteBatch::drawTexture(SDL_Texture* texture, const SDL_Rect* srcRect, const SDL_FRect& dstRect,
+                              double angle, const SDL_FPoint* center, SDL_RendererFlip flip, SDL_Color tint,
+                              SDL_BlendMode blendMode) {
+    if (!texture) return;
+    setTexture(texture, blendMode);
+
+    SDL_FRect src = srcRect ? SDL_FRect{static_cast<float>(srcRect->x), static_cast<float>(srcRect->y),
+                                        static_cast<float>(srcRect->w), static_cast<float>(srcRect->h)}
+                            : SDL_FRect{0.0f, 0.0f, m_textureWidth, m_textureHeight};
+    float u0 = src.x / m_textureWidth;
+    float v0 = src.y / m_textureHeight;
+    float u1 = (src.x + src.w) / m_textureWidth;
+    float v1 = (src.y + src.h) / m_textureHeight;
+    if (flip & SDL_FLIP_HORIZONTAL) std::swap(u0, u1);
+    if (flip & SDL_FLIP_VERTICAL) std::swap(v0, v1);
+    SDL_FPoint uvs[4] = {{u0, v0}, {u1, v0}, {u1, v1}, {u0, v1}};
+
+    SDL_FPoint corners[4] = {
+        {dstRect.x, dstRect.y},
+        {dstRect.x + dstRect.w, dstRect.y},
+        {dstRect.x + dstRect.w, dstRect.y + dstRect.h},
+        {dstRect.x, dstRect.y + dstRect.h}
+    };
+    if (angle != 0.0) {
+        // Same convention as SDL_RenderCopyEx: degrees clockwise around center (relative to dstRect, default middle)
+        float pivotX = dstRect.x + (center ? center->x : dstRect.w * 0.5f);
+        float pivotY = dstRect.y + (center ? center->y : dstRect.h * 0.5f);
+        float radians = static_cast<float>(angle * M_PI / 180.0);
+        float c = std::cos(radians);
+        float s = std::sin(radians);
+        for (SDL_FPoint& corner : corners) {
+            float dx = corner.x - pivotX;
+            float dy = corner.y - pivotY;
+            corner = {pivotX + dx * c - dy * s, pivotY + dx * s + dy * c};
+        }
+    }
+    pushQuad(corners, uvs, tint);
+}
+
+void SpriteBatch::fillRect(const SDL_FRect& rect, SDL_Color color) {
+    setTexture(nullptr);
+    SDL_FPoint corners[4] = {
+        {rect.x, rect.y},
+        {rect.x + rect.w, rect.y},
+        {rect.x + rect.w, rect.y + rect.h},
+        {rect.x, rect.y + rect.h}
+    };
+    SDL_FPoint uvs[4] = {};
+    pushQuad(corners, uvs, color);
+}
+
+void SpriteBatch::drawRect(const SDL_FRect& rect, SDL_Color color) {
+    if (rect.w <= 0.0f || rect.h <= 0.0f) return;
+    fillRect({rect.x, rect.y, rect.w, 1.0f}, color);
+    if (rect.h > 1.0f) fillRect({rect.x, rect.y + rect.h - 1.0f, rect.w, 1.0f}, color);
+    if (rect.h > 2.0f) {
+        fillRect({rect.x, rect.y + 1.0f, 1.0f, rect.h - 2.0f}, color);
+        if (rect.w > 1.0f) fillRect({rect.x + rect.w - 1.0f, rect.y + 1.0f, 1.0f, rect.h - 2.0f}, color);
+    }
+}
+
+void SpriteBatch::drawLine(float x1, float y1, float x2, float y2, SDL_Color color) {
+    float dx = x2 - x1;
+    float dy = y2 - y1;
+    float length = std::sqrt(dx * dx + dy * dy);
+    if (length < 1e-4f) {
+        fillRect({x1 - 0.5f, y1 - 0.5f, 1.0f, 1.0f}, color);
+        return;
+    }
+
+    setTexture(nullptr);
+    // Half a pixel to each side of the line
+    float nx = -dy / length * 0.5f;
+    float ny = dx / length * 0.5f;
+    SDL_FPoint corners[4] = {
+        {x1 + nx, y1 + ny},
+        {x2 + nx, y2 + ny},
+        {x2 - nx, y2 - ny},
+        {x1 - nx, y1 - ny}
+    };
+    SDL_FPoint uvs[4] = {};
+    pushQuad(corners, uvs, color);
+}
+
+void SpriteBatch::fillCircle(float x, float y, float radius, SDL_Color color) {
+    if (radius <= 0.0f) return;
+    setTexture(nullptr);
+
+    // Triangle fan around the center
+    int segments = circleSegments(radius);
+    reserve(static_cast<size_t>(segments) + 1);
+    int centerIndex = static_cast<int>(m_vertices.size());
+    m_vertices.push_back({{x, y}, color, {0.0f, 0.0f}});
+    for (int i = 0; i < segments; ++i) {
+        float angle = static_cast<float>(i) / segments * 2.0f * static_cast<float>(M_PI);
+        m_vertices.push_back({{x + radius * std::cos(angle), y + radius * std::sin(angle)}, color, {0.0f, 0.0f}});
+        int next = (i + 1) % segments;
+        m_indices.insert(m_indices.end(), {centerIndex, centerIndex + 1 + i, centerIndex + 1 + next});
+    }
+}
+
+void SpriteBatch::drawCircle(float x, float y, float radius, SDL_Color color) {
+    if (radius <= 0.0f) return;
+    setTexture(nullptr);
+
+    // Ring one pixel wide, as a strip of quads
+    int segments = circleSegments(radius);
+    reserve(static_cast<size_t>(segments) * 2);
+    float inner = std::max(0.0f, radius - 0.5f);
+    float outer = radius + 0.5f;
+    int base = static_cast<int>(m_vertices.size());
+    for (int i = 0; i < segments; ++i) {
+        float angle = static_cast<float>(i) / segments * 2.0f * static_cast<float>(M_PI);
+        float c = std::cos(angle);
+        float s = std::sin(angle);
+        m_vertices.push_back({{x + inner * c, y + inner * s}, color, {0.0f, 0.0f}});
+        m_vertices.push_back({{x + outer * c, y + outer * s}, color, {0.0f, 0.0f}});
+    }
+    for (int i = 0; i < segments; ++i) {
+        int a = base + i * 2;
+        int b = base + ((i + 1) % segments) * 2;
+        m_indices.insert(m_indices.end(), {a, a + 1, b + 1, a, b + 1, b});
+    }
+}
+
+void SpriteBatch::drawPointSprites(SDL_Texture* texture, const PointSprite* sprites, size_t count,
+                                   SDL_FPoint origin, float scale, SDL_BlendMode blendMode) {
+    if (!texture || !sprites || count == 0) return;
+    setTexture(texture, blendMode);
+
+    size_t done = 0;
+    while (done < count) {
+        reserve(4);
+        size_t room = (MAX_BATCH_VERTICES - m_vertices.size()) / 4;
+        size_t batchCount = std::min(count - done, room);
+
+        size_t firstVertex = m_vertices.size();
+        size_t firstIndex = m_indices.size();
+        m_vertices.resize(firstVertex + batchCount * 4);
+        m_indices.resize(firstIndex + batchCount * 6);
+        SDL_Vertex* vertex = m_vertices.data() + firstVertex;
+        int* index = m_indices.data() + firstIndex;
+        int base = static_cast<int>(firstVertex);
+
+        for (size_t i = 0; i < batchCount; ++i) {
+            const PointSprite& sprite = sprites[done + i];
+            float x = (sprite.x - origin.x) * scale;
+            float y = (sprite.y - origin.y) * scale;
+            float r = sprite.radius * scale;
+            vertex[0] = {{x - r, y - r}, sprite.color, {0.0f, 0.0f}};
+            vertex[1] = {{x + r, y - r}, sprite.color, {1.0f, 0.0f}};
+            vertex[2] = {{x + r, y + r}, sprite.color, {1.0f, 1.0f}};
+            vertex[3] = {{x - r, y + r}, sprite.color, {0.0f, 1.0f}};
+            index[0] = base; index[1] = base + 1; index[2] = base + 2;
+            index[3] = base; index[4] = base + 2; index[5] = base + 3;
+            vertex += 4;
+            index += 6;
+            base += 4;
+        }
+        done += batchCount;
+    }
+}
+
+void SpriteBatch::flush() {
+    if (m_indices.empty()) return;
+
+    if (m_renderer) {
+        if (m_texture && m_blendMode != SDL_BLENDMODE_INVALID) SDL_SetTextureBlendMode(m_texture, m_blendMode);
+        if (SDL_RenderGeometry(m_renderer, m_texture, m_vertices.data(), static_cast<int>(m_vertices.size()),
+                               m_indices.data(), static_cast<int>(m_indices.size())) != 0) {
+            if (!m_loggedError) {
+                Log::Error("SDL_RenderGeometry failed: " + std::string(SDL_GetError()));
+                m_loggedError = true;
+            }
+        }
+        ++m_drawCalls;
+        m_triangles += m_indices.size() / 3;
+    }
+
+    m_vertices.clear();
+    m_indices.clear();
+}
+
+} // namespace TuxArena
@@ -0,0 +1,201 @@
+// src/TextureAtlas.cpp
+#include "TuxArena/TextureAtlas.h"
+#include "TuxArena/Log.h"
+
+#include <algorithm> // For std::max, std::clamp
+#include <climits>   // For INT_MAX, LONG_MAX
+#include <cstring>   // For std::memcpy
+#include <cstdint>
+
+namespace TuxArena {
+
+TextureAtlas::~TextureAtlas() {
+    clear();
+}
+
+void TextureAtlas::clear() {
+    for (Page& page : m_pages) {
+        if (page.texture) SDL_DestroyTexture(page.texture);
+    }
+    m_pages.clear();
+    m_regions.clear();
+}
+
+const TextureAtlas::Region* TextureAtlas::find(const std::string& key) const {
+    auto it = m_regions.find(key);
+    return it != m_regions.end() ? &it->second : nullptr;
+}
+
+void TextureAtlas::remove(const std::string& key) {
+    auto it = m_regions.find(key);
+    if (it == m_regions.end()) return;
+    const Region region = it->second;
+    m_regions.erase(it);
+
+    for (size_t i = 0; i < m_pages.size(); ++i) {
+        Page& page = m_pages[i];
+        if (page.texture != region.page) continue;
+        if (--page.imageCount == 0) {
+            SDL_DestroyTexture(page.texture);
+            m_pages.erase(m_pages.begin() + static_cast<std::ptrdiff_t>(i));
+            Log::Info("Destroyed empty texture atlas page (" + std::to_string(m_pages.size()) + " left).");
+        } else {
+            page.freeCells.push_back({region.rect.x - PADDING, region.rect.y - PADDING,
+                                      region.rect.w + PADDING * 2, region.rect.h + PADDING * 2});
+        }
+        return;
+    }
+}
+
+bool TextureAtlas::reuseFreeCell(Page& page, int width, int height, SDL_Point& position) {
+    // Smallest free cell the image fits in; what is left of it is split off to the right and below
+    int bestIndex = -1;
+    long bestArea = LONG_MAX;
+    for (size_t i = 0; i < page.freeCells.size(); ++i) {
+        const SDL_Rect& cell = page.freeCells[i];
+        long area = static_cast<long>(cell.w) * cell.h;
+        if (cell.w >= width && cell.h >= height && area < bestArea) {
+            bestIndex = static_cast<int>(i);
+            bestArea = area;
+        }
+    }
+    if (bestIndex < 0) return false;
+
+    SDL_Rect cell = page.freeCells[bestIndex];
+    page.freeCells.erase(page.freeCells.begin() + bestIndex);
+    position = {cell.x, cell.y};
+    if (cell.w > width) page.freeCells.push_back({cell.x + width, cell.y, cell.w - width, height});
+    if (cell.h > height) page.freeCells.push_back({cell.x, cell.y + height, cell.w, cell.h - height});
+    return true;
+}
+
+bool TextureAtlas::createPage() {
+    SDL_Texture* texture = SDL_CreateTexture(m_renderer, SDL_PIXELFORMAT_RGBA32, SDL_TEXTUREACCESS_STATIC, PAGE_SIZE, PAGE_SIZE);
+    if (!texture) {
+        Log::Warning("Failed to create texture atlas page: " + std::string(SDL_GetError()));
+        return false;
+    }
+    SDL_SetTextureBlendMode(texture, SDL_BLENDMODE_BLEND);
+
+    Page page;
+    page.texture = texture;
+    page.skyline.push_back({0, 0, PAGE_SIZE});
+    m_pages.push_back(std::move(page));
+    Log::Info("Created texture atlas page " + std::to_string(m_pages.size()) + " (" +
+              std::to_string(PAGE_SIZE) + "x" + std::to_string(PAGE_SIZE) + ").");
+    return true;
+}
+
+bool TextureAtlas::pack(Page& page, int width, int height, SDL_Point& position) {
+    std::vector<SkylineNode>& skyline = page.skyline;
+
+    // Bottom-left rule: lowest resulting top edge, ties broken by the narrowest starting segment
+    int bestIndex = -1;
+    int bestY = INT_MAX;
+    int bestSegmentWidth = INT_MAX;
+    for (size_t i = 0; i < skyline.size(); ++i) {
+        int x = skyline[i].x;
+        if (x + width > PAGE_SIZE) break;
+
+        int y = 0;
+        int remaining = width;
+        for (size_t j = i; remaining > 0 && j < skyline.size(); ++j) {
+            y = std::max(y, skyline[j].y);
+            remaining -= skyline[j].width;
+        }
+        if (y + height > PAGE_SIZE) continue;
+
+        if (y < bestY || (y == bestY && skyline[i].width < bestSegmentWidth)) {
+            bestIndex = static_cast<int>(i);
+            bestY = y;
+            bestSegmentWidth = skyline[i].width;
+        }
+    }
+    if (bestIndex < 0) return false;
+
+    position = {skyline[bestIndex].x, bestY};
+    skyline.insert(skyline.begin() + bestIndex, {position.x, bestY + height, width});
+
+    // Trim the segments now covered by the new one
+    for (size_t i = bestIndex + 1; i < skyline.size();) {
+        int previousEnd = skyline[i - 1].x + skyline[i - 1].width;
+        if (skyline[i].x >= previousEnd) break;
+        int shrink = previousEnd - skyline[i].x;
+        skyline[i].x += shrink;
+        skyline[i].width -= shrink;
+        if (skyline[i].width > 0) break;
+        skyline.erase(skyline.begin() + i);
+    }
+
+    // Merge neighbours at the same height
+    for (size_t i = 0; i + 1 < skyline.size();) {
+        if (skyline[i].y == skyline[i + 1].y) {
+            skyline[i].width += skyline[i + 1].width;
+            skyline.erase(skyline.begin() + i + 1);
+        } else {
+            ++i;
+        }
+    }
+    return true;
+}
+
+const TextureAtlas::Region* TextureAtlas::add(const std::string& key, SDL_Surface* surface) {
+    if (const Region* existing = find(key)) return existing;
+    if (!m_renderer || !surface || surface->w <= 0 || surface->h <= 0) return nullptr;
+    if (surface->w > MAX_IMAGE_SIZE || surface->h > MAX_IMAGE_SIZE) return nullptr;
+
+    SDL_Surface* rgba = SDL_ConvertSurfaceFormat(surface, SDL_PIXELFORMAT_RGBA32, 0);
+    if (!rgba) {
+        Log::Warning("Failed to convert '" + key + "' for the texture atlas: " + std::string(SDL_GetError()));
+        return nullptr;
+    }
+
+    int cellWidth = surface->w + PADDING * 2;
+    int cellHeight = surface->h + PADDING * 2;
+    SDL_Point position = {0, 0};
+    size_t pageIndex = 0;
+    while (pageIndex < m_pages.size() && !reuseFreeCell(m_pages[pageIndex], cellWidth, cellHeight, position) &&
+           !pack(m_pages[pageIndex], cellWidth, cellHeight, position)) {
+        ++pageIndex;
+    }
+    if (pageIndex == m_pages.size()) {
+        if (!createPage() || !pack(m_pages.back(), cellWidth, cellHeight, position)) {
+            SDL_FreeSurface(rgba);
+            return nullptr;
+        }
+    }
+
+    // Copy the image with its edge pixels extruded into the padding
+    std::vector<uint32_t> cell(static_cast<size_t>(cellWidth) * cellHeight);
+    const uint8_t* pixels = static_cast<const uint8_t*>(rgba->pixels);
+    for (int y = 0; y < cellHeight; ++y) {
+        int sourceY = std::clamp(y - PADDING, 0, rgba->h - 1);
+        const uint32_t* sourceRow = reinterpret_cast<const uint32_t*>(pixels + static_cast<size_t>(sourceY) * rgba->pitch);
+        uint32_t* row = cell.data() + static_cast<size_t>(y) * cellWidth;
+        for (int x = 0; x < PADDING; ++x) row[x] = sourceRow[0];
+        std::memcpy(row + PADDING, sourceRow, static_cast<size_t>(rgba->w) * sizeof(uint32_t));
+        for (int x = PADDING + rgba->w; x < cellWidth; ++x) row[x] = sourceRow[rgba->w - 1];
+    }
+    SDL_FreeSurface(rgba);
+
+    Page& page = m_pages[pageIndex];
+    SDL_Rect cellRect = {position.x, position.y, cellWidth, cellHeight};
+    if (SDL_UpdateTexture(page.texture, &cellRect, cell.data(), cellWidth * static_cast<int>(sizeof(uint32_t))) != 0) {
+        Log::Warning("Failed to upload '" + key + "' to the texture atlas: " + std::string(SDL_GetError()));
+        if (page.imageCount == 0) {
+            SDL_DestroyTexture(page.texture);
+            m_pages.erase(m_pages.begin() + static_cast<std::ptrdiff_t>(pageIndex));
+        } else {
+            page.freeCells.push_back(cellRect);
+        }
+        return nullptr;
+    }
+
+    ++page.imageCount;
+    Region& region = m_regions[key];
+    region.page = page.texture;
+    region.rect = {position.x + PADDING, position.y + PADDING, surface->w, surface->h};
+    return &region;
+}
+
+} // namespace TuxArena
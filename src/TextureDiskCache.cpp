@@ -0,0 +1,205 @@
+// src/TextureDiskCache.cpp
+#include "TuxArena/TextureDiskCache.h"
+#include "TuxArena/Log.h"
+
+#include <SDL2/SDL_image.h>
+#include <algorithm>  // For std::sort
+#include <cstdio>     // For std::snprintf, std::remove
+#include <cstring>    // For std::memcmp, std::memcpy
+#include <filesystem> // For file size, modification time and directory creation
+#include <fstream>
+#include <vector>
+
+namespace TuxArena {
+
+namespace {
+constexpr char CACHE_MAGIC[4] = {'T', 'X', 'C', 'R'};
+
+uint64_t hashPath(const std::string& path) {
+    uint64_t hash = 14695981039346656037ull; // FNV-1a
+    for (unsigned char c : path) {
+        hash ^= c;
+        hash *= 1099511628211ull;
+    }
+    return hash;
+}
+} // anonymous namespace
+
+TextureDiskCache::TextureDiskCache(std::string directory)
+    : m_directory(std::move(directory)) {}
+
+bool TextureDiskCache::resolveDirectory() {
+    if (m_directoryResolved) return !m_directory.empty();
+    m_directoryResolved = true;
+    if (m_directory.empty()) {
+        char* prefPath = SDL_GetPrefPath("TuxArena", "TuxArena"); // Ends with a separator
+        if (prefPath) {
+            m_directory = std::string(prefPath) + "textures";
+            SDL_free(prefPath);
+        } else {
+            Log::Warning("Texture disk cache disabled, no preferences directory: " + std::string(SDL_GetError()));
+            m_enabled = false;
+        }
+    }
+    return !m_directory.empty();
+}
+
+std::string TextureDiskCache::getEntryPath(uint64_t pathHash) const {
+    char name[32];
+    std::snprintf(name, sizeof(name), "%016llx.rgba", static_cast<unsigned long long>(pathHash));
+    return m_directory + "/" + name;
+}
+
+SDL_Surface* TextureDiskCache::load(const std::string& sourcePath) {
+    std::error_code sizeError, timeError;
+    uint64_t sourceSize = std::filesystem::file_size(sourcePath, sizeError);
+    auto modified = std::filesystem::last_write_time(sourcePath, timeError);
+    if (!m_enabled || sizeError || timeError || !resolveDirectory()) {
+        return IMG_Load(sourcePath.c_str()); // Missing files fail in IMG_Load as before
+    }
+
+    Header expected = {};
+    std::memcpy(expected.magic, CACHE_MAGIC, sizeof(CACHE_MAGIC));
+    expected.version = FORMAT_VERSION;
+    expected.pathHash = hashPath(sourcePath);
+    expected.sourceSize = sourceSize;
+    expected.sourceModified = static_cast<int64_t>(modified.time_since_epoch().count());
+    std::string entryPath = getEntryPath(expected.pathHash);
+
+    if (SDL_Surface* cached = readEntry(entryPath, expected)) {
+        ++m_hits;
+        std::error_code touchError; // Recently used entries survive pruning
+        std::filesystem::last_write_time(entryPath, std::filesystem::file_time_type::clock::now(), touchError);
+        return cached;
+    }
+
+    ++m_misses;
+    SDL_Surface* decoded = IMG_Load(sourcePath.c_str());
+    if (!decoded) return nullptr;
+    SDL_Surface* converted = SDL_ConvertSurfaceFormat(decoded, SDL_PIXELFORMAT_RGBA32, 0);
+    SDL_FreeSurface(decoded);
+    if (!converted) return nullptr;
+
+    expected.width = static_cast<uint32_t>(converted->w);
+    expected.height = static_cast<uint32_t>(converted->h);
+    writeEntry(entryPath, expected, converted);
+    return converted;
+}
+
+SDL_Surface* TextureDiskCache::readEntry(const std::string& entryPath, const Header& expected) {
+    std::ifstream file(entryPath, std::ios::binary);
+    if (!file) return nullptr;
+    Header header;
+    if (!file.read(reinterpret_cast<char*>(&header), sizeof(header))) return nullptr;
+    if (std::memcmp(header.magic, expected.magic, sizeof(header.magic)) != 0 || header.version != expected.version ||
+        header.pathHash != expected.pathHash || header.sourceSize != expected.sourceSize ||
+        header.sourceModified != expected.sourceModified || header.width == 0 || header.height == 0) {
+        return nullptr; // Stale or foreign entry: decoded again and overwritten
+    }
+
+    SDL_Surface* surface = SDL_CreateRGBSurfaceWithFormat(0, static_cast<int>(header.width), static_cast<int>(header.height),
+                                                          32, SDL_PIXELFORMAT_RGBA32);
+    if (!surface) return nullptr;
+    std::streamsize rowBytes = static_cast<std::streamsize>(header.width) * 4;
+    bool ok = true;
+    if (surface->pitch == rowBytes) {
+        ok = static_cast<bool>(file.read(static_cast<char*>(surface->pixels), rowBytes * header.height)); // One read
+    } else {
+        for (uint32_t y = 0; y < header.height && ok; ++y) {
+            ok = static_cast<bool>(file.read(static_cast<char*>(surface->pixels) + static_cast<size_t>(y) * surface->pitch, rowBytes));
+        }
+    }
+    if (!ok) {
+        SDL_FreeSurface(surface);
+        return nullptr;
+    }
+    return surface;
+}
+
+void TextureDiskCache::writeEntry(const std::string& entryPath, const Header& header, SDL_Surface* surface) {
+    if (!m_directoryReady) {
+        std::error_code error;
+        std::filesystem::create_directories(m_directory, error);
+        if (error) {
+            Log::Warning("Texture disk cache disabled, cannot create '" + m_directory + "': " + error.message());
+            m_enabled = false;
+            return;
+        }
+        m_directoryReady = true;
+        prune(m_maxBytes); // Measures the directory and clears out what earlier runs left over the cap
+    }
+    uint64_t entryBytes = sizeof(header) + static_cast<uint64_t>(surface->w) * static_cast<uint64_t>(surface->h) * 4;
+    if (entryBytes > m_maxBytes) return;
+    if (m_directoryBytes + entryBytes > m_maxBytes) {
+        prune(m_maxBytes - std::min(m_maxBytes, m_maxBytes / 4 + entryBytes)); // Some headroom, so not every write prunes
+    }
+
+    // Written under a temporary name and renamed, so a crash never leaves a truncated entry behind
+    std::string tempPath = entryPath + ".tmp";
+    {
+        std::ofstream file(tempPath, std::ios::binary | std::ios::trunc);
+        if (!file) return;
+        file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        std::streamsize rowBytes = static_cast<std::streamsize>(surface->w) * 4;
+        for (int y = 0; y < surface->h; ++y) {
+            file.write(static_cast<const char*>(surface->pixels) + static_cast<size_t>(y) * surface->pitch, rowBytes);
+        }
+        if (!file) {
+            file.close();
+            std::remove(tempPath.c_str());
+            return;
+        }
+    }
+    std::error_code error;
+    uint64_t replacedBytes = std::filesystem::file_size(entryPath, error); // A stale entry being overwritten
+    if (error) replacedBytes = 0;
+    std::filesystem::rename(tempPath, entryPath, error);
+    if (error) {
+        std::remove(tempPath.c_str());
+        return;
+    }
+    m_directoryBytes = m_directoryBytes - std::min(m_directoryBytes, replacedBytes) + entryBytes;
+}
+
+void TextureDiskCache::prune(uint64_t targetBytes) {
+    struct Entry {
+        std::filesystem::path path;
+        uint64_t bytes;
+        std::filesystem::file_time_type modified;
+    };
+    std::vector<Entry> entries;
+    uint64_t total = 0;
+    std::error_code error;
+    for (const auto& item : std::filesystem::directory_iterator(m_directory, error)) {
+        std::error_code itemError;
+        const std::filesystem::path& path = item.path();
+        if (path.extension() == ".tmp") {
+            std::filesystem::remove(path, itemError); // Left behind by a crash mid-write
+            continue;
+        }
+        if (path.extension() != ".rgba") continue;
+        uint64_t bytes = item.file_size(itemError);
+        auto modified = item.last_write_time(itemError);
+        if (itemError) continue;
+        entries.push_back({path, bytes, modified});
+        total += bytes;
+    }
+
+    if (total > targetBytes) {
+        // Least recently used first
+        std::sort(entries.begin(), entries.end(), [](const Entry& a, const Entry& b) { return a.modified < b.modified; });
+        size_t removed = 0;
+        for (const Entry& entry : entries) {
+            if (total <= targetBytes) break;
+            std::error_code removeError;
+            if (std::filesystem::remove(entry.path, removeError)) {
+                total -= entry.bytes;
+                ++removed;
+            }
+        }
+        Log::Info("Texture disk cache: removed " + std::to_string(removed) + " old entries.");
+    }
+    m_directoryBytes = total;
+}
+
+} // namespace TuxArena
@@ -21,18 +21,18 @@ UIManager::~UIManager() {
     Log::Info("UIManager destroyed.");
 }
 
-bool UIManager::initialize(SDL_Window* window, SDL_Renderer* renderer) {
-    if (!window || !renderer) {
-        Log::Error("UIManager: SDL_Window or SDL_Renderer is null.");
+bool UIManager::initialize(SDL_Window* window, SDL_Renderer* renderer, ImGuiContext* context) {
+    if (!window || !renderer || !context) {
+        Log::Error("UIManager: SDL_Window, SDL_Renderer or ImGui context is null.");
         return false;
     }
 
     m_sdlWindow = window;
     m_sdlRenderer = renderer;
+    m_imguiContext = context;
 
-    // Setup Dear ImGui context
-    IMGUI_CHECKVERSION();
-    ImGui::CreateContext();
+    // One ImGui context for the whole client: the renderer's, whose backends are already initialized
+    ImGui::SetCurrentContext(m_imguiContext);
     ImGuiIO& io = ImGui::GetIO(); (void)io;
     io.ConfigFlags |= ImGuiConfigFlags_NavEnableKeyboard;     // Enable Keyboard Controls
     io.ConfigFlags |= ImGuiConfigFlags_NavEnableGamepad;      // Enable Gamepad Controls
@@ -40,10 +40,6 @@ bool UIManager::initialize(SDL_Window* window, SDL_Renderer* renderer) {
     // Setup Dear ImGui style
     UI::SetGothicTheme(); // Apply custom theme
 
-    // Setup Platform/Renderer backends
-    ImGui_ImplSDL2_InitForOpenGL(m_sdlWindow, SDL_GL_GetCurrentContext());
-    ImGui_ImplOpenGL3_Init("#version 130");
-
     // Load default font
     io.Fonts->AddFontFromFileTTF("assets/fonts/nokia.ttf", 18.0f);
     if (io.Fonts->Fonts.empty()) {
@@ -51,6 +47,10 @@ bool UIManager::initialize(SDL_Window* window, SDL_Renderer* renderer) {
     } else {
         Log::Info("UIManager: Default font loaded.");
     }
+    // The renderer built the font texture at its init; rebuild it with the new font (still on the
+    // thread that owns the GL context, the render thread is not started yet)
+    ImGui_ImplOpenGL3_DestroyDeviceObjects();
+    ImGui_ImplOpenGL3_CreateDeviceObjects();
 
     Log::Info("UIManager initialized successfully.");
     return true;
@@ -58,9 +58,8 @@ bool UIManager::initialize(SDL_Window* window, SDL_Renderer* renderer) {
 
 void UIManager::shutdown() {
     Log::Info("Shutting down UIManager...");
-    ImGui_ImplOpenGL3_Shutdown();
-    ImGui_ImplSDL2_Shutdown();
-    ImGui::DestroyContext();
+    // The ImGui context and its backends belong to the Renderer
+    m_imguiContext = nullptr;
     m_sdlWindow = nullptr;
     m_sdlRenderer = nullptr;
     Log::Info("UIManager shutdown complete.");
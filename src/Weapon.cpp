@@ -3,6 +3,7 @@
 #include "TuxArena/EntityManager.h"
 #include "TuxArena/ProjectileBullet.h"
 #include "TuxArena/Log.h"
+#include "TuxArena/Random.h"
 #include <cmath> // For std::cos, std::sin
 
 namespace TuxArena
@@ -34,7 +35,7 @@ namespace TuxArena
             float spread = 0.0f;
             if (m_definition.spreadAngle > 0)
             {
-                spread = ((float)rand() / RAND_MAX - 0.5f) * m_definition.spreadAngle;
+                spread = getRandom(RandomStream::Gameplay).range(-0.5f, 0.5f) * m_definition.spreadAngle;
             }
 
             float angle = ownerRotation + spread;
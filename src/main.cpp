@@ -51,6 +51,33 @@ AppConfig parseArguments(int argc, char* argv[]) {
                  config.windowHeight = std::stoi(args[++i]);
              } catch (...) { /* Handle error */ }
         }
+        else if (args[i] == "--no-render-thread") {
+            config.renderThreadEnabled = false;
+        }
+        else if (args[i] == "--render-thread") {
+            config.renderThreadEnabled = true;
+        }
+        else if (args[i] == "--fps" && i + 1 < args.size()) {
+             try {
+                 config.targetFps = std::stoi(args[++i]);
+             } catch (...) { /* Handle error */ }
+        }
+        else if (args[i] == "--no-late-input") {
+            config.lateInputSampling = false;
+        }
+        else if (args[i] == "--fog-of-war") {
+            config.fogOfWar = true;
+        }
+        else if (args[i] == "--texture-budget" && i + 1 < args.size()) {
+             try {
+                 config.textureBudgetMB = std::stoi(args[++i]);
+             } catch (...) { /* Handle error */ }
+        }
+        else if (args[i] == "--seed" && i + 1 < args.size()) {
+             try {
+                 config.randomSeed = std::stoull(args[++i]);
+             } catch (...) { /* Handle error */ }
+        }
         else if (args[i] == "--help" || args[i] == "-h") {
             std::cout << "Usage: " << argv[0] << " [options]\n";
             std::cout << "Options:\n";
@@ -60,6 +87,13 @@ AppConfig parseArguments(int argc, char* argv[]) {
             std::cout << "  --map <mapfile>  Map to load (server) or expect (client) (default: " << config.mapName << ").\n";
             std::cout << "  --width <px>     Window width (client only, default: " << config.windowWidth << ").\n";
             std::cout << "  --height <px>    Window height (client only, default: " << config.windowHeight << ").\n";
+            std::cout << "  --no-render-thread  Draw on the main thread (client only, the default except on Linux).\n";
+            std::cout << "  --render-thread  Draw on a dedicated thread (client only, the default on Linux).\n";
+            std::cout << "  --fps <n>        Frame cap while playing (client only, 0 = display refresh rate, -1 = uncapped).\n";
+            std::cout << "  --no-late-input  Poll input right after the previous frame instead of just before the deadline.\n";
+            std::cout << "  --fog-of-war     Only show the parts of the map the player can see (client only).\n";
+            std::cout << "  --texture-budget <MiB>  Texture cache size before unused textures are evicted (default: " << config.textureBudgetMB << ").\n";
+            std::cout << "  --seed <n>       Random seed for weapon spread and effects, to repeat a run (default: from the clock).\n";
             std::cout << "  --help, -h       Show this help message.\n";
             exit(0); // Exit after showing help
         } else {
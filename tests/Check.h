@@ -0,0 +1,21 @@
+// tests/Check.h
+#ifndef TUXARENA_TESTS_CHECK_H
+#define TUXARENA_TESTS_CHECK_H
+
+#include <cstdio>
+
+// Minimal assertions for the unit tests: a failed CHECK is printed and counted, and main() returns
+// the count, so ctest reports the test as failed without stopping at the first failure
+namespace TuxArena::Test {
+inline int failures = 0;
+}
+
+#define CHECK(condition)                                                                         \
+    do {                                                                                         \
+        if (!(condition)) {                                                                      \
+            std::fprintf(stderr, "%s:%d: CHECK(%s) failed\n", __FILE__, __LINE__, #condition);    \
+            ++TuxArena::Test::failures;                                                          \
+        }                                                                                        \
+    } while (0)
+
+#endif // TUXARENA_TESTS_CHECK_H
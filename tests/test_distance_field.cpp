@@ -0,0 +1,143 @@
+// tests/test_distance_field.cpp
+// Distances, gradients and circle resolution near known walls and shapes, and incremental
+// rebuilds matching a full build
+#include "Check.h"
+#include "TuxArena/CollisionGrid.h"
+#include "TuxArena/DistanceField.h"
+
+#include <cmath>
+#include <vector>
+
+using namespace TuxArena;
+
+namespace {
+
+constexpr unsigned TILE_SIZE = 32;
+
+bool near(float value, float expected, float tolerance) {
+    return std::fabs(value - expected) <= tolerance;
+}
+
+// 16x16 tiles with a single solid tile at (8, 8), i.e. pixels [256, 288)
+CollisionGrid makeGrid() {
+    CollisionGrid grid;
+    grid.reset(16, 16, TILE_SIZE, TILE_SIZE);
+    grid.setSolid(8, 8, true);
+    return grid;
+}
+
+void testDistances() {
+    CollisionGrid grid = makeGrid();
+    std::vector<CollisionShape> shapes;
+    DistanceField field;
+    CHECK(!field.isBuilt());
+    CHECK(field.build(grid, shapes));
+    CHECK(field.isBuilt());
+    CHECK(field.getTexelSize() == TILE_SIZE / static_cast<float>(DistanceField::DEFAULT_TEXELS_PER_TILE));
+    const float tolerance = field.getTexelSize() * 0.5f;
+
+    // Left of the wall tile, level with its middle
+    CHECK(near(field.sampleDistance(246.0f, 272.0f), 10.0f, tolerance));
+    CHECK(near(field.sampleDistance(216.0f, 272.0f), 40.0f, tolerance));
+    // Inside: half a tile from the nearest face
+    CHECK(field.sampleDistance(272.0f, 272.0f) < 0.0f);
+    CHECK(near(field.sampleDistance(272.0f, 272.0f), -16.0f, tolerance));
+    // The map edge is a wall too
+    CHECK(near(field.sampleDistance(20.0f, 100.0f), 20.0f, tolerance));
+    CHECK(field.sampleDistance(-50.0f, 100.0f) < 0.0f);
+    // Far from everything the distance is clamped
+    float maxDistance = DistanceField::MAX_DISTANCE_TEXELS * field.getTexelSize();
+    CHECK(field.sampleDistance(100.0f, 100.0f) <= maxDistance);
+
+    // The gradient points away from the nearest face
+    Vec2 left = field.sampleGradient(240.0f, 272.0f);
+    CHECK(left.x < -0.9f);
+    Vec2 below = field.sampleGradient(272.0f, 300.0f);
+    CHECK(below.y > 0.9f);
+
+    CHECK(field.hasClearance(200.0f, 272.0f, 40.0f));
+    CHECK(!field.hasClearance(240.0f, 272.0f, 20.0f));
+}
+
+void testResolveCircle() {
+    CollisionGrid grid = makeGrid();
+    DistanceField field;
+    field.build(grid, {});
+
+    // Overlapping the left face by 10 px: pushed out along -x only
+    Vec2 center = {250.0f, 272.0f};
+    CHECK(field.resolveCircle(center, 16.0f));
+    CHECK(near(center.x, 240.0f, 1.0f));
+    CHECK(near(center.y, 272.0f, 1.0f));
+    CHECK(field.sampleDistance(center.x, center.y) >= 16.0f - 1.0f);
+
+    // Clear of everything: untouched
+    Vec2 free = {120.0f, 120.0f};
+    CHECK(!field.resolveCircle(free, 16.0f));
+    CHECK(free.x == 120.0f && free.y == 120.0f);
+}
+
+void testShapes() {
+    CollisionGrid grid;
+    grid.reset(16, 16, TILE_SIZE, TILE_SIZE);
+    // A sub-tile box and a circle, neither of which fills a whole tile
+    std::vector<CollisionShape> shapes;
+    shapes.emplace_back(CollisionShape::Type::Rectangle, 100.0f, 100.0f, 112.0f, 112.0f);
+    shapes.emplace_back(CollisionShape::Type::Ellipse, 300.0f, 100.0f, 340.0f, 140.0f);
+    DistanceField field;
+    field.build(grid, shapes);
+    const float tolerance = field.getTexelSize();
+
+    CHECK(field.sampleDistance(106.0f, 106.0f) < 0.0f);
+    CHECK(near(field.sampleDistance(132.0f, 106.0f), 20.0f, tolerance));
+    CHECK(field.sampleDistance(320.0f, 120.0f) < 0.0f);
+    CHECK(near(field.sampleDistance(320.0f, 170.0f), 30.0f, tolerance));
+    CHECK(grid.isSolidAt(106.0f, 106.0f) == false); // Only the field sees the shape at this scale
+}
+
+void testIncrementalRebuild() {
+    CollisionGrid grid = makeGrid();
+    DistanceField field;
+    field.build(grid, {});
+
+    // Knock the wall out and put one elsewhere, as tile edits do
+    grid.setSolid(8, 8, false);
+    field.invalidateRegion(grid, {}, 8 * 32.0f, 8 * 32.0f, 9 * 32.0f, 9 * 32.0f);
+    grid.setSolid(3, 12, true);
+    field.invalidateRegion(grid, {}, 3 * 32.0f, 12 * 32.0f, 4 * 32.0f, 13 * 32.0f);
+    CHECK(field.hasDirtyRegions());
+    int guard = 0;
+    while (field.hasDirtyRegions() && guard++ < 100) field.rebuildDirty(256); // Small budget: several calls
+    CHECK(!field.hasDirtyRegions());
+
+    DistanceField expected;
+    expected.build(grid, {});
+    bool same = true;
+    for (float y = 0.0f; y < 16 * 32.0f && same; y += 3.0f) {
+        for (float x = 0.0f; x < 16 * 32.0f && same; x += 3.0f) {
+            same = field.sampleDistance(x, y) == expected.sampleDistance(x, y);
+        }
+    }
+    CHECK(same);
+    CHECK(field.sampleDistance(272.0f, 272.0f) > 0.0f);
+}
+
+void testInvalidInput() {
+    CollisionGrid empty;
+    DistanceField field;
+    CHECK(!field.build(empty, {}));
+    CHECK(!field.isBuilt());
+    CollisionGrid grid = makeGrid();
+    CHECK(!field.build(grid, {}, 0));
+}
+
+} // anonymous namespace
+
+int main() {
+    testDistances();
+    testResolveCircle();
+    testShapes();
+    testIncrementalRebuild();
+    testInvalidInput();
+    return Test::failures;
+}
@@ -0,0 +1,136 @@
+// tests/test_fog_of_war.cpp
+// Shadowcasting on small hand-made grids: open rooms are fully visible, walls are visible but hide
+// what is behind them, and the mask is only recomputed when something changed
+#include "Check.h"
+#include "TuxArena/CollisionGrid.h"
+#include "TuxArena/FogOfWar.h"
+
+using namespace TuxArena;
+
+namespace {
+
+constexpr unsigned TILE_SIZE = 32;
+
+Vec2 tileCenter(int tileX, int tileY) {
+    return {(static_cast<float>(tileX) + 0.5f) * TILE_SIZE, (static_cast<float>(tileY) + 0.5f) * TILE_SIZE};
+}
+
+void testOpenRoom() {
+    CollisionGrid grid;
+    grid.reset(11, 11, TILE_SIZE, TILE_SIZE);
+    FogOfWar fog;
+    CHECK(fog.update(grid, tileCenter(5, 5), 0));
+    CHECK(fog.getWidth() == 11 && fog.getHeight() == 11);
+
+    bool allVisible = true;
+    for (int y = 0; y < 11; ++y) {
+        for (int x = 0; x < 11; ++x) allVisible = allVisible && fog.isVisible(x, y);
+    }
+    CHECK(allVisible);
+    CHECK(!fog.isVisible(-1, 5)); // Outside the map
+    CHECK(!fog.isVisible(11, 5));
+}
+
+void testRadius() {
+    CollisionGrid grid;
+    grid.reset(21, 21, TILE_SIZE, TILE_SIZE);
+    FogOfWar fog;
+    fog.setRadius(4);
+    fog.update(grid, tileCenter(10, 10), 0);
+
+    // Visible exactly inside the circle (squared distance below radius squared)
+    bool matchesCircle = true;
+    for (int y = 0; y < 21; ++y) {
+        for (int x = 0; x < 21; ++x) {
+            int dx = x - 10, dy = y - 10;
+            matchesCircle = matchesCircle && fog.isVisible(x, y) == (dx * dx + dy * dy < 16);
+        }
+    }
+    CHECK(matchesCircle);
+}
+
+void testShadows() {
+    // . . . . . . . . . . .
+    // . . . . . . . # . . .   single wall tile at (7, 5), player at (2, 5)
+    // . . . . . . . . . . .
+    CollisionGrid grid;
+    grid.reset(11, 11, TILE_SIZE, TILE_SIZE);
+    grid.setSolid(7, 5, true);
+    FogOfWar fog;
+    fog.update(grid, tileCenter(2, 5), 0);
+
+    CHECK(fog.isVisible(2, 5));
+    CHECK(fog.isVisible(6, 5));
+    CHECK(fog.isVisible(7, 5)); // The wall itself
+    CHECK(!fog.isVisible(8, 5));
+    CHECK(!fog.isVisible(9, 5));
+    CHECK(!fog.isVisible(10, 5));
+    CHECK(fog.isVisible(10, 0)); // Off to the side of the shadow
+    CHECK(fog.isVisible(10, 10));
+
+    // A full wall column hides the whole far side
+    for (int y = 0; y < 11; ++y) grid.setSolid(7, y, true);
+    fog.update(grid, tileCenter(2, 5), 1);
+    bool farSideHidden = true;
+    bool wallVisible = true;
+    for (int y = 0; y < 11; ++y) {
+        wallVisible = wallVisible && fog.isVisible(7, y);
+        for (int x = 8; x < 11; ++x) farSideHidden = farSideHidden && !fog.isVisible(x, y);
+    }
+    CHECK(wallVisible);
+    CHECK(farSideHidden);
+
+    // Nothing on the player's side of the wall is hidden
+    bool nearSideVisible = true;
+    for (int y = 0; y < 11; ++y) {
+        for (int x = 0; x < 7; ++x) nearSideVisible = nearSideVisible && fog.isVisible(x, y);
+    }
+    CHECK(nearSideVisible);
+}
+
+void testRecomputeOnlyOnChange() {
+    CollisionGrid grid;
+    grid.reset(11, 11, TILE_SIZE, TILE_SIZE);
+    FogOfWar fog;
+    CHECK(fog.getRevision() == 0);
+    CHECK(fog.update(grid, tileCenter(5, 5), 0));
+    uint32_t revision = fog.getRevision();
+    CHECK(revision != 0);
+
+    // Moving within the same tile is free
+    CHECK(!fog.update(grid, tileCenter(5, 5) + Vec2{10.0f, -10.0f}, 0));
+    CHECK(fog.getRevision() == revision);
+
+    // Another tile, new tile edits or an invalidate() recompute
+    CHECK(fog.update(grid, tileCenter(6, 5), 0));
+    CHECK(fog.update(grid, tileCenter(6, 5), 3));
+    fog.invalidate();
+    CHECK(fog.update(grid, tileCenter(6, 5), 3));
+    CHECK(fog.getRevision() == revision + 3);
+}
+
+void testOutsideMap() {
+    CollisionGrid grid;
+    grid.reset(5, 5, TILE_SIZE, TILE_SIZE);
+    FogOfWar fog;
+    CHECK(fog.update(grid, {-100.0f, -100.0f}, 0));
+    bool noneVisible = true;
+    for (int y = 0; y < 5; ++y) {
+        for (int x = 0; x < 5; ++x) noneVisible = noneVisible && !fog.isVisible(x, y);
+    }
+    CHECK(noneVisible);
+
+    CollisionGrid empty;
+    CHECK(!fog.update(empty, tileCenter(1, 1), 0));
+}
+
+} // anonymous namespace
+
+int main() {
+    testOpenRoom();
+    testRadius();
+    testShadows();
+    testRecomputeOnlyOnChange();
+    testOutsideMap();
+    return Test::failures;
+}
@@ -0,0 +1,104 @@
+// tests/test_particle_kernels.cpp
+// Every particle kernel this CPU can run must match the scalar one exactly, tail lanes included, and
+// removeDead() must drop exactly the dead particles
+#include "Check.h"
+#include "TuxArena/Particle.h"
+#include "TuxArena/ParticleKernels.h"
+
+#include <cstring>
+#include <vector>
+
+using namespace TuxArena;
+
+namespace {
+
+const char* const KERNELS[] = {"AVX2", "SSE2", "scalar"};
+
+// Sizes around the 4- and 8-wide blocks, so each kernel also runs its scalar remainder
+const size_t SIZES[] = {0, 1, 3, 4, 5, 7, 8, 9, 12, 13, 15, 16, 17, 31, 33, 100, 1027};
+
+ParticlePool makePool(size_t count) {
+    ParticlePool pool(count);
+    uint32_t state = 12345;
+    auto next = [&state](float min, float max) {
+        state = state * 1664525u + 1013904223u; // Fixed LCG, so every kernel sees the same input
+        return min + (max - min) * static_cast<float>(state >> 8) * (1.0f / 16777216.0f);
+    };
+    for (size_t i = 0; i < count; ++i) {
+        ParticleSpawn spawn;
+        spawn.x = next(-500.0f, 500.0f);
+        spawn.y = next(-500.0f, 500.0f);
+        spawn.velocityX = next(-300.0f, 300.0f);
+        spawn.velocityY = next(-300.0f, 300.0f);
+        spawn.lifetime = next(0.01f, 0.2f); // Some die during the test steps
+        spawn.size = 2.0f;
+        spawn.drag = next(0.0f, 80.0f);     // Past 1 / dt the damping clamps to 0
+        spawn.fade = (i % 3 == 0) ? 0.0f : next(0.0f, 1.5f); // Above 1 the alpha clamps to 0
+        spawn.color = {255, 255, 255, 255};
+        spawn.type = ParticleType::Blood;
+        pool.add(spawn);
+    }
+    return pool;
+}
+
+bool sameFloats(const std::vector<float>& a, const std::vector<float>& b, size_t count) {
+    return std::memcmp(a.data(), b.data(), count * sizeof(float)) == 0;
+}
+
+void runSteps(ParticlePool& pool, std::vector<size_t>& firstDead) {
+    const float steps[] = {0.016f, 0.033f, 0.016f, 0.1f};
+    for (float deltaTime : steps) {
+        integrateParticles(pool.getArrays(), pool.getSize(), deltaTime);
+        firstDead.push_back(findDeadParticle(pool.life.data(), 0, pool.getSize()));
+        // Searches starting inside a block, as removeDead() does
+        for (size_t begin = 1; begin < pool.getSize() && begin < 11; ++begin) {
+            firstDead.push_back(findDeadParticle(pool.life.data(), begin, pool.getSize()));
+        }
+
+        // Swap-and-pop: every dead particle is reported once, including ones moved into a dead slot
+        size_t before = pool.getSize();
+        size_t deaths = 0;
+        bool reportedDead = true;
+        pool.removeDead([&](size_t i) {
+            reportedDead = reportedDead && pool.life[i] <= 0.0f;
+            ++deaths;
+        });
+        CHECK(reportedDead);
+        CHECK(pool.getSize() == before - deaths);
+        CHECK(findDeadParticle(pool.life.data(), 0, pool.getSize()) == pool.getSize());
+    }
+}
+
+} // anonymous namespace
+
+int main() {
+    for (size_t count : SIZES) {
+        CHECK(selectParticleKernel("scalar"));
+        ParticlePool expected = makePool(count);
+        std::vector<size_t> expectedDead;
+        runSteps(expected, expectedDead);
+
+        for (const char* kernel : KERNELS) {
+            if (!selectParticleKernel(kernel)) {
+                if (count == 0) std::printf("%s: not available, skipped\n", kernel);
+                continue;
+            }
+            ParticlePool pool = makePool(count);
+            std::vector<size_t> dead;
+            runSteps(pool, dead);
+
+            CHECK(sameFloats(pool.x, expected.x, count));
+            CHECK(sameFloats(pool.y, expected.y, count));
+            CHECK(sameFloats(pool.velocityX, expected.velocityX, count));
+            CHECK(sameFloats(pool.velocityY, expected.velocityY, count));
+            CHECK(sameFloats(pool.life, expected.life, count));
+            CHECK(std::memcmp(pool.alpha.data(), expected.alpha.data(), count) == 0);
+            CHECK(dead == expectedDead);
+            if (Test::failures != 0) {
+                std::fprintf(stderr, "%s differs from scalar with %zu particles\n", kernel, count);
+                return Test::failures;
+            }
+        }
+    }
+    return Test::failures;
+}
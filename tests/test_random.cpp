@@ -0,0 +1,162 @@
+// tests/test_random.cpp
+// nextBelow() must be uniform (no modulo bias) and in range; sequences must be reproducible per
+// seed and stream; a second thread setting the seed must not share the first thread's streams
+#include "Check.h"
+#include "TuxArena/Random.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <thread>
+#include <vector>
+
+using namespace TuxArena;
+
+namespace {
+
+// Pearson's chi-square of the bucket counts against a uniform distribution
+double chiSquare(const std::vector<uint64_t>& counts, double expected) {
+    double sum = 0.0;
+    for (uint64_t count : counts) {
+        double difference = static_cast<double>(count) - expected;
+        sum += difference * difference / expected;
+    }
+    return sum;
+}
+
+// The seed is fixed, so these are not flaky; the limits are the 99.9% quantiles, so a correct
+// generator passes with a wide margin and a biased one (e.g. next() % bound) does not
+void testNextBelowDistribution() {
+    Random random(20240601u, 7);
+
+    // Small bound: 5 degrees of freedom, 99.9% quantile 20.52
+    {
+        const uint32_t bound = 6;
+        const int draws = 600000;
+        std::vector<uint64_t> counts(bound);
+        bool inRange = true;
+        for (int i = 0; i < draws; ++i) {
+            uint32_t value = random.nextBelow(bound);
+            inRange = inRange && value < bound;
+            if (value < bound) ++counts[value];
+        }
+        CHECK(inRange);
+        double chi = chiSquare(counts, static_cast<double>(draws) / bound);
+        if (chi >= 20.52) std::fprintf(stderr, "nextBelow(%u): chi-square %.2f\n", bound, chi);
+        CHECK(chi < 20.52);
+    }
+
+    // Larger bound: 999 degrees of freedom, 99.9% quantile 1143.9
+    {
+        const uint32_t bound = 1000;
+        const int draws = 1000000;
+        std::vector<uint64_t> counts(bound);
+        for (int i = 0; i < draws; ++i) ++counts[random.nextBelow(bound)];
+        double chi = chiSquare(counts, static_cast<double>(draws) / bound);
+        if (chi >= 1143.9) std::fprintf(stderr, "nextBelow(%u): chi-square %.2f\n", bound, chi);
+        CHECK(chi < 1143.9);
+    }
+
+    // Bound of 3 * 2^30: a modulo reduction would put half of the values in the lowest third.
+    // Counted in thirds, 2 degrees of freedom, 99.9% quantile 13.82
+    {
+        const uint32_t bound = 3u << 30;
+        const int draws = 300000;
+        std::vector<uint64_t> counts(3);
+        bool inRange = true;
+        for (int i = 0; i < draws; ++i) {
+            uint32_t value = random.nextBelow(bound);
+            inRange = inRange && value < bound;
+            ++counts[std::min<uint32_t>(value >> 30, 2)];
+        }
+        CHECK(inRange);
+        double chi = chiSquare(counts, static_cast<double>(draws) / 3);
+        if (chi >= 13.82) std::fprintf(stderr, "nextBelow(3 << 30): chi-square %.2f\n", chi);
+        CHECK(chi < 13.82);
+    }
+}
+
+void testEdgeCases() {
+    Random random(1, 0);
+    bool zeroAndOne = true;
+    for (int i = 0; i < 1000; ++i) {
+        zeroAndOne = zeroAndOne && random.nextBelow(0) == 0 && random.nextBelow(1) == 0;
+    }
+    CHECK(zeroAndOne);
+
+    // range(int, int) is inclusive at both ends
+    bool sawMin = false, sawMax = false, inRange = true;
+    for (int i = 0; i < 10000; ++i) {
+        int value = random.range(-3, 3);
+        inRange = inRange && value >= -3 && value <= 3;
+        sawMin = sawMin || value == -3;
+        sawMax = sawMax || value == 3;
+    }
+    CHECK(inRange && sawMin && sawMax);
+
+    bool floatsInRange = true;
+    float values[37];
+    random.fillFloats(values, 37, -2.0f, 5.0f);
+    for (float value : values) floatsInRange = floatsInRange && value >= -2.0f && value < 5.0f;
+    for (int i = 0; i < 10000; ++i) {
+        float value = random.nextFloat();
+        floatsInRange = floatsInRange && value >= 0.0f && value < 1.0f;
+    }
+    CHECK(floatsInRange);
+}
+
+void testReproducible() {
+    Random a(99, 3), b(99, 3), otherStream(99, 4), otherSeed(100, 3);
+    bool same = true, streamDiffers = false, seedDiffers = false;
+    for (int i = 0; i < 100; ++i) {
+        uint32_t value = a.next();
+        same = same && value == b.next();
+        streamDiffers = streamDiffers || value != otherStream.next();
+        seedDiffers = seedDiffers || value != otherSeed.next();
+    }
+    CHECK(same);
+    CHECK(streamDiffers);
+    CHECK(seedDiffers);
+
+    a.reseed(99, 3);
+    b.reseed(99, 3);
+    CHECK(a.next() == b.next());
+}
+
+std::vector<uint32_t> drawGameplay(int count) {
+    std::vector<uint32_t> values(count);
+    for (uint32_t& value : values) value = getRandom(RandomStream::Gameplay).next();
+    return values;
+}
+
+void testSeedOwnership() {
+    setRandomSeed(42);
+    CHECK(getRandomSeed() == 42);
+    std::vector<uint32_t> first = drawGameplay(8);
+    std::vector<uint32_t> effects(8);
+    for (uint32_t& value : effects) value = getRandom(RandomStream::Effects).next();
+    CHECK(first != effects);
+
+    // Another thread sets the same seed: it gets streams of its own, and this thread keeps the
+    // seeded ones (restarted by the new seed)
+    std::vector<uint32_t> other;
+    std::thread worker([&other] {
+        setRandomSeed(42);
+        other = drawGameplay(8);
+    });
+    worker.join();
+    CHECK(other != first);
+    CHECK(drawGameplay(8) == first);
+
+    setRandomSeed(42);
+    CHECK(drawGameplay(8) == first);
+}
+
+} // anonymous namespace
+
+int main() {
+    testNextBelowDistribution();
+    testEdgeCases();
+    testReproducible();
+    testSeedOwnership();
+    return Test::failures;
+}
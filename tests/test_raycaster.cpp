@@ -0,0 +1,167 @@
+// tests/test_raycaster.cpp
+// Ray hits against hand-placed walls, and the super-tile DDA against a plain step-by-step march on
+// random grids (empty 8x8 super-tiles are skipped in one step, so they must not hide any wall)
+#include "Check.h"
+#include "TuxArena/CollisionGrid.h"
+#include "TuxArena/Raycaster.h"
+
+#include <cmath>
+#include <cstdio>
+
+using namespace TuxArena;
+
+namespace {
+
+constexpr unsigned TILE_SIZE = 32;
+
+uint32_t g_state = 88172645u;
+uint32_t nextRandom() {
+    g_state ^= g_state << 13; // xorshift32, so the input is the same on every run
+    g_state ^= g_state >> 17;
+    g_state ^= g_state << 5;
+    return g_state;
+}
+
+float nextFloat(float min, float max) {
+    return min + (max - min) * static_cast<float>(nextRandom() >> 8) * (1.0f / 16777216.0f);
+}
+
+void testKnownWalls() {
+    CollisionGrid grid;
+    grid.reset(32, 32, TILE_SIZE, TILE_SIZE);
+    grid.setSolid(20, 5, true);
+    Raycaster raycaster;
+    raycaster.build(grid);
+    CHECK(raycaster.isBuilt());
+
+    // Straight right into the left face of tile (20, 5)
+    RayHit hit = raycaster.castRay({176.0f, 176.0f}, {1.0f, 0.0f}, 1000.0f);
+    CHECK(hit.hit);
+    CHECK(hit.tileX == 20 && hit.tileY == 5);
+    CHECK(std::fabs(hit.distance - (640.0f - 176.0f)) < 0.01f);
+    CHECK(std::fabs(hit.point.x - 640.0f) < 0.01f);
+    CHECK(hit.normal.x == -1.0f && hit.normal.y == 0.0f);
+
+    // Too short to reach it: a miss reports maxDistance
+    hit = raycaster.castRay({176.0f, 176.0f}, {2.0f, 0.0f}, 100.0f); // Direction need not be unit length
+    CHECK(!hit.hit);
+    CHECK(hit.distance == 100.0f);
+
+    // Down an empty column to the map edge, which counts as a wall
+    hit = raycaster.castRay({176.0f, 176.0f}, {0.0f, 1.0f}, 5000.0f);
+    CHECK(hit.hit);
+    CHECK(hit.tileY == 32);
+    CHECK(std::fabs(hit.distance - (1024.0f - 176.0f)) < 0.01f);
+    CHECK(hit.normal.y == -1.0f);
+
+    // Starting inside a wall hits at once
+    hit = raycaster.castRay({650.0f, 170.0f}, {-1.0f, 0.0f}, 100.0f);
+    CHECK(hit.hit && hit.distance == 0.0f);
+
+    CHECK(!raycaster.hasLineOfSight({176.0f, 176.0f}, {700.0f, 176.0f}));
+    CHECK(raycaster.hasLineOfSight({176.0f, 176.0f}, {600.0f, 176.0f}));
+    CHECK(raycaster.hasLineOfSight({176.0f, 176.0f}, {700.0f, 300.0f}));
+
+    // Edits are seen once the super-tile is recounted
+    grid.setSolid(10, 5, true);
+    raycaster.updateTile(10, 5);
+    hit = raycaster.castRay({176.0f, 176.0f}, {1.0f, 0.0f}, 1000.0f);
+    CHECK(hit.hit && hit.tileX == 10);
+    grid.setSolid(10, 5, false);
+    raycaster.updateTile(10, 5);
+    hit = raycaster.castRay({176.0f, 176.0f}, {1.0f, 0.0f}, 1000.0f);
+    CHECK(hit.hit && hit.tileX == 20);
+}
+
+// First solid tile along the ray, found by small fixed steps; also returns the distance travelled
+bool marchRay(const CollisionGrid& grid, Vec2 origin, Vec2 direction, float maxDistance, int& tileX, int& tileY, float& distance) {
+    const float step = 0.01f;
+    for (distance = 0.0f; distance <= maxDistance; distance += step) {
+        float x = origin.x + direction.x * distance;
+        float y = origin.y + direction.y * distance;
+        if (grid.isSolidAt(x, y)) {
+            tileX = static_cast<int>(std::floor(x / TILE_SIZE));
+            tileY = static_cast<int>(std::floor(y / TILE_SIZE));
+            return true;
+        }
+    }
+    return false;
+}
+
+void testAgainstMarch() {
+    // 37x29 tiles, so the right and bottom super-tiles are partial
+    CollisionGrid grid;
+    grid.reset(37, 29, TILE_SIZE, TILE_SIZE);
+    for (int y = 0; y < 29; ++y) {
+        for (int x = 0; x < 37; ++x) {
+            bool inWallRegion = x < 16 || y < 8; // The rest stays sparse, with empty super-tiles
+            if (nextRandom() % 100 < (inWallRegion ? 12u : 1u)) grid.setSolid(x, y, true);
+        }
+    }
+    Raycaster raycaster;
+    raycaster.build(grid);
+
+    int mismatches = 0;
+    for (int i = 0; i < 400; ++i) {
+        Vec2 origin = {nextFloat(0.0f, 37.0f * TILE_SIZE), nextFloat(0.0f, 29.0f * TILE_SIZE)};
+        float angle = nextFloat(0.0f, 6.2831853f);
+        Vec2 direction = {std::cos(angle), std::sin(angle)};
+        const float maxDistance = 900.0f;
+
+        RayHit hit = raycaster.castRay(origin, direction, maxDistance);
+        int tileX = -1, tileY = -1;
+        float distance = 0.0f;
+        bool marched = marchRay(grid, origin, direction, maxDistance, tileX, tileY, distance);
+
+        // The march overshoots by at most one step; skip rays grazing a tile corner within that
+        bool agrees = hit.hit == marched &&
+                      (!marched || (hit.tileX == tileX && hit.tileY == tileY && std::fabs(hit.distance - distance) < 0.05f));
+        if (!agrees) {
+            float fx = hit.point.x / TILE_SIZE, fy = hit.point.y / TILE_SIZE;
+            bool nearCorner = std::fabs(fx - std::round(fx)) < 0.01f && std::fabs(fy - std::round(fy)) < 0.01f;
+            bool atLimit = std::fabs(distance - maxDistance) < 0.05f || std::fabs(hit.distance - maxDistance) < 0.05f;
+            if (nearCorner || atLimit) continue;
+            if (++mismatches <= 5) {
+                std::fprintf(stderr, "ray %d: DDA hit=%d tile (%d, %d) at %.3f, march hit=%d tile (%d, %d) at %.3f\n", i,
+                             hit.hit, hit.tileX, hit.tileY, hit.distance, marched, tileX, tileY, distance);
+            }
+        }
+
+        // castRays() with a shared origin gives the same result
+        RayHit batched;
+        raycaster.castRays(origin, &direction, 1, maxDistance, &batched);
+        CHECK(batched.hit == hit.hit && batched.tileX == hit.tileX && batched.tileY == hit.tileY &&
+              batched.distance == hit.distance);
+    }
+    CHECK(mismatches == 0);
+}
+
+void testFan() {
+    CollisionGrid grid;
+    grid.reset(16, 16, TILE_SIZE, TILE_SIZE);
+    for (int y = 0; y < 16; ++y) grid.setSolid(12, y, true);
+    Raycaster raycaster;
+    raycaster.build(grid);
+
+    RayHit hits[5];
+    raycaster.castRayFan({64.0f, 256.0f}, 0.0f, 40.0f, 5, 1000.0f, hits);
+    bool allHitWall = true;
+    for (const RayHit& hit : hits) allHitWall = allHitWall && hit.hit && hit.tileX == 12;
+    CHECK(allHitWall);
+    CHECK(std::fabs(hits[2].distance - (384.0f - 64.0f)) < 0.01f); // Middle ray straight ahead
+    CHECK(std::fabs(hits[0].distance - hits[4].distance) < 0.01f); // Symmetric edges
+    CHECK(hits[0].distance > hits[2].distance);
+
+    Raycaster unbuilt;
+    RayHit miss = unbuilt.castRay({0.0f, 0.0f}, {1.0f, 0.0f}, 50.0f);
+    CHECK(!miss.hit && miss.distance == 50.0f);
+}
+
+} // anonymous namespace
+
+int main() {
+    testKnownWalls();
+    testAgainstMarch();
+    testFan();
+    return Test::failures;
+}
@@ -0,0 +1,121 @@
+// tests/test_render_sort.cpp
+// The radix sort must order like std::stable_sort, and the sort key fields must nest as documented
+#include "Check.h"
+#include "TuxArena/RenderSort.h"
+
+#include <algorithm>
+#include <numeric>
+#include <vector>
+
+using namespace TuxArena;
+
+namespace {
+
+uint32_t g_state = 2463534242u;
+uint32_t nextRandom() {
+    g_state ^= g_state << 13; // xorshift32, so the input is the same on every run
+    g_state ^= g_state >> 17;
+    g_state ^= g_state << 5;
+    return g_state;
+}
+
+// Keys built like the renderer's: few layers and blend modes, many depths, repeated textures,
+// so there are plenty of equal keys whose submission order must survive the sort
+std::vector<uint64_t> makeKeys(size_t count) {
+    std::vector<uint64_t> keys(count);
+    for (uint64_t& key : keys) {
+        RenderLayer layer = static_cast<RenderLayer>(nextRandom() % 5);
+        uint32_t depth = nextRandom() % 64;
+        key = makeRenderSortKey(layer, depth, nextRandom() % 3, nextRandom() % 8);
+    }
+    return keys;
+}
+
+void checkAgainstStableSort(std::vector<uint64_t> keys) {
+    std::vector<uint32_t> expectedOrder(keys.size());
+    std::iota(expectedOrder.begin(), expectedOrder.end(), 0u);
+    std::stable_sort(expectedOrder.begin(), expectedOrder.end(),
+                     [&keys](uint32_t a, uint32_t b) { return keys[a] < keys[b]; });
+
+    std::vector<uint64_t> sorted = keys;
+    std::vector<uint32_t> order, keyOrderScratch;
+    std::vector<uint64_t> keyScratch;
+    radixSortByKey(sorted, order, keyScratch, keyOrderScratch);
+
+    CHECK(order == expectedOrder);
+    bool keysMatch = sorted.size() == keys.size();
+    for (size_t i = 0; keysMatch && i < sorted.size(); ++i) {
+        keysMatch = sorted[i] == keys[expectedOrder[i]];
+    }
+    CHECK(keysMatch);
+}
+
+void testRadixSort() {
+    for (size_t count : {0u, 1u, 2u, 3u, 100u, 257u, 5000u}) {
+        checkAgainstStableSort(makeKeys(count));
+    }
+
+    // Full 64-bit keys, so every digit pass runs
+    std::vector<uint64_t> wide(1000);
+    for (uint64_t& key : wide) key = (static_cast<uint64_t>(nextRandom()) << 32) | nextRandom();
+    checkAgainstStableSort(wide);
+
+    // All keys equal: every pass is skipped and the order stays the identity
+    checkAgainstStableSort(std::vector<uint64_t>(300, makeRenderSortKey(RenderLayer::World, 7, 1, 3)));
+
+    // Already sorted and reversed input
+    std::vector<uint64_t> ascending(500);
+    for (size_t i = 0; i < ascending.size(); ++i) ascending[i] = static_cast<uint64_t>(i) << 16;
+    checkAgainstStableSort(ascending);
+    std::reverse(ascending.begin(), ascending.end());
+    checkAgainstStableSort(ascending);
+}
+
+void testSortKeyPacking() {
+    const uint32_t maxDepth = (1u << RENDER_SORT_DEPTH_BITS) - 1;
+    const uint32_t maxTexture = (1u << RENDER_SORT_TEXTURE_BITS) - 1;
+
+    // Each field outranks everything below it
+    CHECK(makeRenderSortKey(RenderLayer::World, 0, 0, 0) > makeRenderSortKey(RenderLayer::MapBackground, maxDepth, 15, maxTexture));
+    CHECK(makeRenderSortKey(RenderLayer::Hud, 0, 0, 0) > makeRenderSortKey(RenderLayer::MapForeground, maxDepth, 15, maxTexture));
+    CHECK(makeRenderSortKey(RenderLayer::World, 1, 0, 0) > makeRenderSortKey(RenderLayer::World, 0, 15, maxTexture));
+    CHECK(makeRenderSortKey(RenderLayer::Effects, 0, 1, 0) > makeRenderSortKey(RenderLayer::Effects, 0, 0, maxTexture));
+    CHECK(makeRenderSortKey(RenderLayer::Effects, 0, 0, 2) > makeRenderSortKey(RenderLayer::Effects, 0, 0, 1));
+
+    // Out of range values are masked and never spill into the field above
+    CHECK(makeRenderSortKey(RenderLayer::World, maxDepth + 1, 0, 0) == makeRenderSortKey(RenderLayer::World, 0, 0, 0));
+    CHECK(makeRenderSortKey(RenderLayer::World, 0, 16, 0) == makeRenderSortKey(RenderLayer::World, 0, 0, 0));
+    CHECK(makeRenderSortKey(RenderLayer::World, 0, 0, maxTexture + 1) == makeRenderSortKey(RenderLayer::World, 0, 0, 0));
+
+    // The low 16 bits stay zero, so the radix sort skips them
+    CHECK((makeRenderSortKey(RenderLayer::Hud, maxDepth, 15, maxTexture) & 0xFFFF) == 0);
+    CHECK(makeRenderSortKey(RenderLayer::Hud, maxDepth, 15, maxTexture) >> 60 == static_cast<uint64_t>(RenderLayer::Hud));
+}
+
+void testDepthFromY() {
+    const uint32_t maxDepth = (1u << RENDER_SORT_DEPTH_BITS) - 1;
+
+    // Quarter-pixel resolution, negative positions first
+    CHECK(renderSortDepthFromY(0.25f) == renderSortDepthFromY(0.0f) + 1);
+    CHECK(renderSortDepthFromY(-0.25f) + 1 == renderSortDepthFromY(0.0f));
+    CHECK(renderSortDepthFromY(-100.0f) < renderSortDepthFromY(0.0f));
+    CHECK(renderSortDepthFromY(0.0f) == 1u << (RENDER_SORT_DEPTH_BITS - 1));
+
+    // Monotonic, and clamped instead of wrapping far outside the range
+    bool monotonic = true;
+    for (float y = -5000.0f; y < 5000.0f; y += 0.37f) {
+        monotonic = monotonic && renderSortDepthFromY(y) <= renderSortDepthFromY(y + 0.37f);
+    }
+    CHECK(monotonic);
+    CHECK(renderSortDepthFromY(1.0e9f) == maxDepth);
+    CHECK(renderSortDepthFromY(-1.0e9f) == 0u);
+}
+
+} // anonymous namespace
+
+int main() {
+    testRadixSort();
+    testSortKeyPacking();
+    testDepthFromY();
+    return Test::failures;
+}
@@ -0,0 +1,255 @@
+// tools/renderbench.cpp
+// Headless rendering benchmark: draws a scripted scene on SDL's software renderer with the dummy
+// video driver and reports per-stage timings, so renderer changes can be measured without a GPU.
+#include <algorithm> // For std::sort, std::max
+#include <cmath>     // For std::sin, std::cos
+#include <cstdlib>   // For setenv
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "SDL2/SDL.h"
+#include "TuxArena/Constants.h"
+#include "TuxArena/Log.h"
+#include "TuxArena/MapManager.h"
+#include "TuxArena/ParticleManager.h"
+#include "TuxArena/Random.h"
+#include "TuxArena/RenderSnapshot.h"
+#include "TuxArena/RenderThread.h"
+#include "TuxArena/Renderer.h"
+
+using namespace TuxArena;
+
+namespace {
+
+struct BenchConfig {
+    std::string mapPath = "maps/arena1.tmx";
+    int frames = 600;
+    int width = 1280;
+    int height = 720;
+    int entities = 200;
+    int particlesPerFrame = 40;
+    bool threaded = false;
+    std::string screenshotPath; // BMP of the last frame, empty = none
+    bool helpShown = false;     // --help: exit successfully without running
+};
+
+// Samples of one stage over the run, in milliseconds
+struct StageTimes {
+    std::string name;
+    std::vector<double> samples;
+
+    void report() const {
+        if (samples.empty()) return;
+        std::vector<double> sorted = samples;
+        std::sort(sorted.begin(), sorted.end());
+        double sum = 0.0;
+        for (double sample : sorted) sum += sample;
+        auto percentile = [&sorted](double p) { return sorted[static_cast<size_t>(p * static_cast<double>(sorted.size() - 1))]; };
+        std::cout << "  " << name << ": mean " << sum / static_cast<double>(sorted.size()) << " ms, p50 " << percentile(0.5)
+                  << " ms, p95 " << percentile(0.95) << " ms, max " << sorted.back() << " ms\n";
+    }
+};
+
+// Sprite moving on a fixed orbit, standing in for a player or bot
+struct ScriptedEntity {
+    TextureHandle texture;
+    float centerX, centerY, orbit, speed, phase;
+};
+
+bool parseArguments(int argc, char* argv[], BenchConfig& config) {
+    std::vector<std::string> args(argv + 1, argv + argc);
+    try {
+        for (size_t i = 0; i < args.size(); ++i) {
+            if (args[i] == "--map" && i + 1 < args.size()) config.mapPath = args[++i];
+            else if (args[i] == "--frames" && i + 1 < args.size()) config.frames = std::stoi(args[++i]);
+            else if (args[i] == "--width" && i + 1 < args.size()) config.width = std::stoi(args[++i]);
+            else if (args[i] == "--height" && i + 1 < args.size()) config.height = std::stoi(args[++i]);
+            else if (args[i] == "--entities" && i + 1 < args.size()) config.entities = std::stoi(args[++i]);
+            else if (args[i] == "--particles" && i + 1 < args.size()) config.particlesPerFrame = std::stoi(args[++i]);
+            else if (args[i] == "--threaded") config.threaded = true;
+            else if (args[i] == "--screenshot" && i + 1 < args.size()) config.screenshotPath = args[++i];
+            else {
+                std::cout << "Usage: " << argv[0] << " [options]\n"
+                          << "  --map <file>       Map to draw (default: " << config.mapPath << ")\n"
+                          << "  --frames <n>       Frames to render (default: " << config.frames << ")\n"
+                          << "  --width <px>       Target width (default: " << config.width << ")\n"
+                          << "  --height <px>      Target height (default: " << config.height << ")\n"
+                          << "  --entities <n>     Scripted sprites (default: " << config.entities << ")\n"
+                          << "  --particles <n>    Blood particles emitted per frame (default: " << config.particlesPerFrame << ")\n"
+                          << "  --threaded         Replay on a RenderThread instead of inline\n"
+                          << "  --screenshot <bmp> Save the last frame\n";
+                if (args[i] == "--help" || args[i] == "-h") {
+                    config.helpShown = true;
+                } else {
+                    std::cerr << "Unknown argument '" << args[i] << "'\n";
+                }
+                return false;
+            }
+        }
+    } catch (const std::exception&) {
+        std::cerr << "Invalid numeric argument\n";
+        return false;
+    }
+    return config.frames > 0 && config.width > 0 && config.height > 0;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    BenchConfig config;
+    if (!parseArguments(argc, argv, config)) return config.helpShown ? 0 : 1;
+
+    // No display needed: dummy video driver, software renderer into an offscreen surface
+    setenv("SDL_VIDEODRIVER", "dummy", 0);
+    if (SDL_Init(SDL_INIT_VIDEO | SDL_INIT_TIMER) < 0) {
+        Log::Error("SDL_Init failed: " + std::string(SDL_GetError()));
+        return 1;
+    }
+
+    int exitCode = 0;
+    {
+        Renderer renderer(nullptr);
+        MapManager mapManager;
+        if (!renderer.initializeHeadless(config.width, config.height) || !mapManager.loadMap(config.mapPath)) {
+            renderer.shutdown();
+            SDL_Quit();
+            return 1;
+        }
+        float worldWidth = static_cast<float>(mapManager.getMapWidthPixels());
+        float worldHeight = static_cast<float>(mapManager.getMapHeightPixels());
+
+        // Scripted scene: every character texture, cycled across orbiting sprites
+        const std::vector<std::string> characterTextures = {
+            "assets/characters/tux.png", "assets/characters/gnu.png", "assets/characters/rust.png",
+            "assets/characters/python.png", "assets/characters/C++.png", "assets/characters/docker.png"
+        };
+        std::vector<TextureHandle> textures;
+        for (const std::string& path : characterTextures) textures.push_back(renderer.acquireTexture(path));
+        std::vector<ScriptedEntity> entities;
+        for (int i = 0; i < config.entities; ++i) {
+            // Deterministic spread over the map
+            float fx = static_cast<float>((i * 7919) % 1000) / 1000.0f;
+            float fy = static_cast<float>((i * 104729) % 1000) / 1000.0f;
+            entities.push_back({textures[static_cast<size_t>(i) % textures.size()], fx * worldWidth, fy * worldHeight,
+                                40.0f + static_cast<float>(i % 5) * 20.0f, 0.5f + static_cast<float>(i % 3) * 0.5f,
+                                static_cast<float>(i)});
+        }
+        std::vector<PointSprite> minimapMarkers;
+        ParticleManager particles;
+        setRandomSeed(1234); // Same particle bursts on every run
+
+        Camera camera;
+        camera.setViewport(config.width, config.height);
+        RenderSnapshot inlineSnapshot;
+        RenderThread renderThread(renderer);
+        if (config.threaded && !renderThread.start()) config.threaded = false;
+        renderThread.setReplayHistoryEnabled(config.threaded); // Every frame's replay stats, read after the run
+
+        StageTimes simulate{"simulate", {}};
+        StageTimes record{"record", {}};
+        StageTimes prepare{"replay: prepare + sort", {}};
+        StageTimes draw{"replay: draw", {}};
+        StageTimes present{"replay: present", {}};
+        StageTimes frame{"frame", {}};
+        size_t drawCalls = 0, triangles = 0, commands = 0;
+        auto addReplayStats = [&](const Renderer::ReplayStats& stats) {
+            prepare.samples.push_back(stats.prepareMs);
+            draw.samples.push_back(stats.drawMs);
+            present.samples.push_back(stats.presentMs);
+            drawCalls += stats.drawCalls;
+            triangles += stats.triangles;
+            commands += stats.commandCount;
+        };
+        const float dt = 1.0f / 60.0f;
+        double msPerCount = 1000.0 / static_cast<double>(SDL_GetPerformanceFrequency());
+
+        Uint64 runStart = SDL_GetPerformanceCounter();
+        for (int frameIndex = 0; frameIndex < config.frames; ++frameIndex) {
+            float time = static_cast<float>(frameIndex) * dt;
+            Uint64 frameStart = SDL_GetPerformanceCounter();
+
+            // Simulation stand-in: camera pans across the map, particles burst around it
+            camera.setPosition({worldWidth * (0.5f + 0.35f * std::sin(time * 0.3f)),
+                                worldHeight * (0.5f + 0.35f * std::cos(time * 0.2f))});
+            camera.clampToBounds(worldWidth, worldHeight);
+            Vec2 focus = camera.getPosition();
+            particles.emitBlood(focus.x + 120.0f * std::cos(time * 2.0f), focus.y + 120.0f * std::sin(time * 2.0f), config.particlesPerFrame);
+            particles.update(dt);
+            Uint64 recordStart = SDL_GetPerformanceCounter();
+
+            // Same layer and pass structure as Game::render
+            RenderSnapshot& snapshot = config.threaded ? renderThread.acquireBackBuffer() : inlineSnapshot;
+            renderer.beginRecording(snapshot);
+            renderer.setCamera(&camera);
+            if (frameIndex == 0) renderer.prebakeMap(mapManager);
+            renderer.renderMap(mapManager, MapLayer::Background);
+            renderer.renderDecals();
+            renderer.setDrawLayer(RenderLayer::World);
+            for (const ScriptedEntity& entity : entities) {
+                float angle = time * entity.speed + entity.phase;
+                SDL_FRect dst = {entity.centerX + entity.orbit * std::cos(angle) - 16.0f,
+                                 entity.centerY + entity.orbit * std::sin(angle) - 16.0f, 32.0f, 32.0f};
+                if (!renderer.isVisible(dst)) continue;
+                renderer.drawTexture(entity.texture, nullptr, &dst, angle * 57.2958f);
+                renderer.drawLine(dst.x + 16.0f, dst.y + 16.0f, dst.x + 16.0f + 24.0f * std::cos(angle),
+                                  dst.y + 16.0f + 24.0f * std::sin(angle), {139, 0, 0, 255});
+            }
+            renderer.setDrawLayer(RenderLayer::Effects);
+            particles.render(renderer);
+            renderer.renderMap(mapManager, MapLayer::Foreground);
+            renderer.setCamera(nullptr);
+            renderer.setDrawLayer(RenderLayer::Hud);
+            renderer.drawText("renderbench frame " + std::to_string(frameIndex), 10, 10, "assets/fonts/nokia.ttf", 16, {255, 255, 255, 255});
+            minimapMarkers.clear();
+            for (const ScriptedEntity& entity : entities) {
+                float angle = time * entity.speed + entity.phase;
+                minimapMarkers.push_back({entity.centerX + entity.orbit * std::cos(angle),
+                                          entity.centerY + entity.orbit * std::sin(angle), 2.0f, {220, 60, 60, 255}});
+            }
+            SDL_FRect minimapRect = {static_cast<float>(config.width) - MINIMAP_SIZE - 10.0f, 10.0f, MINIMAP_SIZE, MINIMAP_SIZE};
+            renderer.renderMinimap(mapManager, minimapRect, minimapMarkers.data(), minimapMarkers.size());
+            renderer.endRecording();
+            Uint64 replayStart = SDL_GetPerformanceCounter();
+
+            if (config.threaded) {
+                renderThread.submit();
+            } else {
+                renderer.replay(snapshot);
+                addReplayStats(renderer.getReplayStats());
+            }
+            Uint64 frameEnd = SDL_GetPerformanceCounter();
+            simulate.samples.push_back(static_cast<double>(recordStart - frameStart) * msPerCount);
+            record.samples.push_back(static_cast<double>(replayStart - recordStart) * msPerCount);
+            frame.samples.push_back(static_cast<double>(frameEnd - frameStart) * msPerCount);
+        }
+        if (config.threaded) {
+            renderThread.stop(); // Draws the last frame
+            for (const Renderer::ReplayStats& stats : renderThread.takeReplayHistory()) addReplayStats(stats);
+        }
+        double totalMs = static_cast<double>(SDL_GetPerformanceCounter() - runStart) * msPerCount;
+
+        std::cout << "renderbench: " << config.frames << " frames of " << config.mapPath << " at " << config.width << "x"
+                  << config.height << " (software, " << (config.threaded ? "render thread" : "inline") << ")\n";
+        for (const StageTimes* stage : {&simulate, &record, &prepare, &draw, &present, &frame}) stage->report();
+        if (!draw.samples.empty()) {
+            double frames = static_cast<double>(draw.samples.size());
+            std::cout << "  per frame: " << static_cast<double>(commands) / frames << " commands, "
+                      << static_cast<double>(drawCalls) / frames << " draw calls, "
+                      << static_cast<double>(triangles) / frames << " triangles\n";
+        }
+        std::cout << "  total: " << totalMs << " ms, " << static_cast<double>(config.frames) * 1000.0 / std::max(totalMs, 1e-6) << " FPS\n";
+
+        if (!config.screenshotPath.empty() && renderer.getHeadlessSurface()) {
+            if (SDL_SaveBMP(renderer.getHeadlessSurface(), config.screenshotPath.c_str()) != 0) {
+                Log::Error("Failed to save screenshot: " + std::string(SDL_GetError()));
+                exitCode = 1;
+            }
+        }
+
+        for (TextureHandle texture : textures) renderer.releaseTexture(texture);
+        renderer.shutdown();
+    }
+    SDL_Quit();
+    return exitCode;
+}